@@ -0,0 +1,153 @@
+#include "Benchmark.h"
+#include "Animation.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <glm/gtc/matrix_transform.hpp>
+
+// Sphère sectors x stacks avec 4 morph targets et une chaîne de 16 articulations
+static DeformableMesh BuildRig(int sectors, int stacks) {
+    DeformableMesh mesh;
+    mesh.Build(MeshGenerator::BuildSphere(1.0f, sectors, stacks));
+
+    for (int t = 0; t < 4; ++t) {
+        std::vector<glm::vec3> deltas(mesh.vertexCount);
+        for (size_t v = 0; v < mesh.vertexCount; ++v) {
+            deltas[v] = mesh.Normal(v) * (0.05f * std::sin(mesh.Position(v).y * (t + 2) * 3.0f));
+        }
+        mesh.AddMorphTarget("target" + std::to_string(t), deltas, deltas);
+    }
+
+    const uint32_t jointCount = 16;
+    Skeleton skeleton;
+    for (uint32_t j = 0; j < jointCount; ++j) {
+        const float y = j == 0 ? -1.0f : 2.0f / (jointCount - 1);
+        skeleton.AddJoint(static_cast<int32_t>(j) - 1, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, y, 0.0f)));
+    }
+    std::vector<uint8_t> joints(mesh.vertexCount * MAX_SKIN_INFLUENCES);
+    std::vector<float> weights(mesh.vertexCount * MAX_SKIN_INFLUENCES);
+    for (size_t v = 0; v < mesh.vertexCount; ++v) {
+        const float position = (mesh.Position(v).y + 1.0f) * 0.5f * (jointCount - 1);
+        const uint32_t joint = std::min(static_cast<uint32_t>(position), jointCount - 2);
+        const float blend = position - joint;
+        for (uint32_t k = 0; k < MAX_SKIN_INFLUENCES; ++k) {
+            joints[v * MAX_SKIN_INFLUENCES + k] = static_cast<uint8_t>(std::min(joint + k, jointCount - 1));
+        }
+        weights[v * MAX_SKIN_INFLUENCES + 0] = 0.8f * (1.0f - blend);
+        weights[v * MAX_SKIN_INFLUENCES + 1] = 0.8f * blend;
+        weights[v * MAX_SKIN_INFLUENCES + 2] = 0.15f;
+        weights[v * MAX_SKIN_INFLUENCES + 3] = 0.05f;
+    }
+    mesh.SetSkin(std::move(skeleton), std::move(joints), std::move(weights));
+    return mesh;
+}
+
+// Référence vertex par vertex en glm : somme des morph targets pondérés, puis
+// skinning linéaire (matrice mélangée des articulations)
+static void ReferenceDeform(const DeformableMesh& mesh, const DeformationPose& pose, std::vector<float>& out) {
+    out.assign(mesh.vertexCount * FLOATS_PER_VERTEX, 0.0f);
+    const bool skinned = mesh.IsSkinned() && pose.skinMatrices.size() >= mesh.skeleton.JointCount();
+    for (size_t v = 0; v < mesh.vertexCount; ++v) {
+        glm::vec3 position = mesh.Position(v);
+        glm::vec3 normal = mesh.Normal(v);
+        for (size_t t = 0; t < mesh.morphTargets.size() && t < pose.morphWeights.size(); ++t) {
+            const MorphTarget& target = mesh.morphTargets[t];
+            position += pose.morphWeights[t] * glm::vec3(target.dx[v], target.dy[v], target.dz[v]);
+            normal += pose.morphWeights[t] * glm::vec3(target.dnx[v], target.dny[v], target.dnz[v]);
+        }
+        if (skinned) {
+            glm::mat4 blend(0.0f);
+            for (uint32_t k = 0; k < MAX_SKIN_INFLUENCES; ++k) {
+                blend += mesh.weights[v * MAX_SKIN_INFLUENCES + k] *
+                         pose.skinMatrices[mesh.joints[v * MAX_SKIN_INFLUENCES + k]];
+            }
+            position = glm::vec3(blend * glm::vec4(position, 1.0f));
+            normal = glm::mat3(blend) * normal;
+        }
+        float* dst = &out[v * FLOATS_PER_VERTEX];
+        const float values[FLOATS_PER_VERTEX] = {position.x, position.y, position.z, normal.x, normal.y, normal.z,
+                                                 mesh.uv[v * 2], mesh.uv[v * 2 + 1]};
+        std::copy(values, values + FLOATS_PER_VERTEX, dst);
+    }
+}
+
+static float MaxError(const std::vector<float>& a, const std::vector<float>& b) {
+    float error = 0.0f;
+    for (size_t i = 0; i < a.size(); ++i) {
+        error = std::max(error, std::abs(a[i] - b[i]));
+    }
+    return error;
+}
+
+// Torsion progressive le long de la chaîne ; poses morph seul, skinning seul, les deux
+static void BuildPoses(const DeformableMesh& mesh, DeformationPose& morphOnly, DeformationPose& skinOnly,
+                       DeformationPose& both) {
+    std::vector<glm::mat4> jointPose = mesh.skeleton.bindLocal;
+    for (size_t j = 1; j < jointPose.size(); ++j) {
+        jointPose[j] = glm::rotate(jointPose[j], glm::radians(4.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+    morphOnly.morphWeights = {0.5f, 0.25f, 0.75f, 0.1f};
+    mesh.skeleton.ComputeSkinMatrices(jointPose, skinOnly.skinMatrices);
+    both = morphOnly;
+    both.skinMatrices = skinOnly.skinMatrices;
+}
+
+// MeshDeformer (série et parallèle) contre la référence, pour des nombres de
+// vertices multiples de 4 ou non, plus petits ou plus grands qu'un paquet
+static void CheckDeformer(ThreadPool& pool) {
+    const float tolerance = 1e-4f;
+    const std::pair<int, int> grids[] = {{7, 3}, {8, 6}, {63, 64}, {100, 50}, {512, 256}};
+    for (const auto& grid : grids) {
+        const DeformableMesh mesh = BuildRig(grid.first, grid.second);
+        DeformationPose morphOnly, skinOnly, both;
+        BuildPoses(mesh, morphOnly, skinOnly, both);
+
+        float serialError = 0.0f, parallelError = 0.0f;
+        std::vector<float> expected, out(mesh.vertexCount * FLOATS_PER_VERTEX);
+        for (const DeformationPose* pose : {&morphOnly, &skinOnly, &both}) {
+            ReferenceDeform(mesh, *pose, expected);
+            MeshDeformer::Deform(mesh, *pose, out.data());
+            serialError = std::max(serialError, MaxError(out, expected));
+            std::fill(out.begin(), out.end(), 0.0f);
+            MeshDeformer::Deform(mesh, *pose, out.data(), &pool);
+            parallelError = std::max(parallelError, MaxError(out, expected));
+        }
+
+        char detail[96];
+        std::snprintf(detail, sizeof(detail), "max error %.2e serial, %.2e parallel (%s)", serialError, parallelError,
+                      mesh.vertexCount % 4 ? "padded" : "multiple of 4");
+        Benchmark::Check("Animation/check/" + std::to_string(mesh.vertexCount) + "_verts",
+                         serialError <= tolerance && parallelError <= tolerance, detail);
+    }
+}
+
+BENCHMARK_SUITE(Animation) {
+    ThreadPool pool;
+    CheckDeformer(pool);
+
+    const DeformableMesh mesh = BuildRig(512, 256);
+    const double vertices = static_cast<double>(mesh.vertexCount);
+    std::vector<float> out(mesh.vertexCount * FLOATS_PER_VERTEX);
+
+    DeformationPose morphOnly, skinOnly, both;
+    BuildPoses(mesh, morphOnly, skinOnly, both);
+
+    const std::string label = std::to_string(mesh.vertexCount / 1000) + "k_verts";
+    const std::pair<const char*, const DeformationPose*> poses[] = {
+        {"morph4", &morphOnly}, {"skin4", &skinOnly}, {"morph4_skin4", &both}};
+    for (const auto& pose : poses) {
+        Benchmark::Run(std::string("Animation/") + pose.first + "_serial/" + label, [&]() {
+            MeshDeformer::Deform(mesh, *pose.second, out.data());
+            DoNotOptimize(out.data());
+        }, 0.0, vertices);
+
+        const BenchmarkResult& parallel = Benchmark::Run(std::string("Animation/") + pose.first + "_parallel/" + label, [&]() {
+            MeshDeformer::Deform(mesh, *pose.second, out.data(), &pool);
+            DoNotOptimize(out.data());
+        }, 0.0, vertices);
+
+        std::printf("%-52s %.1f %% of a 60 Hz frame (%zu threads)\n",
+                    (std::string("Animation/") + pose.first + "_budget/" + label).c_str(),
+                    parallel.medianSeconds * 60.0 * 100.0, pool.ThreadCount() + 1);
+    }
+}
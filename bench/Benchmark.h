@@ -0,0 +1,160 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ============================================
+// BenchmarkResult - Mesure d'un benchmark
+// ============================================
+struct BenchmarkResult {
+    std::string name;
+    int repetitions = 0;
+    double minSeconds = 0.0;
+    double medianSeconds = 0.0;
+    double maxSeconds = 0.0;
+    double bytesPerRun = 0.0;  // Pour le débit en MB/s
+    double itemsPerRun = 0.0;  // Pour le débit en éléments/s
+};
+
+// ============================================
+// Benchmark - Mini-harnais de mesure headless
+// ============================================
+class Benchmark {
+public:
+    using SuiteFunction = void (*)();
+
+    static std::vector<std::pair<std::string, SuiteFunction>>& Suites() {
+        static std::vector<std::pair<std::string, SuiteFunction>> suites;
+        return suites;
+    }
+
+    static std::vector<BenchmarkResult>& Results() {
+        static std::vector<BenchmarkResult> results;
+        return results;
+    }
+
+    // Exécute fn après un tour de chauffe et retient le temps médian
+    template<typename Fn>
+    static const BenchmarkResult& Run(const std::string& name, Fn&& fn,
+                                      double bytesPerRun = 0.0, double itemsPerRun = 0.0,
+                                      int repetitions = 5) {
+        fn();
+
+        std::vector<double> times;
+        times.reserve(repetitions);
+        for (int i = 0; i < repetitions; ++i) {
+            auto start = std::chrono::high_resolution_clock::now();
+            fn();
+            auto stop = std::chrono::high_resolution_clock::now();
+            times.push_back(std::chrono::duration<double>(stop - start).count());
+        }
+        std::sort(times.begin(), times.end());
+
+        BenchmarkResult result;
+        result.name = name;
+        result.repetitions = repetitions;
+        result.minSeconds = times.front();
+        result.medianSeconds = times[times.size() / 2];
+        result.maxSeconds = times.back();
+        result.bytesPerRun = bytesPerRun;
+        result.itemsPerRun = itemsPerRun;
+
+        Print(result);
+        Results().push_back(result);
+        return Results().back();
+    }
+
+    // Vérification d'exactitude d'une suite : un échec fait quitter le programme en erreur
+    static bool Check(const std::string& name, bool passed, const std::string& detail) {
+        std::printf("%-52s %12s  %s\n", name.c_str(), passed ? "ok" : "FAILED", detail.c_str());
+        if (!passed) {
+            ++Failures();
+        }
+        return passed;
+    }
+
+    static int& Failures() {
+        static int failures = 0;
+        return failures;
+    }
+
+    // Résultats au format JSON, pour comparer les commits entre eux
+    static bool WriteJSON(const std::string& path, const std::string& label) {
+        std::FILE* file = std::fopen(path.c_str(), "w");
+        if (!file) {
+            std::fprintf(stderr, "Failed to write benchmark results: %s\n", path.c_str());
+            return false;
+        }
+        std::fprintf(file, "{\n  \"label\": \"%s\",\n  \"compiler\": \"%s\",\n  \"build\": \"%s\",\n  \"benchmarks\": [",
+                     label.c_str(), Compiler(), BuildType());
+        for (size_t i = 0; i < Results().size(); ++i) {
+            const BenchmarkResult& result = Results()[i];
+            std::fprintf(file, "%s\n    {\"name\": \"%s\", \"repetitions\": %d, \"median_ms\": %.6f, \"min_ms\": %.6f, "
+                               "\"max_ms\": %.6f, \"items_per_second\": %.3f, \"mb_per_second\": %.3f}",
+                         i ? "," : "", result.name.c_str(), result.repetitions, result.medianSeconds * 1e3,
+                         result.minSeconds * 1e3, result.maxSeconds * 1e3,
+                         result.itemsPerRun > 0.0 ? result.itemsPerRun / result.medianSeconds : 0.0,
+                         result.bytesPerRun > 0.0 ? result.bytesPerRun / result.medianSeconds / (1024.0 * 1024.0) : 0.0);
+        }
+        std::fprintf(file, "\n  ]\n}\n");
+        return std::fclose(file) == 0;
+    }
+
+    static void Print(const BenchmarkResult& result) {
+        std::printf("%-52s %12.3f ms", result.name.c_str(), result.medianSeconds * 1e3);
+        if (result.bytesPerRun > 0.0) {
+            std::printf(" %10.1f MB/s", result.bytesPerRun / result.medianSeconds / (1024.0 * 1024.0));
+        }
+        if (result.itemsPerRun > 0.0) {
+            std::printf(" %14.0f items/s", result.itemsPerRun / result.medianSeconds);
+        }
+        std::printf("\n");
+    }
+
+private:
+    static const char* Compiler() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc";
+#else
+        return "unknown";
+#endif
+    }
+
+    static const char* BuildType() {
+#ifdef NDEBUG
+        return "release";
+#else
+        return "debug";
+#endif
+    }
+};
+
+struct BenchmarkRegistrar {
+    BenchmarkRegistrar(const char* name, Benchmark::SuiteFunction function) {
+        Benchmark::Suites().emplace_back(name, function);
+    }
+};
+
+// Déclare une suite de benchmarks enregistrée automatiquement
+#define BENCHMARK_SUITE(Name)                                              \
+    static void Name##Suite();                                             \
+    static BenchmarkRegistrar Name##Registrar(#Name, &Name##Suite);        \
+    static void Name##Suite()
+
+// Empêche le compilateur d'éliminer un calcul dont le résultat est inutilisé
+template<typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
@@ -0,0 +1,49 @@
+#include "Benchmark.h"
+#include "ClusteredLighting.h"
+#include <cstdio>
+#include <random>
+#include <glm/gtc/matrix_transform.hpp>
+
+// Lumières réparties dans une salle de 40 x 10 x 40 devant la caméra
+static std::vector<PointLight> GenerateLights(size_t count, unsigned int seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> x(-20.0f, 20.0f), y(0.0f, 10.0f), z(-40.0f, 0.0f);
+    std::uniform_real_distribution<float> radius(1.0f, 4.0f), channel(0.2f, 1.0f);
+
+    std::vector<PointLight> lights;
+    lights.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        lights.emplace_back(glm::vec3(x(random), y(random), z(random)), radius(random),
+                            glm::vec3(channel(random), channel(random), channel(random)));
+    }
+    return lights;
+}
+
+BENCHMARK_SUITE(ClusteredLighting) {
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 5.0f, 5.0f), glm::vec3(0.0f, 5.0f, -10.0f),
+                                       glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    ThreadPool pool;
+
+    for (size_t lightCount : {64, 256, 1024, 4096}) {
+        const std::vector<PointLight> lights = GenerateLights(lightCount, 7);
+        LightClusterer clusterer;
+        clusterer.SetProjection(projection, 0.1f, 100.0f);
+        const std::string label = std::to_string(lightCount) + "_lights";
+
+        Benchmark::Run("ClusteredLighting/build_serial/" + label, [&]() {
+            clusterer.Build(lights, view);
+            DoNotOptimize(clusterer.ReferenceCount());
+        }, 0.0, static_cast<double>(lightCount));
+
+        Benchmark::Run("ClusteredLighting/build_parallel/" + label, [&]() {
+            clusterer.Build(lights, view, &pool);
+            DoNotOptimize(clusterer.ReferenceCount());
+        }, 0.0, static_cast<double>(lightCount));
+
+        std::printf("%-52s %zu clusters  %.2f lights/cluster avg  %u max\n",
+                    ("ClusteredLighting/occupancy/" + label).c_str(), clusterer.ClusterCount(),
+                    static_cast<double>(clusterer.ReferenceCount()) / clusterer.ClusterCount(),
+                    clusterer.MaxLightsPerCluster());
+    }
+}
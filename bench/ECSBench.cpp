@@ -0,0 +1,281 @@
+#include "Benchmark.h"
+#include "Components.h"
+#include "ECS.h"
+#include "Systems.h"
+#include <vector>
+
+// Système minimal : parcours Transform + Velocity, comme les systèmes du moteur
+class IntegrationSystem : public System {
+public:
+    void Update(Coordinator& coordinator, float dt) {
+        for (auto const& entity : m_Entities) {
+            coordinator.GetComponent<Transform>(entity).position += coordinator.ReadComponent<Velocity>(entity).linear * dt;
+        }
+    }
+};
+
+static const size_t ENTITY_COUNTS[] = {1000, MAX_ENTITIES};
+
+static void RegisterComponents(Coordinator& coordinator) {
+    coordinator.RegisterComponent<Transform>();
+    coordinator.RegisterComponent<Velocity>();
+    coordinator.RegisterComponent<RigidBody>();
+    coordinator.RegisterComponent<Tag>();
+}
+
+static std::vector<Entity> CreateMovingEntities(Coordinator& coordinator, size_t count) {
+    std::vector<Entity> entities;
+    entities.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const Entity entity = coordinator.CreateEntity();
+        coordinator.AddComponent(entity, Transform(glm::vec3(static_cast<float>(i), 0.0f, 0.0f)));
+        coordinator.AddComponent(entity, Velocity(glm::vec3(0.0f, 1.0f, 0.0f)));
+        coordinator.AddComponent(entity, RigidBody());
+        entities.push_back(entity);
+    }
+    return entities;
+}
+
+BENCHMARK_SUITE(ECS) {
+    for (size_t count : ENTITY_COUNTS) {
+        const std::string label = std::to_string(count) + "_entities";
+        const double items = static_cast<double>(count);
+
+        Coordinator coordinator;
+        coordinator.Init();
+        RegisterComponents(coordinator);
+        std::vector<Entity> entities(count);
+
+        Benchmark::Run("ECS/create_destroy/" + label, [&]() {
+            for (Entity& entity : entities) {
+                entity = coordinator.CreateEntity();
+            }
+            for (Entity entity : entities) {
+                coordinator.DestroyEntity(entity);
+            }
+        }, 0.0, items);
+
+        for (Entity& entity : entities) {
+            entity = coordinator.CreateEntity();
+        }
+        Benchmark::Run("ECS/add_remove/" + label, [&]() {
+            for (Entity entity : entities) {
+                coordinator.AddComponent(entity, Transform());
+            }
+            for (Entity entity : entities) {
+                coordinator.RemoveComponent<Transform>(entity);
+            }
+        }, 0.0, items);
+
+        for (Entity entity : entities) {
+            coordinator.AddComponent(entity, Transform(glm::vec3(1.0f)));
+        }
+        Benchmark::Run("ECS/get/" + label, [&]() {
+            float sum = 0.0f;
+            for (Entity entity : entities) {
+                sum += coordinator.ReadComponent<Transform>(entity).position.x;
+            }
+            DoNotOptimize(sum);
+        }, 0.0, items);
+    }
+
+    // Itération d'un système sur sa liste d'entités
+    for (size_t count : ENTITY_COUNTS) {
+        Coordinator coordinator;
+        coordinator.Init();
+        RegisterComponents(coordinator);
+        auto system = coordinator.RegisterSystem<IntegrationSystem>();
+        Signature signature;
+        signature.set(coordinator.GetComponentType<Transform>());
+        signature.set(coordinator.GetComponentType<Velocity>());
+        coordinator.SetSystemSignature<IntegrationSystem>(signature);
+        CreateMovingEntities(coordinator, count);
+
+        Benchmark::Run("ECS/system_iteration/" + std::to_string(count) + "_entities",
+                       [&]() { system->Update(coordinator, 1.0f / 60.0f); }, 0.0, static_cast<double>(count));
+    }
+}
+
+BENCHMARK_SUITE(Physics) {
+    for (size_t count : ENTITY_COUNTS) {
+        Coordinator coordinator;
+        coordinator.Init();
+        RegisterComponents(coordinator);
+        auto physics = coordinator.RegisterSystem<PhysicsSystem>();
+        Signature signature;
+        signature.set(coordinator.GetComponentType<Transform>());
+        signature.set(coordinator.GetComponentType<Velocity>());
+        signature.set(coordinator.GetComponentType<RigidBody>());
+        coordinator.SetSystemSignature<PhysicsSystem>(signature);
+        CreateMovingEntities(coordinator, count);
+
+        Benchmark::Run("Physics/update/" + std::to_string(count) + "_entities",
+                       [&]() { physics->Update(coordinator, 1.0 / 60.0); }, 0.0, static_cast<double>(count));
+    }
+}
+
+// Un component présent dans les deux mondes avec la même valeur, ou absent des deux
+template<typename T, typename Equal>
+static bool SameComponent(Coordinator& a, Coordinator& b, Entity entity, Equal&& equal) {
+    const bool present = a.HasComponent<T>(entity);
+    if (present != b.HasComponent<T>(entity)) {
+        return false;
+    }
+    return !present || equal(a.ReadComponent<T>(entity), b.ReadComponent<T>(entity));
+}
+
+// Nombre d'entités dont l'état (vie, Transform, Velocity, Tag, Deformable) diffère entre les deux mondes
+static size_t CountDifferences(Coordinator& a, Coordinator& b) {
+    size_t differences = 0;
+    for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+        if (a.IsAlive(entity) != b.IsAlive(entity)) {
+            ++differences;
+            continue;
+        }
+        if (!a.IsAlive(entity)) {
+            continue;
+        }
+        const bool same =
+            SameComponent<Transform>(a, b, entity, [](const Transform& x, const Transform& y) {
+                return x.position == y.position && x.rotation == y.rotation && x.scale == y.scale;
+            }) &&
+            SameComponent<Velocity>(a, b, entity, [](const Velocity& x, const Velocity& y) {
+                return x.linear == y.linear && x.angular == y.angular;
+            }) &&
+            SameComponent<Tag>(a, b, entity, [](const Tag& x, const Tag& y) { return x.name == y.name; }) &&
+            SameComponent<Deformable>(a, b, entity, [](const Deformable& x, const Deformable& y) {
+                return x.morphWeights == y.morphWeights && x.jointPose == y.jointPose && x.enabled == y.enabled;
+            });
+        differences += same ? 0 : 1;
+    }
+    return differences;
+}
+
+// Composants des mondes du snapshot : ceux du bench ECS, plus Deformable
+// (tableaux de taille variable)
+static void RegisterSnapshotComponents(Coordinator& coordinator) {
+    RegisterComponents(coordinator);
+    coordinator.RegisterComponent<Deformable>();
+}
+
+// Pose différente par entité ; une sur deux sans jointPose (pose de liaison)
+static Deformable MakeDeformable(size_t index) {
+    Deformable deformable;
+    deformable.morphWeights.assign(1 + index % 4, static_cast<float>(index % 7) * 0.125f);
+    if (index % 2 == 0) {
+        const glm::vec3 offset(static_cast<float>(index), 0.0f, 0.0f);
+        deformable.jointPose.assign(1 + index % 3, glm::translate(glm::mat4(1.0f), offset));
+    }
+    deformable.enabled = index % 3 != 0;
+    return deformable;
+}
+
+// Sauvegarde et rechargement du monde entier, puis d'un delta où 1 % des
+// Transform et des Deformable ont changé ; le monde rechargé est comparé à l'original
+BENCHMARK_SUITE(Snapshot) {
+    Coordinator coordinator;
+    coordinator.Init();
+    RegisterSnapshotComponents(coordinator);
+    std::vector<Entity> entities = CreateMovingEntities(coordinator, MAX_ENTITIES);
+    for (size_t i = 0; i < entities.size(); i += 4) {
+        coordinator.AddComponent(entities[i], Tag("Entity " + std::to_string(i)));
+    }
+    for (size_t i = 0; i < entities.size(); i += 8) {
+        coordinator.AddComponent(entities[i], MakeDeformable(i));
+    }
+    const std::string label = std::to_string(entities.size()) + "_entities";
+    const double items = static_cast<double>(entities.size());
+
+    std::vector<uint8_t> base;
+    coordinator.SaveSnapshot(base);
+    const double bytes = static_cast<double>(base.size());
+    Benchmark::Run("Snapshot/save/" + label, [&]() { coordinator.SaveSnapshot(base); }, bytes, items);
+
+    Coordinator loaded;
+    loaded.Init();
+    RegisterSnapshotComponents(loaded);
+    Benchmark::Run("Snapshot/load/" + label, [&]() { DoNotOptimize(loaded.LoadSnapshot(base)); }, bytes, items);
+    const size_t fullDifferences = CountDifferences(coordinator, loaded);
+    Benchmark::Check("Snapshot/check_load/" + label, fullDifferences == 0,
+                     std::to_string(fullDifferences) + " entities differ");
+
+    for (size_t i = 0; i < entities.size(); i += 100) {
+        coordinator.GetComponent<Transform>(entities[i]).position.y += 1.0f;
+    }
+    for (size_t i = 0; i < entities.size(); i += 800) {
+        Deformable& deformable = coordinator.GetComponent<Deformable>(entities[i]);
+        deformable.morphWeights.push_back(1.0f);
+        deformable.jointPose.clear();
+    }
+    std::vector<uint8_t> delta;
+    coordinator.SaveSnapshotDelta(base, delta);
+    Benchmark::Run("Snapshot/save_delta/" + label, [&]() { coordinator.SaveSnapshotDelta(base, delta); },
+                   static_cast<double>(delta.size()), items);
+    Benchmark::Run("Snapshot/load_delta/" + label, [&]() {
+        loaded.LoadSnapshot(base);
+        DoNotOptimize(loaded.LoadSnapshot(delta));
+    }, static_cast<double>(base.size() + delta.size()), items);
+    const size_t deltaDifferences = CountDifferences(coordinator, loaded);
+    Benchmark::Check("Snapshot/check_load_delta/" + label, deltaDifferences == 0,
+                     std::to_string(deltaDifferences) + " entities differ");
+
+    // Un delta ne s'applique qu'au snapshot complet dont il est issu
+    Coordinator other;
+    other.Init();
+    RegisterSnapshotComponents(other);
+    CreateMovingEntities(other, 16);
+    std::vector<uint8_t> otherBase;
+    other.SaveSnapshot(otherBase);
+    const bool wrongBaseLoaded = loaded.LoadSnapshot(otherBase) && loaded.LoadSnapshot(delta);   // Erreur attendue
+    Benchmark::Check("Snapshot/check_wrong_base/" + label, !wrongBaseLoaded, "delta on another base rejected");
+}
+
+// Suivi des changements : retrouver 1 % de Transform modifiés parmi toutes
+// les entités, au lieu de tout reparcourir
+BENCHMARK_SUITE(ChangeTracking) {
+    Coordinator coordinator;
+    coordinator.Init();
+    RegisterComponents(coordinator);
+    std::vector<Entity> entities = CreateMovingEntities(coordinator, MAX_ENTITIES);
+    const std::string label = std::to_string(entities.size()) + "_entities";
+    System observer;
+
+    Benchmark::Run("ChangeTracking/for_each_changed_1pct/" + label, [&]() {
+        for (size_t i = 0; i < entities.size(); i += 100) {
+            coordinator.GetComponent<Transform>(entities[i]).position.y += 1.0f;
+        }
+        float sum = 0.0f;
+        coordinator.ForEachChanged<Transform>(observer.m_LastRunTick, [&](Entity, const Transform& transform) {
+            sum += transform.position.y;
+        });
+        coordinator.EndSystemRun(observer);
+        DoNotOptimize(sum);
+    }, 0.0, static_cast<double>(entities.size()));
+
+    // Exactement les entités modifiées depuis le dernier passage, chacune une fois
+    std::vector<uint8_t> expected(MAX_ENTITIES, 0);
+    for (size_t i = 0; i < entities.size(); i += 100) {
+        coordinator.GetComponent<Transform>(entities[i]).position.y += 1.0f;
+        expected[entities[i]] = 1;
+    }
+    size_t visited = 0, unexpected = 0;
+    coordinator.ForEachChanged<Transform>(observer.m_LastRunTick, [&](Entity entity, const Transform&) {
+        ++visited;
+        unexpected += expected[entity] == 1 ? 0 : 1;
+        expected[entity] = 2;
+    });
+    coordinator.EndSystemRun(observer);
+    const size_t modified = (entities.size() + 99) / 100;
+    Benchmark::Check("ChangeTracking/check_for_each_changed/" + label, visited == modified && unexpected == 0,
+                     std::to_string(visited) + " visited, " + std::to_string(modified) + " modified, " +
+                     std::to_string(unexpected) + " unexpected");
+
+    Benchmark::Run("ChangeTracking/has_changed_all/" + label, [&]() {
+        size_t changed = 0;
+        for (Entity entity : entities) {
+            changed += coordinator.HasChanged<Transform>(entity, observer.m_LastRunTick) ? 1 : 0;
+        }
+        coordinator.EndSystemRun(observer);
+        DoNotOptimize(changed);
+    }, 0.0, static_cast<double>(entities.size()));
+}
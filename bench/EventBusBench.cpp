@@ -0,0 +1,106 @@
+#include "Benchmark.h"
+#include "EventBus.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct BenchCollisionEvent {
+    uint32_t a = 0;
+    uint32_t b = 0;
+    float impulse = 0.0f;
+};
+
+static const size_t EVENT_COUNT = 1000000;
+
+// Somme des impulsions du lot : le parcours d'un consommateur
+static float ReadBatch(EventBus& bus) {
+    float sum = 0.0f;
+    for (const BenchCollisionEvent& event : bus.Read<BenchCollisionEvent>()) {
+        sum += event.impulse;
+    }
+    return sum;
+}
+
+// Le dernier lot publié est complet : un événement d'impulsion 1 par index
+static void CheckBatch(const std::string& name, EventBus& bus) {
+    const size_t count = bus.Read<BenchCollisionEvent>().size();
+    const float sum = ReadBatch(bus);
+    Benchmark::Check(name + "/check", count == EVENT_COUNT && sum == static_cast<float>(EVENT_COUNT),
+        std::to_string(count) + " events, impulse sum " + std::to_string(sum));
+}
+
+// Publie [0, EVENT_COUNT) depuis threadCount threads
+static void PublishParallel(EventBus& bus, unsigned int threadCount) {
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&bus, t, threadCount]() {
+            for (size_t i = t; i < EVENT_COUNT; i += threadCount) {
+                bus.Publish(BenchCollisionEvent{static_cast<uint32_t>(i), t, 1.0f});
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+BENCHMARK_SUITE(EventBus) {
+    EventBus bus;
+    bus.Register<BenchCollisionEvent>(EVENT_COUNT);
+    const double items = static_cast<double>(EVENT_COUNT);
+    const double bytes = items * sizeof(BenchCollisionEvent);
+
+    Benchmark::Run("EventBus/publish_read/1_thread", [&]() {
+        for (size_t i = 0; i < EVENT_COUNT; ++i) {
+            bus.Publish(BenchCollisionEvent{static_cast<uint32_t>(i), 0, 1.0f});
+        }
+        bus.Flip();
+        DoNotOptimize(ReadBatch(bus));
+    }, bytes, items);
+    CheckBatch("EventBus/publish_read/1_thread", bus);
+
+    // Un job émet ses événements par lots de 256 (le dernier lot est partiel)
+    Benchmark::Run("EventBus/publish_batch_read/1_thread", [&]() {
+        BenchCollisionEvent batch[256];
+        EventQueue<BenchCollisionEvent>& queue = bus.Queue<BenchCollisionEvent>();
+        for (size_t i = 0; i < EVENT_COUNT; i += 256) {
+            const size_t count = std::min<size_t>(256, EVENT_COUNT - i);
+            for (size_t j = 0; j < count; ++j) {
+                batch[j] = BenchCollisionEvent{static_cast<uint32_t>(i + j), 0, 1.0f};
+            }
+            queue.PublishBatch(batch, count);
+        }
+        bus.Flip();
+        DoNotOptimize(ReadBatch(bus));
+    }, bytes, items);
+    CheckBatch("EventBus/publish_batch_read/1_thread", bus);
+
+    const unsigned int threadCount = std::max(2u, std::thread::hardware_concurrency());
+    const std::string threadsName = "EventBus/publish_read/" + std::to_string(threadCount) + "_threads";
+    Benchmark::Run(threadsName, [&]() {
+        PublishParallel(bus, threadCount);
+        bus.Flip();
+        DoNotOptimize(ReadBatch(bus));
+    }, bytes, items);
+    CheckBatch(threadsName, bus);
+
+    // Capacité trop petite : le surplus passe par la liste sous verrou et doit
+    // être recollé au lot. Chaque index doit y figurer exactement une fois.
+    EventBus smallBus;
+    smallBus.Register<BenchCollisionEvent>(1024);
+    PublishParallel(smallBus, threadCount);
+    smallBus.Flip();
+    std::vector<uint8_t> seen(EVENT_COUNT, 0);
+    size_t invalid = 0;
+    for (const BenchCollisionEvent& event : smallBus.Read<BenchCollisionEvent>()) {
+        if (event.a >= EVENT_COUNT || seen[event.a]++ != 0) {
+            ++invalid;
+        }
+    }
+    const size_t overflows = smallBus.Queue<BenchCollisionEvent>().OverflowCount();
+    Benchmark::Check("EventBus/overflow/check_indices", invalid == 0 && overflows == 1,
+        std::to_string(invalid) + " duplicated or out of range, " + std::to_string(overflows) + " overflow");
+    CheckBatch("EventBus/overflow", smallBus);
+}
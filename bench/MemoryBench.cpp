@@ -0,0 +1,52 @@
+#include "Benchmark.h"
+#include "Memory.h"
+#include <set>
+#include <vector>
+
+// Listes d'entités des systèmes : std::set avec l'allocateur standard ou un pool
+template<typename Set>
+static void InsertErase(Set& set, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        set.insert(static_cast<uint32_t>((i * 2654435761u) % count));
+    }
+    for (size_t i = 0; i < count; ++i) {
+        set.erase(static_cast<uint32_t>(i));
+    }
+}
+
+BENCHMARK_SUITE(Memory) {
+    const size_t count = 5000;
+    const double items = static_cast<double>(count);
+
+    std::set<uint32_t> heapSet;
+    Benchmark::Run("Memory/set_insert_erase/std_allocator", [&]() { InsertErase(heapSet, count); }, 0.0, items);
+
+    std::set<uint32_t, std::less<uint32_t>, PoolAllocator<uint32_t>> poolSet;
+    Benchmark::Run("Memory/set_insert_erase/pool_allocator", [&]() { InsertErase(poolSet, count); }, 0.0, items);
+
+    // Tableaux temporaires d'une frame : 64 petites listes par "frame", réservées
+    // des deux côtés pour ne mesurer que l'allocation, pas la croissance du vector
+    Benchmark::Run("Memory/transient_vectors/heap", [&]() {
+        for (int list = 0; list < 64; ++list) {
+            std::vector<uint32_t> values;
+            values.reserve(256);
+            for (uint32_t i = 0; i < 256; ++i) {
+                values.push_back(i);
+            }
+            DoNotOptimize(values.data());
+        }
+    }, 0.0, 64.0 * 256.0);
+
+    FrameArena arena;
+    Benchmark::Run("Memory/transient_vectors/frame_arena", [&]() {
+        arena.Reset();
+        for (int list = 0; list < 64; ++list) {
+            FrameVector<uint32_t> values{FrameAllocator<uint32_t>(&arena)};
+            values.reserve(256);
+            for (uint32_t i = 0; i < 256; ++i) {
+                values.push_back(i);
+            }
+            DoNotOptimize(values.data());
+        }
+    }, 0.0, 64.0 * 256.0);
+}
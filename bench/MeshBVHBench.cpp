@@ -0,0 +1,107 @@
+#include "Benchmark.h"
+#include "MeshBVH.h"
+#include <cstdio>
+#include <random>
+
+// Sphère bosselée, comme une surface d'organe numérisée (2 * sectors * stacks triangles)
+static MeshData GenerateScan(int sectors, int stacks) {
+    MeshData mesh = MeshGenerator::BuildSphere(1.0f, sectors, stacks);
+    for (size_t i = 0; i < mesh.vertices.size(); i += FLOATS_PER_VERTEX) {
+        float* p = &mesh.vertices[i];
+        const float scale = 1.0f + 0.05f * std::sin(p[0] * 40.0f) * std::cos(p[1] * 37.0f) + 0.02f * std::sin(p[2] * 90.0f);
+        p[0] *= scale;
+        p[1] *= scale;
+        p[2] *= scale;
+    }
+    return mesh;
+}
+
+// Rayons depuis l'extérieur vers le voisinage du centre
+static std::vector<Ray> GenerateRays(size_t count, unsigned int seed) {
+    std::mt19937 random(seed);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    std::vector<Ray> rays;
+    rays.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec3 origin(normal(random) * 3.0f, normal(random) * 3.0f, normal(random) * 3.0f);
+        const glm::vec3 target(normal(random) * 0.3f, normal(random) * 0.3f, normal(random) * 0.3f);
+        rays.emplace_back(origin, target - origin);
+    }
+    return rays;
+}
+
+// Référence : Möller-Trumbore sur tous les triangles
+static float BruteForce(const MeshData& mesh, const Ray& ray) {
+    float best = FLT_MAX;
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        glm::vec3 v[3];
+        for (int k = 0; k < 3; ++k) {
+            const float* p = &mesh.vertices[static_cast<size_t>(mesh.indices[t + k]) * FLOATS_PER_VERTEX];
+            v[k] = glm::vec3(p[0], p[1], p[2]);
+        }
+        const glm::vec3 edge1 = v[1] - v[0], edge2 = v[2] - v[0];
+        const glm::vec3 p = glm::cross(ray.direction, edge2);
+        const float determinant = glm::dot(edge1, p);
+        if (determinant == 0.0f) {
+            continue;
+        }
+        const float inverse = 1.0f / determinant;
+        const glm::vec3 s = ray.origin - v[0];
+        const float u = glm::dot(s, p) * inverse;
+        if (u < 0.0f || u > 1.0f) {
+            continue;
+        }
+        const glm::vec3 q = glm::cross(s, edge1);
+        const float w = glm::dot(ray.direction, q) * inverse;
+        if (w < 0.0f || u + w > 1.0f) {
+            continue;
+        }
+        const float distance = glm::dot(edge2, q) * inverse;
+        if (distance >= 0.0f && distance < best) {
+            best = distance;
+        }
+    }
+    return best;
+}
+
+BENCHMARK_SUITE(MeshBVH) {
+    const std::vector<Ray> rays = GenerateRays(100000, 3);
+
+    for (int sectors : {250, 1000, 2000}) {
+        const MeshData mesh = GenerateScan(sectors, sectors / 2);
+        const size_t triangleCount = mesh.indices.size() / 3;
+        const std::string label = std::to_string(triangleCount / 1000) + "k_triangles";
+        MeshBVH bvh;
+
+        Benchmark::Run("MeshBVH/build/" + label, [&]() {
+            bvh.Build(mesh);
+            DoNotOptimize(bvh.NodeCount());
+        }, 0.0, static_cast<double>(triangleCount), 3);
+        std::printf("%-52s %zu nodes  %.1f MB\n", ("MeshBVH/memory/" + label).c_str(),
+                    bvh.NodeCount(), bvh.MemoryBytes() / (1024.0 * 1024.0));
+
+        size_t hits = 0;
+        Benchmark::Run("MeshBVH/raycast/" + label, [&]() {
+            hits = 0;
+            for (const Ray& ray : rays) {
+                hits += bvh.Raycast(ray).Hit() ? 1 : 0;
+            }
+        }, 0.0, static_cast<double>(rays.size()));
+        std::printf("%-52s %zu / %zu hits\n", ("MeshBVH/raycast/" + label).c_str(), hits, rays.size());
+
+        Benchmark::Run("MeshBVH/occluded/" + label, [&]() {
+            hits = 0;
+            for (const Ray& ray : rays) {
+                hits += bvh.Occluded(ray) ? 1 : 0;
+            }
+        }, 0.0, static_cast<double>(rays.size()));
+
+        // Parcours exhaustif sur quelques rayons, pour comparaison
+        const size_t bruteRays = 16;
+        Benchmark::Run("MeshBVH/brute_force/" + label, [&]() {
+            for (size_t i = 0; i < bruteRays; ++i) {
+                DoNotOptimize(BruteForce(mesh, rays[i]));
+            }
+        }, 0.0, static_cast<double>(bruteRays), 1);
+    }
+}
@@ -0,0 +1,35 @@
+#include "Benchmark.h"
+#include "MeshLOD.h"
+
+BENCHMARK_SUITE(MeshGeneration) {
+    for (int sectors : {36, 256, 1024}) {
+        const int stacks = sectors / 2;
+        const double triangles = 2.0 * sectors * stacks;
+        const std::string label = std::to_string(static_cast<long>(triangles / 1000)) + "k_tris";
+
+        Benchmark::Run("MeshGeneration/sphere/" + label, [&]() {
+            MeshData mesh = MeshGenerator::BuildSphere(1.0f, sectors, stacks);
+            DoNotOptimize(mesh.vertices.data());
+        }, 0.0, triangles);
+
+        const MeshData sphere = MeshGenerator::BuildSphere(1.0f, sectors, stacks);
+        Benchmark::Run("MeshGeneration/optimize/" + label, [&]() {
+            MeshData mesh = sphere;
+            mesh.Optimize();
+            DoNotOptimize(mesh.indices.data());
+        }, 0.0, triangles, 3);
+
+        Benchmark::Run("MeshGeneration/lod_sphere/" + label, [&]() {
+            LODChain chain = LODGenerator::BuildSphere(1.0f, sectors, stacks);
+            DoNotOptimize(chain.levels.data());
+        }, 0.0, triangles, 3);
+
+        // Simplification (LOD d'un mesh quelconque), plus coûteuse
+        if (sectors <= 256) {
+            Benchmark::Run("MeshGeneration/lod_simplify/" + label, [&]() {
+                LODChain chain = LODGenerator::Build(sphere);
+                DoNotOptimize(chain.levels.data());
+            }, 0.0, triangles, 3);
+        }
+    }
+}
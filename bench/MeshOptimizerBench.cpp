@@ -0,0 +1,54 @@
+#include "Benchmark.h"
+#include "OBJLoader.h"
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+// Mélange les triangles pour simuler un export dans un ordre quelconque
+static void ShuffleTriangles(std::vector<unsigned int>& indices, unsigned int seed) {
+    std::mt19937 random(seed);
+    const size_t triangleCount = indices.size() / 3;
+    for (size_t i = triangleCount - 1; i > 0; --i) {
+        size_t j = random() % (i + 1);
+        for (int k = 0; k < 3; ++k) {
+            std::swap(indices[i * 3 + k], indices[j * 3 + k]);
+        }
+    }
+}
+
+static void ReportCacheEfficiency(const std::string& name, const MeshData& source) {
+    MeshData optimized = source;
+    optimized.Optimize();
+
+    for (unsigned int cacheSize : {16u, 32u}) {
+        VertexCacheStats before = MeshOptimizer::AnalyzeVertexCache(source.indices, source.VertexCount(), cacheSize);
+        VertexCacheStats after = MeshOptimizer::AnalyzeVertexCache(optimized.indices, optimized.VertexCount(), cacheSize);
+        std::printf("%-52s cache %2u  ACMR %.3f -> %.3f  ATVR %.3f -> %.3f\n", name.c_str(), cacheSize,
+                    before.acmr, after.acmr, before.atvr, after.atvr);
+    }
+
+    Benchmark::Run(name + "/optimize", [&]() {
+        MeshData mesh = source;
+        mesh.Optimize();
+        DoNotOptimize(mesh.indices.data());
+    }, 0.0, static_cast<double>(source.indices.size() / 3));
+}
+
+BENCHMARK_SUITE(MeshOptimizer) {
+    for (int sectors : {64, 256, 1024}) {
+        MeshData sphere = MeshGenerator::BuildSphere(1.0f, sectors, sectors / 2);
+        const std::string label = "MeshOptimizer/sphere_" + std::to_string(sphere.indices.size() / 3);
+        ReportCacheEfficiency(label, sphere);
+
+        ShuffleTriangles(sphere.indices, 42);
+        ReportCacheEfficiency(label + "_shuffled", sphere);
+    }
+
+    // Modèle réel s'il est présent
+    if (std::filesystem::exists("models/heart.obj")) {
+        MeshData heart;
+        if (OBJLoader::ParseOBJ("models/heart.obj", heart)) {
+            ReportCacheEfficiency("MeshOptimizer/heart.obj", heart);
+        }
+    }
+}
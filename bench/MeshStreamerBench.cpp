@@ -0,0 +1,110 @@
+#include "Benchmark.h"
+#include "MeshStreamer.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+#include <glm/gtc/matrix_transform.hpp>
+
+// Terrain synthétique de gridSize x gridSize quads sur [-size/2, size/2]
+static MeshData GenerateTerrain(int gridSize, float size) {
+    MeshData mesh;
+    const int side = gridSize + 1;
+    mesh.vertices.reserve(static_cast<size_t>(side) * side * FLOATS_PER_VERTEX);
+    mesh.indices.reserve(static_cast<size_t>(gridSize) * gridSize * 6);
+
+    const float step = size / gridSize;
+    for (int z = 0; z < side; ++z) {
+        for (int x = 0; x < side; ++x) {
+            const float px = -size * 0.5f + x * step;
+            const float pz = -size * 0.5f + z * step;
+            const float height = 2.0f * std::sin(px * 0.05f) * std::cos(pz * 0.05f);
+            const glm::vec3 normal = glm::normalize(glm::vec3(
+                -0.1f * std::cos(px * 0.05f) * std::cos(pz * 0.05f), 1.0f,
+                0.1f * std::sin(px * 0.05f) * std::sin(pz * 0.05f)));
+            const float vertex[FLOATS_PER_VERTEX] = {px, height, pz, normal.x, normal.y, normal.z,
+                                                     static_cast<float>(x) / gridSize,
+                                                     static_cast<float>(z) / gridSize};
+            mesh.vertices.insert(mesh.vertices.end(), vertex, vertex + FLOATS_PER_VERTEX);
+        }
+    }
+    for (int z = 0; z < gridSize; ++z) {
+        for (int x = 0; x < gridSize; ++x) {
+            const unsigned int a = z * side + x, b = a + 1, c = a + side, d = c + 1;
+            mesh.indices.insert(mesh.indices.end(), {a, c, b, b, c, d});
+        }
+    }
+    mesh.ComputeBounds();
+    return mesh;
+}
+
+// Position et frustum (espace objet) de la caméra au pas step d'un survol circulaire
+static void FlightPath(int step, int steps, float radius, glm::vec3& position, Frustum& frustum) {
+    const float angle = 2.0f * glm::pi<float>() * step / steps;
+    position = glm::vec3(radius * std::cos(angle), 10.0f, radius * std::sin(angle));
+    const glm::vec3 forward(-std::sin(angle), -0.2f, std::cos(angle));
+    const glm::mat4 view = glm::lookAt(position, position + forward, glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+    frustum = Frustum::FromMatrix(projection * view);
+}
+
+BENCHMARK_SUITE(MeshStreamer) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const float size = 1000.0f;
+
+    for (int gridSize : {512, 1024}) {
+        const MeshData terrain = GenerateTerrain(gridSize, size);
+        const double triangles = static_cast<double>(terrain.indices.size() / 3);
+        const std::string label = std::to_string(static_cast<long>(triangles / 1000)) + "k_tris";
+        const std::string path = (directory / ("bench_" + label + ".gechunks")).string();
+
+        Benchmark::Run("MeshStreamer/cook/" + label, [&]() {
+            MeshChunker::Cook(terrain, path, VertexFormat::QuantizedOct16);
+        }, 0.0, triangles, 1);
+
+        ThreadPool pool;
+        MeshStreamer streamer(pool, true);
+        if (!streamer.Open(path)) {
+            std::printf("MeshStreamer/%s: failed to open %s\n", label.c_str(), path.c_str());
+            continue;
+        }
+        StreamingSettings& settings = streamer.Settings();
+        settings.loadRadius = 30.0f;
+        settings.viewDistance = 150.0f;
+        settings.memoryBudget = 16 * 1024 * 1024;
+
+        // Survol : résidence moyenne et octets lus, en laissant les lectures aboutir
+        const int steps = 360;
+        uint64_t residentBytes = 0, peakBytes = 0;
+        uint32_t residentChunks = 0;
+        glm::vec3 position;
+        Frustum frustum;
+        for (int step = 0; step < steps; ++step) {
+            FlightPath(step, steps, size * 0.3f, position, frustum);
+            streamer.Update(position, frustum);
+            while (streamer.HasPendingReads()) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                streamer.Update(position, frustum);
+            }
+            residentBytes += streamer.Stats().residentBytes;
+            residentChunks += streamer.Stats().residentChunks;
+            peakBytes = std::max<uint64_t>(peakBytes, streamer.Stats().residentBytes);
+        }
+        const StreamingStats& stats = streamer.Stats();
+        std::printf("%-52s %zu chunks  resident %.1f avg  %.2f MB avg  %.2f MB peak  read %.1f MB  evictions %u\n",
+                    ("MeshStreamer/flight/" + label).c_str(), streamer.ChunkCount(),
+                    static_cast<double>(residentChunks) / steps,
+                    static_cast<double>(residentBytes) / steps / (1024.0 * 1024.0),
+                    static_cast<double>(peakBytes) / (1024.0 * 1024.0),
+                    static_cast<double>(stats.bytesRead) / (1024.0 * 1024.0), stats.evictions);
+
+        // Coût de la décision de résidence seule (aucune nouvelle lecture)
+        Benchmark::Run("MeshStreamer/update/" + label, [&]() {
+            streamer.Update(position, frustum);
+        }, 0.0, static_cast<double>(streamer.ChunkCount()));
+
+        streamer.Close();
+        std::filesystem::remove(path);
+    }
+}
@@ -0,0 +1,78 @@
+#include "Benchmark.h"
+#include "OBJLoader.h"
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+// ============================================
+// Génération d'OBJ synthétiques (grille ondulée)
+// ============================================
+static std::string GenerateOBJ(int gridSize, bool quads) {
+    std::string obj;
+    obj.reserve(static_cast<size_t>(gridSize + 1) * (gridSize + 1) * 120);
+    char line[128];
+
+    for (int y = 0; y <= gridSize; ++y) {
+        for (int x = 0; x <= gridSize; ++x) {
+            float fx = static_cast<float>(x) / gridSize;
+            float fy = static_cast<float>(y) / gridSize;
+            float h = 0.1f * std::sin(fx * 20.0f) * std::cos(fy * 20.0f);
+            obj.append(line, std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", fx, h, fy));
+            obj.append(line, std::snprintf(line, sizeof(line), "vt %.6f %.6f\n", fx, fy));
+            obj.append(line, std::snprintf(line, sizeof(line), "vn %.6f %.6f %.6f\n", 0.0f, 1.0f, 0.0f));
+        }
+    }
+
+    const int stride = gridSize + 1;
+    for (int y = 0; y < gridSize; ++y) {
+        for (int x = 0; x < gridSize; ++x) {
+            int a = y * stride + x + 1;
+            int b = a + 1;
+            int c = a + stride + 1;
+            int d = a + stride;
+            if (quads) {
+                obj.append(line, std::snprintf(line, sizeof(line), "f %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n",
+                                               a, a, a, b, b, b, c, c, c, d, d, d));
+            } else {
+                obj.append(line, std::snprintf(line, sizeof(line), "f %d/%d/%d %d/%d/%d %d/%d/%d\n",
+                                               a, a, a, b, b, b, c, c, c));
+                obj.append(line, std::snprintf(line, sizeof(line), "f %d/%d/%d %d/%d/%d %d/%d/%d\n",
+                                               a, a, a, c, c, c, d, d, d));
+            }
+        }
+    }
+    return obj;
+}
+
+BENCHMARK_SUITE(OBJParser) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+
+    for (int gridSize : {100, 300, 700}) {
+        for (bool quads : {false, true}) {
+            const std::string obj = GenerateOBJ(gridSize, quads);
+            const double triangles = 2.0 * gridSize * gridSize;
+            const std::string label = std::to_string(static_cast<long>(triangles / 1000)) + "k_tris" + (quads ? "_quads" : "");
+
+            Benchmark::Run("OBJParser/memory/" + label, [&]() {
+                MeshData mesh;
+                OBJLoader::ParseOBJ(obj.data(), obj.size(), mesh);
+                DoNotOptimize(mesh.vertices.data());
+            }, static_cast<double>(obj.size()), triangles);
+
+            // Lecture via le fichier projeté (cache disque chaud)
+            const std::filesystem::path path = directory / ("bench_" + label + ".obj");
+            {
+                std::ofstream file(path, std::ios::binary);
+                file.write(obj.data(), static_cast<std::streamsize>(obj.size()));
+            }
+            Benchmark::Run("OBJParser/mmap/" + label, [&]() {
+                MappedFile file(path.string());
+                MeshData mesh;
+                OBJLoader::ParseOBJ(file.Data(), file.Size(), mesh);
+                DoNotOptimize(mesh.vertices.data());
+            }, static_cast<double>(obj.size()), triangles);
+            std::filesystem::remove(path);
+        }
+    }
+}
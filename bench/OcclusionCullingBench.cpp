@@ -0,0 +1,76 @@
+#include "Benchmark.h"
+#include "OcclusionCulling.h"
+#include <cstdio>
+#include <random>
+#include <glm/gtc/matrix_transform.hpp>
+
+// Petites boîtes dispersées devant et derrière les occulteurs
+static std::vector<AABB> GenerateObjects(size_t count, unsigned int seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> x(-12.0f, 12.0f), y(-6.0f, 6.0f), z(-30.0f, 2.0f), size(0.1f, 0.6f);
+    std::vector<AABB> objects;
+    objects.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec3 center(x(random), y(random), z(random));
+        const glm::vec3 extents(size(random));
+        objects.emplace_back(center - extents, center + extents);
+    }
+    return objects;
+}
+
+BENCHMARK_SUITE(OcclusionCulling) {
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 8.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    const glm::mat4 viewProjection = projection * view;
+
+    // 16 organes de ~2000 triangles sur une grille devant la caméra
+    OccluderMesh organ;
+    organ.Build(MeshGenerator::BuildSphere(1.0f, 40, 25));
+    std::vector<glm::mat4> occluders;
+    for (int i = 0; i < 16; ++i) {
+        const glm::vec3 position(-6.0f + 4.0f * (i % 4), -3.0f + 2.0f * (i / 4), 0.0f);
+        occluders.push_back(glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(1.6f)));
+    }
+    const std::vector<AABB> objects = GenerateObjects(10000, 9);
+    ThreadPool pool;
+
+    for (int width : {256, 512}) {
+        OcclusionSettings settings;
+        settings.width = width;
+        settings.height = width / 2;
+        OcclusionCuller culler(settings);
+        const std::string label = std::to_string(settings.width) + "x" + std::to_string(settings.height);
+        const double triangles = static_cast<double>(organ.TriangleCount() * occluders.size());
+
+        auto drawOccluders = [&](ThreadPool* threads) {
+            culler.Begin(viewProjection);
+            for (const glm::mat4& model : occluders) {
+                culler.AddOccluder(organ, model);
+            }
+            culler.Rasterize(threads);
+        };
+        Benchmark::Run("OcclusionCulling/raster_serial/" + label, [&]() { drawOccluders(nullptr); }, 0.0, triangles);
+        Benchmark::Run("OcclusionCulling/raster_parallel/" + label, [&]() { drawOccluders(&pool); }, 0.0, triangles);
+
+        size_t visible = 0;
+        Benchmark::Run("OcclusionCulling/test/" + label, [&]() {
+            visible = 0;
+            for (const AABB& box : objects) {
+                visible += culler.IsVisible(box) ? 1 : 0;
+            }
+        }, 0.0, static_cast<double>(objects.size()));
+
+        // Sans les occulteurs, seuls les objets hors écran seraient éliminés
+        OcclusionCuller empty(settings);
+        empty.Begin(viewProjection);
+        empty.Rasterize();
+        size_t onScreen = 0;
+        for (const AABB& box : objects) {
+            onScreen += empty.IsVisible(box) ? 1 : 0;
+        }
+        const OcclusionStats& stats = culler.GetStats();
+        std::printf("%-52s %zu / %zu on-screen objects culled  %zu / %zu triangles rasterized\n",
+                    ("OcclusionCulling/culled/" + label).c_str(), onScreen - visible, onScreen,
+                    stats.rasterizedTriangles, stats.occluderTriangles);
+    }
+}
@@ -0,0 +1,63 @@
+#include "Benchmark.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
+#include <cstdio>
+
+// Travail minuscule, pour que le coût mesuré soit celui de la zone
+static int Work(int value) {
+    DoNotOptimize(value);
+    return value + 1;
+}
+
+BENCHMARK_SUITE(Profiler) {
+    Profiler& profiler = Profiler::Get();
+    PROFILE_THREAD("Bench");
+    const int zones = 4000;   // Sous la moitié de l'anneau : aucune perte entre deux relevés
+
+    Benchmark::Run("Profiler/no_zone", [&]() {
+        int value = 0;
+        for (int i = 0; i < zones; ++i) {
+            value = Work(value);
+        }
+    }, 0.0, zones);
+
+    Benchmark::Run("Profiler/zone_enabled", [&]() {
+        int value = 0;
+        for (int i = 0; i < zones; ++i) {
+            PROFILE_SCOPE("BenchZone");
+            value = Work(value);
+        }
+        profiler.EndFrame();
+    }, 0.0, zones);
+
+    profiler.SetEnabled(false);
+    Benchmark::Run("Profiler/zone_disabled", [&]() {
+        int value = 0;
+        for (int i = 0; i < zones; ++i) {
+            PROFILE_SCOPE("BenchZone");
+            value = Work(value);
+        }
+    }, 0.0, zones);
+    profiler.SetEnabled(true);
+
+    // Zones imbriquées sur plusieurs threads, puis export
+    ThreadPool pool;
+    profiler.BeginCapture();
+    for (int frame = 0; frame < 10; ++frame) {
+        PROFILE_SCOPE("BenchFrame");
+        pool.ParallelFor(64, [](size_t begin, size_t end) {
+            PROFILE_SCOPE("BenchJob");
+            for (size_t i = begin; i < end; ++i) {
+                PROFILE_SCOPE("BenchItem");
+                DoNotOptimize(Work(static_cast<int>(i)));
+            }
+        }, 4);
+    }
+    profiler.EndFrame();
+    profiler.EndCapture();
+    Benchmark::Run("Profiler/chrome_trace", [&]() {
+        profiler.WriteChromeTrace("bench_profile.json");
+    }, 0.0, 0.0, 1);
+    std::remove("bench_profile.json");
+    profiler.PrintSummary();
+}
@@ -0,0 +1,95 @@
+#include "Benchmark.h"
+#include "SceneBVH.h"
+#include <cstdio>
+#include <random>
+#include <glm/gtc/matrix_transform.hpp>
+
+// Petites boîtes réparties dans un cube dont le volume croît avec le nombre d'objets
+// (densité constante, comme une scène qui s'agrandit)
+static std::vector<AABB> GenerateObjects(size_t count, unsigned int seed, float& worldSize) {
+    worldSize = 10.0f * std::cbrt(static_cast<float>(count));
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> position(-worldSize * 0.5f, worldSize * 0.5f), size(0.2f, 2.0f);
+
+    std::vector<AABB> objects;
+    objects.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec3 center(position(random), position(random), position(random));
+        const glm::vec3 extents(size(random), size(random), size(random));
+        objects.emplace_back(center - extents * 0.5f, center + extents * 0.5f);
+    }
+    return objects;
+}
+
+BENCHMARK_SUITE(SceneBVH) {
+    for (size_t count : {10000, 100000, 1000000}) {
+        float worldSize = 0.0f;
+        std::vector<AABB> objects = GenerateObjects(count, 11, worldSize);
+        const std::string label = std::to_string(count / 1000) + "k_objects";
+        const int repetitions = count >= 1000000 ? 2 : 5;
+
+        SceneBVH bvh;
+        for (uint32_t i = 0; i < objects.size(); ++i) {
+            bvh.Insert(i, objects[i]);
+        }
+        Benchmark::Run("SceneBVH/build/" + label, [&]() {
+            bvh.Build();
+            DoNotOptimize(bvh.NodeCount());
+        }, 0.0, static_cast<double>(count), repetitions);
+
+        // Tous les objets se déplacent un peu : refit seul
+        std::mt19937 random(5);
+        std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+        for (uint32_t i = 0; i < objects.size(); ++i) {
+            const glm::vec3 offset(jitter(random), jitter(random), jitter(random));
+            bvh.Update(i, AABB(objects[i].min + offset, objects[i].max + offset));
+        }
+        Benchmark::Run("SceneBVH/refit/" + label, [&]() {
+            bvh.Refit();
+            DoNotOptimize(bvh.NodeCount());
+        }, 0.0, static_cast<double>(count), repetitions);
+        std::printf("%-52s SAH cost %.1f after build, %.1f after refit\n",
+                    ("SceneBVH/quality/" + label).c_str(), bvh.BuildCost(), bvh.Cost());
+
+        // Frustum d'une caméra au centre de la scène
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+        const Frustum frustum = Frustum::FromMatrix(projection * view);
+        std::vector<uint32_t> visible;
+        Benchmark::Run("SceneBVH/frustum/" + label, [&]() {
+            bvh.QueryFrustum(frustum, visible);
+            DoNotOptimize(visible.data());
+        }, 0.0, 1.0);
+        std::printf("%-52s %zu visible\n", ("SceneBVH/frustum/" + label).c_str(), visible.size());
+
+        // Rayons aléatoires depuis le centre (sélection à la souris)
+        const size_t rayCount = 10000;
+        std::vector<Ray> rays;
+        std::normal_distribution<float> direction(0.0f, 1.0f);
+        for (size_t i = 0; i < rayCount; ++i) {
+            rays.emplace_back(glm::vec3(0.0f), glm::vec3(direction(random), direction(random), direction(random)));
+        }
+        size_t hits = 0;
+        Benchmark::Run("SceneBVH/raycast/" + label, [&]() {
+            hits = 0;
+            for (const Ray& ray : rays) {
+                hits += bvh.Raycast(ray).Hit() ? 1 : 0;
+            }
+        }, 0.0, static_cast<double>(rayCount));
+        std::printf("%-52s %zu / %zu hits\n", ("SceneBVH/raycast/" + label).c_str(), hits, rayCount);
+
+        // Voisinage de 1000 points aléatoires (rayon 5)
+        std::uniform_real_distribution<float> position(-worldSize * 0.5f, worldSize * 0.5f);
+        std::vector<glm::vec3> centers(1000);
+        for (auto& center : centers) {
+            center = glm::vec3(position(random), position(random), position(random));
+        }
+        std::vector<uint32_t> neighbours;
+        Benchmark::Run("SceneBVH/range/" + label, [&]() {
+            for (const glm::vec3& center : centers) {
+                bvh.QuerySphere(center, 5.0f, neighbours);
+                DoNotOptimize(neighbours.data());
+            }
+        }, 0.0, static_cast<double>(centers.size()));
+    }
+}
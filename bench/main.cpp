@@ -0,0 +1,42 @@
+#include "Benchmark.h"
+#include "Log.h"
+#include <cstring>
+#include <iostream>
+
+// ============================================
+// Point d'entrée des benchmarks
+// ============================================
+// Usage : GameEngineBench [--filter <suite>] [--json <fichier>] [--label <texte>]
+// --json écrit tous les résultats (par exemple un fichier par commit) ;
+// --label les identifie dans ce fichier (hash du commit, machine...).
+// Code de retour non nul si une vérification d'exactitude (Benchmark::Check) a échoué.
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string jsonPath;
+    std::string label;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--label") == 0 && i + 1 < argc) {
+            label = argv[++i];
+        }
+    }
+
+    // Les messages du moteur fausseraient les mesures et noieraient les résultats
+    Logger::Get().SetLevel(LOG_LEVEL_WARNING);
+
+    for (auto const& suite : Benchmark::Suites()) {
+        if (!filter.empty() && suite.first.find(filter) == std::string::npos) {
+            continue;
+        }
+        std::cout << "=== " << suite.first << " ===" << std::endl;
+        suite.second();
+    }
+
+    if (!jsonPath.empty() && !Benchmark::WriteJSON(jsonPath, label)) {
+        return 1;
+    }
+    return Benchmark::Failures() > 0 ? 1 : 0;
+}
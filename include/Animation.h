@@ -0,0 +1,621 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "Bounds.h"
+#include "Log.h"
+#include "MeshCache.h"
+#include "Metrics.h"
+#include "OBJLoader.h"
+#include "Profiler.h"
+#include "Renderer.h"
+#include "SIMD.h"
+#include "ShaderVariants.h"
+#include "ThreadPool.h"
+
+// Articulations influençant un vertex au plus
+const uint32_t MAX_SKIN_INFLUENCES = 4;
+
+// Morph targets de poids non nul appliqués au plus par MeshDeformer
+const uint32_t MAX_CPU_MORPH_TARGETS = 64;
+
+// ============================================
+// Skeleton - Hiérarchie d'articulations d'un mesh skinné
+// ============================================
+// Les articulations sont rangées parent avant enfant. Une pose donne la
+// transformation locale (relative au parent) de chaque articulation ; les
+// matrices de skinning font passer un vertex de la pose de liaison à cette
+// pose, en espace objet.
+struct Skeleton {
+    std::vector<int32_t> parents;         // -1 pour une racine
+    std::vector<glm::mat4> bindLocal;     // Pose de liaison, relative au parent
+    std::vector<glm::mat4> inverseBind;   // Inverse de la pose de liaison en espace objet
+
+    size_t JointCount() const { return parents.size(); }
+    bool Empty() const { return parents.empty(); }
+
+    // Indice de la nouvelle articulation ; parent déjà ajouté, ou -1
+    uint32_t AddJoint(int32_t parent, const glm::mat4& local) {
+        const glm::mat4 global = parent >= 0 ? glm::inverse(inverseBind[parent]) * local : local;
+        parents.push_back(parent);
+        bindLocal.push_back(local);
+        inverseBind.push_back(glm::inverse(global));
+        return static_cast<uint32_t>(parents.size() - 1);
+    }
+
+    // skinMatrices[j] = pose globale de j * inverse de sa liaison ; les
+    // articulations absentes de localPose restent en pose de liaison
+    void ComputeSkinMatrices(const std::vector<glm::mat4>& localPose, std::vector<glm::mat4>& skinMatrices) const {
+        skinMatrices.resize(parents.size());
+        for (size_t j = 0; j < parents.size(); ++j) {
+            const glm::mat4& local = j < localPose.size() ? localPose[j] : bindLocal[j];
+            skinMatrices[j] = parents[j] >= 0 ? skinMatrices[parents[j]] * local : local;
+        }
+        for (size_t j = 0; j < parents.size(); ++j) {
+            skinMatrices[j] = skinMatrices[j] * inverseBind[j];
+        }
+    }
+};
+
+// ============================================
+// MorphTarget - Déplacements des vertices vers une forme cible
+// ============================================
+// Un déplacement par vertex, en tableaux séparés comme ceux du mesh ; la
+// forme obtenue est le repos plus la somme des déplacements pondérés.
+struct MorphTarget {
+    std::string name;
+    std::vector<float> dx, dy, dz;      // Positions
+    std::vector<float> dnx, dny, dnz;   // Normales
+};
+
+// ============================================
+// DeformableMesh - Données CPU d'un mesh animé
+// ============================================
+// Niveau 0 au repos en tableaux par composante (SoA, complétés de zéros
+// jusqu'à un multiple de 4 pour les lectures SSE), ses morph targets et son
+// skinning (MAX_SKIN_INFLUENCES articulations par vertex, poids de somme 1).
+// revision change à chaque modification : les copies GPU (DeformedMesh)
+// savent quand se reconstruire.
+struct DeformableMesh {
+    size_t vertexCount = 0;
+    std::vector<float> x, y, z;
+    std::vector<float> nx, ny, nz;
+    std::vector<float> uv;                  // 2 par vertex (0 pour les formats quantifiés)
+    std::vector<uint32_t> indices;
+    AABB bounds;
+
+    std::vector<MorphTarget> morphTargets;
+    Skeleton skeleton;
+    std::vector<uint8_t> joints;            // MAX_SKIN_INFLUENCES par vertex (vide sans skinning)
+    std::vector<float> weights;
+    uint64_t revision = 0;
+
+    bool Empty() const { return vertexCount == 0; }
+    bool IsSkinned() const { return !skeleton.Empty() && !joints.empty(); }
+    size_t PaddedCount() const { return (vertexCount + 3) & ~static_cast<size_t>(3); }
+
+    glm::vec3 Position(size_t v) const { return glm::vec3(x[v], y[v], z[v]); }
+    glm::vec3 Normal(size_t v) const { return glm::vec3(nx[v], ny[v], nz[v]); }
+
+    void Build(const MeshData& mesh) {
+        Reset(mesh.VertexCount());
+        for (size_t v = 0; v < vertexCount; ++v) {
+            const float* src = &mesh.vertices[v * FLOATS_PER_VERTEX];
+            SetVertex(v, glm::vec3(src[0], src[1], src[2]), glm::vec3(src[3], src[4], src[5]));
+            uv[v * 2] = src[6];
+            uv[v * 2 + 1] = src[7];
+        }
+        indices = mesh.indices;
+    }
+
+    // Depuis un niveau d'un mesh cuit : positions et normales décodées (y
+    // compris quantifiées), donc identiques à ce que le GPU dessine
+    void Build(const CookedMesh& cooked, uint32_t level = 0) {
+        if (!cooked.IsOpen() || level >= cooked.Header().lodCount) {
+            Reset(0);
+            return;
+        }
+        const CookedMeshLOD& lod = cooked.LODs()[level];
+        const VertexLayout& layout = cooked.Header().layout;
+        const char* vertexData = cooked.VertexData(lod);
+
+        Reset(lod.vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            const char* vertex = vertexData + v * layout.stride;
+            SetVertex(v, layout.DecodePosition(vertex), layout.DecodeNormal(vertex));
+            if (!layout.IsQuantized()) {
+                std::memcpy(&uv[v * 2], vertex + 6 * sizeof(float), 2 * sizeof(float));
+            }
+        }
+        indices.resize(lod.indexCount);
+        if (cooked.Header().indexSize == 2) {
+            const uint16_t* source = reinterpret_cast<const uint16_t*>(cooked.IndexData(lod));
+            std::copy(source, source + lod.indexCount, indices.begin());
+        } else {
+            const uint32_t* source = reinterpret_cast<const uint32_t*>(cooked.IndexData(lod));
+            std::copy(source, source + lod.indexCount, indices.begin());
+        }
+    }
+
+    // Indice du nouveau target ; normalDeltas vide : normales inchangées
+    size_t AddMorphTarget(const std::string& name, const std::vector<glm::vec3>& positionDeltas,
+                          const std::vector<glm::vec3>& normalDeltas = {}) {
+        MorphTarget target;
+        target.name = name;
+        const size_t padded = PaddedCount();
+        for (std::vector<float>* values : {&target.dx, &target.dy, &target.dz, &target.dnx, &target.dny, &target.dnz}) {
+            values->assign(padded, 0.0f);
+        }
+        for (size_t v = 0; v < std::min(vertexCount, positionDeltas.size()); ++v) {
+            target.dx[v] = positionDeltas[v].x;
+            target.dy[v] = positionDeltas[v].y;
+            target.dz[v] = positionDeltas[v].z;
+        }
+        for (size_t v = 0; v < std::min(vertexCount, normalDeltas.size()); ++v) {
+            target.dnx[v] = normalDeltas[v].x;
+            target.dny[v] = normalDeltas[v].y;
+            target.dnz[v] = normalDeltas[v].z;
+        }
+        morphTargets.push_back(std::move(target));
+        revision = NextRevision();
+        return morphTargets.size() - 1;
+    }
+
+    // -1 si aucun target ne porte ce nom
+    int32_t FindMorphTarget(const std::string& name) const {
+        for (size_t i = 0; i < morphTargets.size(); ++i) {
+            if (morphTargets[i].name == name) {
+                return static_cast<int32_t>(i);
+            }
+        }
+        return -1;
+    }
+
+    // jointIndices et jointWeights : MAX_SKIN_INFLUENCES par vertex ; les
+    // poids sont ramenés à une somme de 1 (tout sur la première articulation
+    // s'ils sont nuls)
+    bool SetSkin(Skeleton jointHierarchy, std::vector<uint8_t> jointIndices, std::vector<float> jointWeights) {
+        const size_t expected = vertexCount * MAX_SKIN_INFLUENCES;
+        if (jointHierarchy.Empty() || jointIndices.size() != expected || jointWeights.size() != expected) {
+            LOG_ERROR("Invalid skin: " << jointIndices.size() << " joints and " << jointWeights.size()
+                      << " weights for " << vertexCount << " vertices");
+            return false;
+        }
+        for (uint8_t joint : jointIndices) {
+            if (joint >= jointHierarchy.JointCount()) {
+                LOG_ERROR("Invalid skin: joint " << static_cast<int>(joint) << " out of "
+                          << jointHierarchy.JointCount());
+                return false;
+            }
+        }
+        for (size_t v = 0; v < vertexCount; ++v) {
+            float* w = &jointWeights[v * MAX_SKIN_INFLUENCES];
+            float sum = 0.0f;
+            for (uint32_t k = 0; k < MAX_SKIN_INFLUENCES; ++k) {
+                w[k] = std::max(w[k], 0.0f);
+                sum += w[k];
+            }
+            for (uint32_t k = 0; k < MAX_SKIN_INFLUENCES; ++k) {
+                w[k] = sum > 0.0f ? w[k] / sum : (k == 0 ? 1.0f : 0.0f);
+            }
+        }
+        skeleton = std::move(jointHierarchy);
+        joints = std::move(jointIndices);
+        weights = std::move(jointWeights);
+        revision = NextRevision();
+        return true;
+    }
+
+private:
+    void Reset(size_t count) {
+        vertexCount = count;
+        const size_t padded = PaddedCount();
+        for (std::vector<float>* values : {&x, &y, &z, &nx, &ny, &nz}) {
+            values->assign(padded, 0.0f);
+        }
+        uv.assign(count * 2, 0.0f);
+        indices.clear();
+        bounds = AABB();
+        morphTargets.clear();
+        skeleton = Skeleton();
+        joints.clear();
+        weights.clear();
+        revision = NextRevision();
+    }
+
+    void SetVertex(size_t v, const glm::vec3& position, const glm::vec3& normal) {
+        x[v] = position.x;
+        y[v] = position.y;
+        z[v] = position.z;
+        nx[v] = normal.x;
+        ny[v] = normal.y;
+        nz[v] = normal.z;
+        bounds.Expand(position);
+    }
+
+    // Unique pour tout le programme (les meshes sont construits sur les threads de travail)
+    static uint64_t NextRevision() {
+        static std::atomic<uint64_t> next{1};
+        return next++;
+    }
+};
+
+// ============================================
+// DeformationPose - Entrées d'une déformation
+// ============================================
+struct DeformationPose {
+    std::vector<float> morphWeights;       // Un poids par morph target (absent : 0)
+    std::vector<glm::mat4> skinMatrices;   // Skeleton::ComputeSkinMatrices ; vide : pas de skinning
+};
+
+// ============================================
+// MeshDeformer - Morph targets et skinning sur le CPU
+// ============================================
+// Écrit les vertices déformés au format Float32 du VBO (x,y,z, nx,ny,nz, u,v).
+// Par paquets de 256 vertices restés dans le cache L1 : morph targets actifs
+// en SSE, 4 vertices à la fois sur les tableaux SoA, puis skinning vertex par
+// vertex (colonnes des matrices mélangées en SSE). Les paquets sont répartis
+// sur le pool s'il est fourni. Les normales ne sont pas renormalisées (le
+// fragment shader le fait). Aucun appel OpenGL : utilisable sans GPU.
+class MeshDeformer {
+public:
+    // out : vertexCount * FLOATS_PER_VERTEX flottants
+    static void Deform(const DeformableMesh& mesh, const DeformationPose& pose, float* out, ThreadPool* pool = nullptr) {
+        PROFILE_SCOPE("MeshDeformer");
+        ActiveMorphs morphs;
+        for (size_t i = 0; i < mesh.morphTargets.size() && i < pose.morphWeights.size(); ++i) {
+            if (std::abs(pose.morphWeights[i]) > MORPH_EPSILON) {
+                morphs.Add({&mesh.morphTargets[i], pose.morphWeights[i]});
+            }
+        }
+        const glm::mat4* skin = mesh.IsSkinned() && pose.skinMatrices.size() >= mesh.skeleton.JointCount()
+                                    ? pose.skinMatrices.data() : nullptr;
+
+        // Groupes de 4 vertices : les paquets commencent toujours sur un multiple de 4
+        const size_t groups = mesh.PaddedCount() / 4;
+        auto deformGroups = [&](size_t begin, size_t end) {
+            for (size_t group = begin; group < end; group += CHUNK_GROUPS) {
+                DeformChunk(mesh, morphs, skin, group * 4, std::min(end, group + CHUNK_GROUPS) * 4, out);
+            }
+        };
+        if (pool) {
+            pool->ParallelFor(groups, deformGroups, MIN_TASK_GROUPS);
+        } else {
+            deformGroups(0, groups);
+        }
+    }
+
+private:
+    struct ActiveMorph {
+        const MorphTarget* target;
+        float weight;
+    };
+    // Sur la pile, sans allocation par appel. Au-delà de MAX_CPU_MORPH_TARGETS
+    // actifs, les plus grands poids sont gardés (comme sur le GPU).
+    struct ActiveMorphs {
+        ActiveMorph items[MAX_CPU_MORPH_TARGETS];
+        size_t count = 0;
+
+        void Add(const ActiveMorph& morph) {
+            if (count < MAX_CPU_MORPH_TARGETS) {
+                items[count++] = morph;
+                return;
+            }
+            ActiveMorph* smallest = std::min_element(items, items + count,
+                [](const ActiveMorph& a, const ActiveMorph& b) { return std::abs(a.weight) < std::abs(b.weight); });
+            if (std::abs(morph.weight) > std::abs(smallest->weight)) {
+                *smallest = morph;
+            }
+        }
+        const ActiveMorph* begin() const { return items; }
+        const ActiveMorph* end() const { return items + count; }
+    };
+
+    static constexpr float MORPH_EPSILON = 1e-4f;
+    static constexpr size_t CHUNK_GROUPS = 64;       // 256 vertices, 6 ko de positions et normales
+    static constexpr size_t MIN_TASK_GROUPS = 1024;  // 4096 vertices au moins par tâche
+
+    static void DeformChunk(const DeformableMesh& mesh, const ActiveMorphs& morphs, const glm::mat4* skin,
+                            size_t first, size_t last, float* out) {
+        alignas(16) float px[CHUNK_GROUPS * 4], py[CHUNK_GROUPS * 4], pz[CHUNK_GROUPS * 4];
+        alignas(16) float qx[CHUNK_GROUPS * 4], qy[CHUNK_GROUPS * 4], qz[CHUNK_GROUPS * 4];
+        const size_t count = last - first;
+        std::memcpy(px, &mesh.x[first], count * sizeof(float));
+        std::memcpy(py, &mesh.y[first], count * sizeof(float));
+        std::memcpy(pz, &mesh.z[first], count * sizeof(float));
+        std::memcpy(qx, &mesh.nx[first], count * sizeof(float));
+        std::memcpy(qy, &mesh.ny[first], count * sizeof(float));
+        std::memcpy(qz, &mesh.nz[first], count * sizeof(float));
+
+        for (const ActiveMorph& morph : morphs) {
+            const MorphTarget& target = *morph.target;
+            AddScaled(px, &target.dx[first], morph.weight, count);
+            AddScaled(py, &target.dy[first], morph.weight, count);
+            AddScaled(pz, &target.dz[first], morph.weight, count);
+            AddScaled(qx, &target.dnx[first], morph.weight, count);
+            AddScaled(qy, &target.dny[first], morph.weight, count);
+            AddScaled(qz, &target.dnz[first], morph.weight, count);
+        }
+
+        const size_t end = std::min(last, mesh.vertexCount);
+        for (size_t v = first; v < end; ++v) {
+            const size_t i = v - first;
+            float* dst = out + v * FLOATS_PER_VERTEX;
+            if (skin) {
+                SkinVertex(skin, &mesh.joints[v * MAX_SKIN_INFLUENCES], &mesh.weights[v * MAX_SKIN_INFLUENCES],
+                           px[i], py[i], pz[i], qx[i], qy[i], qz[i], dst);
+            } else {
+                dst[0] = px[i];
+                dst[1] = py[i];
+                dst[2] = pz[i];
+                dst[3] = qx[i];
+                dst[4] = qy[i];
+                dst[5] = qz[i];
+            }
+            dst[6] = mesh.uv[v * 2];
+            dst[7] = mesh.uv[v * 2 + 1];
+        }
+    }
+
+    // values[i] += weight * deltas[i] ; count multiple de 4, values aligné sur 16 octets
+    static void AddScaled(float* values, const float* deltas, float weight, size_t count) {
+#ifdef GAMEENGINE_SSE
+        const __m128 w = _mm_set1_ps(weight);
+        for (size_t i = 0; i < count; i += 4) {
+            _mm_store_ps(values + i, _mm_add_ps(_mm_load_ps(values + i), _mm_mul_ps(w, _mm_loadu_ps(deltas + i))));
+        }
+#else
+        for (size_t i = 0; i < count; ++i) {
+            values[i] += weight * deltas[i];
+        }
+#endif
+    }
+
+    // Matrice mélangée des articulations du vertex, appliquée à la position et à la normale
+    static void SkinVertex(const glm::mat4* skin, const uint8_t* joints, const float* weights,
+                           float x, float y, float z, float nx, float ny, float nz, float* dst) {
+#ifdef GAMEENGINE_SSE
+        __m128 c0 = _mm_setzero_ps(), c1 = _mm_setzero_ps(), c2 = _mm_setzero_ps(), c3 = _mm_setzero_ps();
+        for (uint32_t k = 0; k < MAX_SKIN_INFLUENCES; ++k) {
+            const __m128 w = _mm_set1_ps(weights[k]);
+            const float* m = &skin[joints[k]][0][0];
+            c0 = _mm_add_ps(c0, _mm_mul_ps(w, _mm_loadu_ps(m)));
+            c1 = _mm_add_ps(c1, _mm_mul_ps(w, _mm_loadu_ps(m + 4)));
+            c2 = _mm_add_ps(c2, _mm_mul_ps(w, _mm_loadu_ps(m + 8)));
+            c3 = _mm_add_ps(c3, _mm_mul_ps(w, _mm_loadu_ps(m + 12)));
+        }
+        const __m128 normal = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(nx)), _mm_mul_ps(c1, _mm_set1_ps(ny))),
+                                         _mm_mul_ps(c2, _mm_set1_ps(nz)));
+        const __m128 position = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(x)), _mm_mul_ps(c1, _mm_set1_ps(y))),
+                                           _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(z)), c3));
+        // 4 flottants écrits à chaque fois : le 4e est recouvert par l'écriture suivante (normale, puis UV)
+        _mm_storeu_ps(dst, position);
+        _mm_storeu_ps(dst + 3, normal);
+#else
+        glm::mat4 m(0.0f);
+        for (uint32_t k = 0; k < MAX_SKIN_INFLUENCES; ++k) {
+            m += weights[k] * skin[joints[k]];
+        }
+        const glm::vec4 position = m * glm::vec4(x, y, z, 1.0f);
+        const glm::vec3 normal = glm::mat3(m) * glm::vec3(nx, ny, nz);
+        dst[0] = position.x;
+        dst[1] = position.y;
+        dst[2] = position.z;
+        dst[3] = normal.x;
+        dst[4] = normal.y;
+        dst[5] = normal.z;
+#endif
+    }
+};
+
+enum class DeformationMode {
+    CPU,    // MeshDeformer, vertices déformés envoyés à chaque frame
+    GPU     // Données au repos envoyées une fois, déformation dans le vertex shader
+};
+
+// ============================================
+// DeformedMesh - Mesh animé prêt à dessiner
+// ============================================
+// Chemin CPU : MeshDeformer écrit les vertices déformés, envoyés à chaque
+// Update (buffer réalloué : le pilote peut garder l'ancien en vol).
+// Chemin GPU : vertices au repos, articulations et poids envoyés une fois,
+// déplacements des morph targets dans un texture buffer (2 texels RGBA32F
+// par vertex et par target) ; Update ne fait que retenir la pose, que Bind
+// passe à la variante SKINNING / MORPH_TARGETS du shader. Un squelette de
+// plus de MAX_SKIN_JOINTS articulations reste sur le CPU.
+// Thread principal (contexte OpenGL).
+class DeformedMesh {
+public:
+    // (Re)crée les buffers pour source
+    void Setup(const DeformableMesh& source, DeformationMode mode) {
+        Cleanup();
+        m_Mode = mode == DeformationMode::GPU && source.skeleton.JointCount() <= MAX_SKIN_JOINTS
+                     ? DeformationMode::GPU : DeformationMode::CPU;
+        m_Revision = source.revision;
+        m_VertexCount = source.vertexCount;
+        if (source.Empty()) {
+            return;
+        }
+
+        // Pose de repos : point de départ des deux chemins
+        m_Vertices.resize(m_VertexCount * FLOATS_PER_VERTEX);
+        MeshDeformer::Deform(source, DeformationPose(), m_Vertices.data());
+        const size_t vertexBytes = m_Vertices.size() * sizeof(float);
+        if (m_VertexCount <= 0x10000) {
+            std::vector<uint16_t> shortIndices(source.indices.begin(), source.indices.end());
+            m_Mesh.Upload(m_Vertices.data(), vertexBytes, shortIndices.data(),
+                          static_cast<unsigned int>(shortIndices.size()), GL_UNSIGNED_SHORT, VertexLayout::Float32());
+        } else {
+            m_Mesh.Upload(m_Vertices.data(), vertexBytes, source.indices.data(),
+                          static_cast<unsigned int>(source.indices.size()), GL_UNSIGNED_INT, VertexLayout::Float32());
+        }
+        m_Mesh.bounds = source.bounds;
+
+        if (m_Mode == DeformationMode::GPU) {
+            if (source.IsSkinned()) {
+                SetupSkin(source);
+            }
+            if (!source.morphTargets.empty()) {
+                SetupMorphTargets(source);
+            }
+            std::vector<float>().swap(m_Vertices);
+        }
+    }
+
+    // Applique la pose : déformation et envoi (CPU), ou retenue pour Bind (GPU)
+    void Update(const DeformableMesh& source, const DeformationPose& pose, ThreadPool* pool = nullptr) {
+        if (m_Mesh.VAO == 0) {
+            return;
+        }
+        if (m_Mode == DeformationMode::CPU) {
+            MeshDeformer::Deform(source, pose, m_Vertices.data(), pool);
+            const size_t bytes = m_Vertices.size() * sizeof(float);
+            glBindBuffer(GL_ARRAY_BUFFER, m_Mesh.VBO);
+            glBufferData(GL_ARRAY_BUFFER, bytes, m_Vertices.data(), GL_STREAM_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            Metrics::Get().Add(METRIC_UPLOAD_BYTES, bytes);
+            return;
+        }
+
+        if (m_SkinBuffer != 0) {
+            if (pose.skinMatrices.size() >= source.skeleton.JointCount()) {
+                m_SkinMatrices.assign(pose.skinMatrices.begin(), pose.skinMatrices.begin() + source.skeleton.JointCount());
+            } else {
+                m_SkinMatrices.assign(source.skeleton.JointCount(), glm::mat4(1.0f));
+            }
+        }
+
+        // Les MAX_GPU_MORPH_TARGETS targets de plus grand poids
+        std::vector<std::pair<float, int>> active;
+        for (size_t i = 0; i < source.morphTargets.size() && i < pose.morphWeights.size(); ++i) {
+            if (pose.morphWeights[i] != 0.0f) {
+                active.emplace_back(pose.morphWeights[i], static_cast<int>(i));
+            }
+        }
+        const size_t kept = std::min<size_t>(active.size(), MAX_GPU_MORPH_TARGETS);
+        std::partial_sort(active.begin(), active.begin() + kept, active.end(),
+                          [](const std::pair<float, int>& a, const std::pair<float, int>& b) {
+                              return std::abs(a.first) > std::abs(b.first);
+                          });
+        m_MorphCount = static_cast<int>(kept);
+        for (size_t i = 0; i < kept; ++i) {
+            m_MorphWeights[i] = active[i].first;
+            m_MorphTargets[i] = active[i].second;
+        }
+    }
+
+    // Fonctionnalités à ajouter à la variante du shader (ShaderFeature)
+    uint32_t ShaderFeatures() const {
+        uint32_t features = 0;
+        if (m_SkinBuffer != 0) {
+            features |= SHADER_SKINNING;
+        }
+        if (m_MorphTexture != 0) {
+            features |= SHADER_MORPH_TARGETS;
+        }
+        return features;
+    }
+
+    // Pose du chemin GPU : uniforms et texture buffer (unité unit), après Use
+    void Bind(Shader& shader, int unit = 3) const {
+        if (m_SkinBuffer != 0 && !m_SkinMatrices.empty()) {
+            glUniformMatrix4fv(glGetUniformLocation(shader.ID, "skinMatrices"),
+                               static_cast<GLsizei>(m_SkinMatrices.size()), GL_FALSE, &m_SkinMatrices[0][0][0]);
+        }
+        if (m_MorphTexture != 0) {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            glBindTexture(GL_TEXTURE_BUFFER, m_MorphTexture);
+            glActiveTexture(GL_TEXTURE0);
+            shader.SetInt("morphDeltas", unit);
+            shader.SetInt("morphVertexCount", static_cast<int>(m_VertexCount));
+            shader.SetInt("morphCount", m_MorphCount);
+            glUniform1iv(glGetUniformLocation(shader.ID, "morphTargets"), m_MorphCount, m_MorphTargets);
+            glUniform1fv(glGetUniformLocation(shader.ID, "morphWeights"), m_MorphCount, m_MorphWeights);
+        }
+    }
+
+    void Draw() const { m_Mesh.Draw(); }
+
+    bool IsReady() const { return m_Mesh.VAO != 0; }
+    DeformationMode Mode() const { return m_Mode; }
+    uint64_t Revision() const { return m_Revision; }       // DeformableMesh::revision de la source
+    const MeshData& GetMesh() const { return m_Mesh; }
+
+    void Cleanup() {
+        m_Mesh.Cleanup();
+        if (m_SkinBuffer != 0) glDeleteBuffers(1, &m_SkinBuffer);
+        if (m_MorphBuffer != 0) glDeleteBuffers(1, &m_MorphBuffer);
+        if (m_MorphTexture != 0) glDeleteTextures(1, &m_MorphTexture);
+        m_SkinBuffer = m_MorphBuffer = m_MorphTexture = 0;
+        m_Revision = 0;
+        m_MorphCount = 0;
+    }
+
+private:
+    // Articulations (4 x uint8, location 10) puis poids (4 x float, location 11), dans le VAO du mesh
+    void SetupSkin(const DeformableMesh& source) {
+        const size_t jointBytes = source.joints.size();
+        const size_t weightBytes = source.weights.size() * sizeof(float);
+        glGenBuffers(1, &m_SkinBuffer);
+        glBindVertexArray(m_Mesh.VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, m_SkinBuffer);
+        glBufferData(GL_ARRAY_BUFFER, jointBytes + weightBytes, nullptr, GL_STATIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, jointBytes, source.joints.data());
+        glBufferSubData(GL_ARRAY_BUFFER, jointBytes, weightBytes, source.weights.data());
+        glEnableVertexAttribArray(10);
+        glVertexAttribIPointer(10, MAX_SKIN_INFLUENCES, GL_UNSIGNED_BYTE, 0, nullptr);
+        glEnableVertexAttribArray(11);
+        glVertexAttribPointer(11, MAX_SKIN_INFLUENCES, GL_FLOAT, GL_FALSE, 0,
+                              reinterpret_cast<const void*>(static_cast<uintptr_t>(jointBytes)));
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        Metrics::Get().Add(METRIC_UPLOAD_BYTES, jointBytes + weightBytes);
+        m_SkinMatrices.assign(source.skeleton.JointCount(), glm::mat4(1.0f));
+    }
+
+    void SetupMorphTargets(const DeformableMesh& source) {
+        std::vector<float> deltas(source.morphTargets.size() * m_VertexCount * 8, 0.0f);
+        for (size_t t = 0; t < source.morphTargets.size(); ++t) {
+            const MorphTarget& target = source.morphTargets[t];
+            for (size_t v = 0; v < m_VertexCount; ++v) {
+                float* texels = &deltas[(t * m_VertexCount + v) * 8];
+                texels[0] = target.dx[v];
+                texels[1] = target.dy[v];
+                texels[2] = target.dz[v];
+                texels[4] = target.dnx[v];
+                texels[5] = target.dny[v];
+                texels[6] = target.dnz[v];
+            }
+        }
+        const size_t bytes = deltas.size() * sizeof(float);
+        glGenBuffers(1, &m_MorphBuffer);
+        glBindBuffer(GL_TEXTURE_BUFFER, m_MorphBuffer);
+        glBufferData(GL_TEXTURE_BUFFER, bytes, deltas.data(), GL_STATIC_DRAW);
+        glGenTextures(1, &m_MorphTexture);
+        glBindTexture(GL_TEXTURE_BUFFER, m_MorphTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_MorphBuffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        Metrics::Get().Add(METRIC_UPLOAD_BYTES, bytes);
+    }
+
+    MeshData m_Mesh;
+    DeformationMode m_Mode = DeformationMode::CPU;
+    uint64_t m_Revision = 0;
+    size_t m_VertexCount = 0;
+    std::vector<float> m_Vertices;             // Chemin CPU : vertices déformés de la frame
+
+    unsigned int m_SkinBuffer = 0;
+    unsigned int m_MorphBuffer = 0;
+    unsigned int m_MorphTexture = 0;
+    std::vector<glm::mat4> m_SkinMatrices;
+    int m_MorphCount = 0;
+    int m_MorphTargets[MAX_GPU_MORPH_TARGETS] = {};
+    float m_MorphWeights[MAX_GPU_MORPH_TARGETS] = {};
+};
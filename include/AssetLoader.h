@@ -0,0 +1,206 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <glad/glad.h>
+#include "Animation.h"
+#include "Log.h"
+#include "MeshBVH.h"
+#include "MeshCache.h"
+#include "MeshLOD.h"
+#include "OcclusionCulling.h"
+#include "ThreadPool.h"
+
+// Budget d'envoi au GPU par frame par défaut (octets)
+const size_t DEFAULT_UPLOAD_BUDGET = 4 * 1024 * 1024;
+
+// Données CPU à préparer en plus du mesh GPU, sur le thread de travail
+enum MeshLoadFlags : uint32_t {
+    MESH_LOAD_BVH      = 1u << 0,   // MeshBVH du niveau 0 (lancers de rayon précis)
+    MESH_LOAD_OCCLUDER = 1u << 1,   // OccluderMesh du niveau 0 (un LOD simplifié peut déborder)
+    MESH_LOAD_DEFORMABLE = 1u << 2  // DeformableMesh du niveau 0 (morph targets, skinning)
+};
+
+enum class AssetState {
+    Loading,    // Lecture / cuisson sur un thread de travail
+    Uploading,  // En cours d'envoi au GPU (thread principal)
+    Ready,
+    Failed
+};
+
+// ============================================
+// MeshAsset - Mesh chargé en arrière-plan
+// ============================================
+// lods n'est utilisable qu'une fois IsReady() vrai, et uniquement depuis le
+// thread principal (celui du contexte OpenGL).
+struct MeshAsset {
+    std::string path;
+    VertexFormat format = VertexFormat::Float32;
+    std::atomic<AssetState> state{AssetState::Loading};
+    std::atomic<bool> cancelled{false};   // Plus personne n'en veut : abandonner le chargement
+    LODChain lods;
+    MeshBVH bvh;                          // Triangles du niveau 0 (vide sans MESH_LOAD_BVH)
+    OccluderMesh occluder;                // Niveau 0 (vide sans MESH_LOAD_OCCLUDER)
+    DeformableMesh deformable;            // Niveau 0 au repos (vide sans MESH_LOAD_DEFORMABLE)
+
+    bool IsReady() const { return state.load(std::memory_order_acquire) == AssetState::Ready; }
+    bool HasFailed() const { return state.load(std::memory_order_acquire) == AssetState::Failed; }
+};
+
+using MeshHandle = std::shared_ptr<MeshAsset>;
+
+// ============================================
+// AssetLoader - Chargement asynchrone des meshes
+// ============================================
+// La lecture, l'analyse et la cuisson se font sur le ThreadPool ; l'envoi au
+// GPU est mis en file et fait par ProcessUploads sur le thread principal,
+// par morceaux, sans dépasser un budget d'octets par frame.
+class AssetLoader {
+public:
+    explicit AssetLoader(size_t workerCount = 0) : m_Pool(workerCount) {}
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Retourne immédiatement ; le handle devient prêt après quelques frames.
+    // flags (MeshLoadFlags) : données CPU à préparer aussi sur le thread de travail
+    MeshHandle LoadMeshAsync(const std::string& path, VertexFormat format = VertexFormat::Float32,
+                             const std::string& cacheDir = "cache", uint32_t flags = 0) {
+        MeshHandle asset = std::make_shared<MeshAsset>();
+        asset->path = path;
+        asset->format = format;
+        m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+        m_Pool.Submit([this, asset, cacheDir, flags] {
+            PROFILE_SCOPE("LoadMesh");
+            if (asset->cancelled.load(std::memory_order_relaxed)) {
+                asset->state.store(AssetState::Failed, std::memory_order_release);
+                m_Pending.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+
+            auto job = std::make_unique<UploadJob>();
+            job->asset = asset;
+            if (!MeshCache::Prepare(asset->path, job->cooked, asset->format, cacheDir)) {
+                asset->state.store(AssetState::Failed, std::memory_order_release);
+                m_Pending.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            if (flags & MESH_LOAD_BVH) {
+                asset->bvh.Build(job->cooked);
+            }
+            if (flags & MESH_LOAD_OCCLUDER) {
+                asset->occluder.Build(job->cooked);
+            }
+            if (flags & MESH_LOAD_DEFORMABLE) {
+                asset->deformable.Build(job->cooked);
+            }
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Prepared.push_back(std::move(job));
+        });
+        return asset;
+    }
+
+    // À appeler une fois par frame depuis le thread principal.
+    // byteBudget = 0 : tout envoyer. Retourne le nombre d'octets envoyés.
+    size_t ProcessUploads(size_t byteBudget = DEFAULT_UPLOAD_BUDGET) {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            while (!m_Prepared.empty()) {
+                m_Uploading.push_back(std::move(m_Prepared.front()));
+                m_Prepared.pop_front();
+            }
+        }
+
+        size_t uploaded = 0;
+        while (!m_Uploading.empty() && (byteBudget == 0 || uploaded < byteBudget)) {
+            UploadJob& job = *m_Uploading.front();
+            const CookedMesh& cooked = job.cooked;
+            if (job.asset->cancelled.load(std::memory_order_relaxed)) {
+                job.asset->lods.Cleanup();
+                job.asset->state.store(AssetState::Failed, std::memory_order_release);
+                m_Uploading.pop_front();
+                m_Pending.fetch_sub(1, std::memory_order_relaxed);
+                continue;
+            }
+            if (!job.started) {
+                cooked.DescribeLevels(job.asset->lods);
+                job.asset->state.store(AssetState::Uploading, std::memory_order_release);
+                job.started = true;
+            }
+
+            const CookedMeshLOD& lod = cooked.LODs()[job.level];
+            MeshData& mesh = job.asset->lods.levels[job.level].mesh;
+            const size_t vertexBytes = cooked.VertexBytes(lod);
+            const size_t totalBytes = vertexBytes + cooked.IndexBytes(lod);
+
+            if (job.offset == 0) {
+                // Réserver les buffers, remplis ensuite morceau par morceau
+                mesh.Upload(nullptr, vertexBytes, nullptr, lod.indexCount, cooked.IndexType(), cooked.Header().layout);
+            }
+
+            size_t chunk = totalBytes - job.offset;
+            if (byteBudget != 0) {
+                chunk = std::min(chunk, byteBudget - uploaded);
+            }
+
+            // Partie vertices puis partie indices du morceau
+            const size_t begin = job.offset, end = job.offset + chunk;
+            if (begin < vertexBytes) {
+                const size_t count = std::min(end, vertexBytes) - begin;
+                glBindBuffer(GL_COPY_WRITE_BUFFER, mesh.VBO);
+                glBufferSubData(GL_COPY_WRITE_BUFFER, begin, count, cooked.VertexData(lod) + begin);
+            }
+            if (end > vertexBytes) {
+                const size_t indexBegin = std::max(begin, vertexBytes) - vertexBytes;
+                glBindBuffer(GL_COPY_WRITE_BUFFER, mesh.EBO);
+                glBufferSubData(GL_COPY_WRITE_BUFFER, indexBegin, end - vertexBytes - indexBegin,
+                                cooked.IndexData(lod) + indexBegin);
+            }
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            Metrics::Get().Add(METRIC_UPLOAD_BYTES, chunk);
+
+            job.offset = end;
+            uploaded += chunk;
+
+            if (job.offset == totalBytes) {
+                job.offset = 0;
+                if (++job.level == cooked.Header().lodCount) {
+                    job.asset->state.store(AssetState::Ready, std::memory_order_release);
+                    LOG_INFO("Mesh ready: " << job.asset->path);
+                    m_Uploading.pop_front();
+                    m_Pending.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+        }
+        return uploaded;
+    }
+
+    // Vrai quand plus aucun chargement n'est en cours
+    bool IsIdle() const {
+        return m_Pending.load(std::memory_order_relaxed) == 0;
+    }
+
+    ThreadPool& GetThreadPool() { return m_Pool; }
+
+private:
+    struct UploadJob {
+        MeshHandle asset;
+        CookedMesh cooked;      // Projection du fichier cuit (ou image en mémoire)
+        uint32_t level = 0;     // Niveau de LOD en cours d'envoi
+        size_t offset = 0;      // Octets déjà envoyés pour ce niveau (vertices puis indices)
+        bool started = false;
+    };
+
+    std::mutex m_Mutex;
+    std::deque<std::unique_ptr<UploadJob>> m_Prepared;   // Rempli par les threads de travail
+    std::deque<std::unique_ptr<UploadJob>> m_Uploading;  // Thread principal uniquement
+    std::atomic<size_t> m_Pending{0};
+
+    // Déclaré en dernier : détruit en premier, les threads de travail sont
+    // arrêtés avant la destruction des files qu'ils utilisent
+    ThreadPool m_Pool;
+};
@@ -0,0 +1,148 @@
+#pragma once
+#include <algorithm>
+#include <cfloat>
+#include <glm/glm.hpp>
+
+// ============================================
+// AABB - Boîte englobante alignée sur les axes
+// ============================================
+struct AABB {
+    glm::vec3 min{FLT_MAX, FLT_MAX, FLT_MAX};
+    glm::vec3 max{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+    AABB() = default;
+    AABB(const glm::vec3& minCorner, const glm::vec3& maxCorner)
+        : min(minCorner), max(maxCorner) {}
+
+    bool IsValid() const {
+        return min.x <= max.x && min.y <= max.y && min.z <= max.z;
+    }
+
+    void Expand(const glm::vec3& point) {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+
+    void Expand(const AABB& other) {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+
+    glm::vec3 Center() const { return (min + max) * 0.5f; }
+    glm::vec3 Size() const { return max - min; }
+    glm::vec3 Extents() const { return (max - min) * 0.5f; }
+
+    // Rayon de la sphère englobante centrée sur Center()
+    float Radius() const { return glm::length(Extents()); }
+
+    // Aire de la surface (coût SAH)
+    float SurfaceArea() const {
+        const glm::vec3 size = Size();
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    bool Overlaps(const AABB& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+
+    // Boîte englobant la boîte transformée (méthode d'Arvo)
+    AABB Transform(const glm::mat4& matrix) const {
+        glm::vec3 center = glm::vec3(matrix * glm::vec4(Center(), 1.0f));
+        glm::vec3 extents = Extents();
+        glm::vec3 newExtents(0.0f);
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                newExtents[i] += glm::abs(matrix[j][i]) * extents[j];
+            }
+        }
+        return AABB(center - newExtents, center + newExtents);
+    }
+};
+// ============================================
+// Frustum - Pyramide de vue (6 plans)
+// ============================================
+// Plans extraits d'une matrice projection * vue (* modèle) : avec la matrice
+// modèle incluse, les tests se font directement en espace objet.
+struct Frustum {
+    glm::vec4 planes[6]; // ax + by + cz + d >= 0 à l'intérieur
+
+    // Méthode de Gribb et Hartmann
+    static Frustum FromMatrix(const glm::mat4& m) {
+        Frustum frustum;
+        const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+        frustum.planes[0] = row3 + row0; // Gauche
+        frustum.planes[1] = row3 - row0; // Droite
+        frustum.planes[2] = row3 + row1; // Bas
+        frustum.planes[3] = row3 - row1; // Haut
+        frustum.planes[4] = row3 + row2; // Proche
+        frustum.planes[5] = row3 - row2; // Lointain
+        for (auto& plane : frustum.planes) {
+            const float length = glm::length(glm::vec3(plane));
+            if (length > 0.0f) {
+                plane /= length;
+            }
+        }
+        return frustum;
+    }
+
+    // Faux seulement si la boîte est entièrement derrière un plan (test conservatif)
+    bool Intersects(const AABB& box) const {
+        const glm::vec3 center = box.Center();
+        const glm::vec3 extents = box.Extents();
+        for (const auto& plane : planes) {
+            const glm::vec3 normal(plane);
+            const float radius = glm::dot(extents, glm::abs(normal));
+            if (glm::dot(normal, center) + plane.w < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Vrai si la boîte est entièrement devant les six plans
+    bool Contains(const AABB& box) const {
+        const glm::vec3 center = box.Center();
+        const glm::vec3 extents = box.Extents();
+        for (const auto& plane : planes) {
+            const glm::vec3 normal(plane);
+            const float radius = glm::dot(extents, glm::abs(normal));
+            if (glm::dot(normal, center) + plane.w < radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// ============================================
+// Ray - Demi-droite (direction normalisée)
+// ============================================
+struct Ray {
+    glm::vec3 origin{0.0f};
+    glm::vec3 direction{0.0f, 0.0f, -1.0f};
+    glm::vec3 inverseDirection{0.0f, 0.0f, -1.0f}; // 1 / direction, pour le test des boîtes
+
+    Ray() = default;
+    Ray(const glm::vec3& o, const glm::vec3& d) : origin(o), direction(glm::normalize(d)) {
+        inverseDirection = glm::vec3(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    }
+
+    glm::vec3 At(float t) const { return origin + direction * t; }
+
+    // Méthode des dalles : entrée dans la boîte (tEnter) si elle est touchée avant maxDistance
+    bool Intersects(const AABB& box, float maxDistance, float& tEnter) const {
+        const glm::vec3 t0 = (box.min - origin) * inverseDirection;
+        const glm::vec3 t1 = (box.max - origin) * inverseDirection;
+        const glm::vec3 tNear = glm::min(t0, t1);
+        const glm::vec3 tFar = glm::max(t0, t1);
+        const float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+        const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+        tEnter = enter;
+        return enter <= exit;
+    }
+};
@@ -0,0 +1,372 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "Metrics.h"
+#include "Renderer.h"
+#include "SIMD.h"
+#include "ThreadPool.h"
+
+// ============================================
+// PointLight - Lumière ponctuelle à portée limitée
+// ============================================
+// L'intensité s'annule à radius (fenêtre (1 - d²/r²)²), ce qui borne la
+// lumière et permet de la ranger dans les clusters qu'elle touche.
+struct PointLight {
+    glm::vec3 position{0.0f};
+    float radius = 1.0f;
+    glm::vec3 color{1.0f};
+    float intensity = 1.0f;
+
+    PointLight() = default;
+    PointLight(const glm::vec3& p, float r, const glm::vec3& c, float i = 1.0f)
+        : position(p), radius(r), color(c), intensity(i) {}
+};
+
+// Découpage de la pyramide de vue : tuiles à l'écran x tranches en profondeur
+struct ClusterGridSettings {
+    uint32_t tilesX = 16;
+    uint32_t tilesY = 9;
+    uint32_t slices = 24;   // Tranches exponentielles entre near et far
+};
+
+// ============================================
+// LightClusterer - Tri des lumières par cluster (forward+ en grille 3D)
+// ============================================
+// Chaque frame, Build range les lumières dans une grille tuiles x tranches de
+// l'espace vue (travail CPU uniquement, parallélisé par tranche, tests
+// sphère / boîte 4 lumières à la fois en SSE). Upload envoie ensuite trois
+// texture buffers :
+// - clusterGrid         (RG32UI)  : début et nombre de lumières de chaque cluster
+// - clusterLightIndices (R32UI)   : indices de lumières, cluster après cluster
+// - clusterLights       (RGBA32F) : position + rayon, couleur * intensité
+// Le fragment shader (variante CLUSTERED_LIGHTING) ne parcourt que les
+// lumières de son cluster.
+class LightClusterer {
+public:
+    explicit LightClusterer(const ClusterGridSettings& settings = ClusterGridSettings())
+        : m_Settings(settings) {}
+
+    ~LightClusterer() = default;
+
+    LightClusterer(const LightClusterer&) = delete;
+    LightClusterer& operator=(const LightClusterer&) = delete;
+
+    // À appeler quand la projection change (recalcule les boîtes des clusters)
+    void SetProjection(const glm::mat4& projection, float zNear, float zFar) {
+        if (projection == m_Projection && zNear == m_Near && zFar == m_Far && !m_ClusterBounds.empty()) {
+            return;
+        }
+        m_Projection = projection;
+        m_Near = zNear;
+        m_Far = zFar;
+
+        const uint32_t tilesX = m_Settings.tilesX, tilesY = m_Settings.tilesY, slices = m_Settings.slices;
+        m_ClusterBounds.resize(static_cast<size_t>(tilesX) * tilesY * slices);
+        m_SliceDepths.resize(slices + 1);
+        for (uint32_t z = 0; z <= slices; ++z) {
+            m_SliceDepths[z] = m_Near * std::pow(m_Far / m_Near, static_cast<float>(z) / slices);
+        }
+
+        // Point de vue (profondeur d > 0) sous la coordonnée NDC (nx, ny)
+        auto viewPoint = [&](float nx, float ny, float d) {
+            return glm::vec3(d * (nx + projection[2][0]) / projection[0][0],
+                             d * (ny + projection[2][1]) / projection[1][1], -d);
+        };
+
+        for (uint32_t z = 0; z < slices; ++z) {
+            for (uint32_t y = 0; y < tilesY; ++y) {
+                for (uint32_t x = 0; x < tilesX; ++x) {
+                    const float nx0 = -1.0f + 2.0f * x / tilesX, nx1 = -1.0f + 2.0f * (x + 1) / tilesX;
+                    const float ny0 = -1.0f + 2.0f * y / tilesY, ny1 = -1.0f + 2.0f * (y + 1) / tilesY;
+                    ClusterBounds& bounds = m_ClusterBounds[ClusterIndex(x, y, z)];
+                    bounds.min = glm::vec3(std::numeric_limits<float>::max());
+                    bounds.max = glm::vec3(std::numeric_limits<float>::lowest());
+                    for (float d : {m_SliceDepths[z], m_SliceDepths[z + 1]}) {
+                        for (float nx : {nx0, nx1}) {
+                            for (float ny : {ny0, ny1}) {
+                                const glm::vec3 p = viewPoint(nx, ny, d);
+                                bounds.min = glm::min(bounds.min, p);
+                                bounds.max = glm::max(bounds.max, p);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Range les lumières dans les clusters (aucun appel OpenGL ; pool optionnel)
+    void Build(const std::vector<PointLight>& lights, const glm::mat4& view, ThreadPool* pool = nullptr) {
+        PROFILE_SCOPE("LightClustering");
+        const uint32_t tilesX = m_Settings.tilesX, tilesY = m_Settings.tilesY, slices = m_Settings.slices;
+        const size_t clustersPerSlice = static_cast<size_t>(tilesX) * tilesY;
+        m_LightCount = lights.size();
+        m_Grid.assign(m_ClusterBounds.size() * 2, 0);
+        m_Indices.clear();
+        if (m_ClusterBounds.empty()) {
+            return;
+        }
+
+        // Positions en espace vue (SoA) et données GPU
+        m_ViewX.resize(lights.size());
+        m_ViewY.resize(lights.size());
+        m_ViewZ.resize(lights.size());
+        m_LightData.resize(lights.size() * 8);
+        for (size_t i = 0; i < lights.size(); ++i) {
+            const PointLight& light = lights[i];
+            const glm::vec4 p = view * glm::vec4(light.position, 1.0f);
+            m_ViewX[i] = p.x;
+            m_ViewY[i] = p.y;
+            m_ViewZ[i] = p.z;
+            float* data = &m_LightData[i * 8];
+            data[0] = light.position.x;
+            data[1] = light.position.y;
+            data[2] = light.position.z;
+            data[3] = light.radius;
+            data[4] = light.color.x * light.intensity;
+            data[5] = light.color.y * light.intensity;
+            data[6] = light.color.z * light.intensity;
+            data[7] = 0.0f;
+        }
+
+        m_SliceLists.resize(slices);
+        auto binSlices = [&](size_t begin, size_t end) {
+            for (size_t z = begin; z < end; ++z) {
+                BinSlice(lights, static_cast<uint32_t>(z));
+            }
+        };
+        if (pool) {
+            pool->ParallelFor(slices, binSlices, 2);
+        } else {
+            binSlices(0, slices);
+        }
+
+        // Concaténation des listes, tranche après tranche
+        size_t total = 0;
+        for (const SliceList& list : m_SliceLists) {
+            total += list.indices.size();
+        }
+        m_Indices.reserve(total);
+        for (uint32_t z = 0; z < slices; ++z) {
+            const SliceList& list = m_SliceLists[z];
+            const uint32_t base = static_cast<uint32_t>(m_Indices.size());
+            for (size_t c = 0; c < clustersPerSlice; ++c) {
+                const size_t cluster = z * clustersPerSlice + c;
+                m_Grid[cluster * 2] = base + list.offsets[c];
+                m_Grid[cluster * 2 + 1] = list.counts[c];
+            }
+            m_Indices.insert(m_Indices.end(), list.indices.begin(), list.indices.end());
+        }
+    }
+
+    // Envoie la grille et les lumières au GPU (thread principal)
+    void Upload() {
+        if (m_Buffers[GRID] == 0) {
+            glGenBuffers(BUFFER_COUNT, m_Buffers);
+            glGenTextures(BUFFER_COUNT, m_Textures);
+        }
+        UploadBuffer(GRID, GL_RG32UI, m_Grid.data(), m_Grid.size() * sizeof(uint32_t));
+        UploadBuffer(INDICES, GL_R32UI, m_Indices.data(), m_Indices.size() * sizeof(uint32_t));
+        UploadBuffer(LIGHTS, GL_RGBA32F, m_LightData.data(), m_LightData.size() * sizeof(float));
+    }
+
+    // Lie les texture buffers aux unités firstUnit..firstUnit+2 et règle les uniforms
+    void Bind(Shader& shader, const glm::vec2& viewportSize, int firstUnit = 4) const {
+        const char* samplers[BUFFER_COUNT] = {"clusterGrid", "clusterLightIndices", "clusterLights"};
+        for (int i = 0; i < BUFFER_COUNT; ++i) {
+            glActiveTexture(GL_TEXTURE0 + firstUnit + i);
+            glBindTexture(GL_TEXTURE_BUFFER, m_Textures[i]);
+            shader.SetInt(samplers[i], firstUnit + i);
+        }
+        glActiveTexture(GL_TEXTURE0);
+
+        // Tranche = floor(log(d) * scale + bias)
+        const float logRatio = std::log(m_Far / m_Near);
+        const float scale = m_Settings.slices / logRatio;
+        glUniform3ui(glGetUniformLocation(shader.ID, "clusterDims"), m_Settings.tilesX, m_Settings.tilesY, m_Settings.slices);
+        glUniform2f(glGetUniformLocation(shader.ID, "clusterDepthParams"), scale, -std::log(m_Near) * scale);
+        glUniform2f(glGetUniformLocation(shader.ID, "clusterScreenSize"), viewportSize.x, viewportSize.y);
+    }
+
+    void Cleanup() {
+        if (m_Buffers[GRID] != 0) {
+            glDeleteTextures(BUFFER_COUNT, m_Textures);
+            glDeleteBuffers(BUFFER_COUNT, m_Buffers);
+            std::fill(std::begin(m_Buffers), std::end(m_Buffers), 0u);
+            std::fill(std::begin(m_Textures), std::end(m_Textures), 0u);
+        }
+    }
+
+    // ---------- Résultats (pour le débogage et les benchmarks) ----------
+
+    size_t ClusterCount() const { return m_ClusterBounds.size(); }
+    size_t LightCount() const { return m_LightCount; }
+    size_t ReferenceCount() const { return m_Indices.size(); }
+    uint32_t ClusterLightCount(size_t cluster) const { return m_Grid[cluster * 2 + 1]; }
+    const uint32_t* ClusterLights(size_t cluster) const { return m_Indices.data() + m_Grid[cluster * 2]; }
+
+    uint32_t MaxLightsPerCluster() const {
+        uint32_t result = 0;
+        for (size_t c = 0; c < m_ClusterBounds.size(); ++c) {
+            result = std::max(result, m_Grid[c * 2 + 1]);
+        }
+        return result;
+    }
+
+    size_t ClusterIndex(uint32_t x, uint32_t y, uint32_t z) const {
+        return (static_cast<size_t>(z) * m_Settings.tilesY + y) * m_Settings.tilesX + x;
+    }
+
+    const ClusterGridSettings& Settings() const { return m_Settings; }
+
+private:
+    struct ClusterBounds {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    // Lumières d'une tranche (SoA, complétées à un multiple de 4)
+    struct SliceLights {
+        std::vector<float> x, y, z, radiusSquared;
+        std::vector<uint32_t> index;
+    };
+
+    // Listes de la tranche ; offsets relatifs au début de la tranche. Les
+    // candidats sont gardés d'une frame à l'autre : une tranche n'est traitée
+    // que par une tâche, et leur capacité évite toute allocation par frame.
+    struct SliceList {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> counts;
+        std::vector<uint32_t> indices;
+        SliceLights candidates;
+    };
+
+    void BinSlice(const std::vector<PointLight>& lights, uint32_t z) {
+        const size_t clustersPerSlice = static_cast<size_t>(m_Settings.tilesX) * m_Settings.tilesY;
+        SliceList& list = m_SliceLists[z];
+        SliceLights& candidates = list.candidates;
+        list.offsets.assign(clustersPerSlice, 0);
+        list.counts.assign(clustersPerSlice, 0);
+        list.indices.clear();
+
+        // Lumières dont la sphère chevauche la tranche en profondeur
+        const float sliceNear = m_SliceDepths[z], sliceFar = m_SliceDepths[z + 1];
+        candidates.x.clear();
+        candidates.y.clear();
+        candidates.z.clear();
+        candidates.radiusSquared.clear();
+        candidates.index.clear();
+        for (size_t i = 0; i < lights.size(); ++i) {
+            const float depth = -m_ViewZ[i];
+            const float radius = lights[i].radius;
+            if (depth + radius < sliceNear || depth - radius > sliceFar) {
+                continue;
+            }
+            candidates.x.push_back(m_ViewX[i]);
+            candidates.y.push_back(m_ViewY[i]);
+            candidates.z.push_back(m_ViewZ[i]);
+            candidates.radiusSquared.push_back(radius * radius);
+            candidates.index.push_back(static_cast<uint32_t>(i));
+        }
+        const size_t count = candidates.index.size();
+        // Bourrage : rayon² négatif, jamais retenu
+        while (candidates.x.size() % 4 != 0) {
+            candidates.x.push_back(0.0f);
+            candidates.y.push_back(0.0f);
+            candidates.z.push_back(0.0f);
+            candidates.radiusSquared.push_back(-1.0f);
+        }
+        if (count == 0) {
+            return;
+        }
+
+        for (size_t c = 0; c < clustersPerSlice; ++c) {
+            const ClusterBounds& bounds = m_ClusterBounds[z * clustersPerSlice + c];
+            list.offsets[c] = static_cast<uint32_t>(list.indices.size());
+            for (size_t i = 0; i < candidates.x.size(); i += 4) {
+                unsigned int mask = SphereBoxMask(candidates, i, bounds);
+                while (mask != 0) {
+                    const unsigned int lane = LowestBit(mask);
+                    list.indices.push_back(candidates.index[i + lane]);
+                    mask &= mask - 1;
+                }
+            }
+            list.counts[c] = static_cast<uint32_t>(list.indices.size()) - list.offsets[c];
+        }
+    }
+
+    static unsigned int LowestBit(unsigned int mask) {
+        unsigned int lane = 0;
+        while (!(mask & (1u << lane))) {
+            ++lane;
+        }
+        return lane;
+    }
+
+    // Bit k à 1 si la lumière first + k touche la boîte
+    static unsigned int SphereBoxMask(const SliceLights& lights, size_t first, const ClusterBounds& box) {
+#ifdef GAMEENGINE_SSE
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 x = _mm_loadu_ps(&lights.x[first]);
+        const __m128 y = _mm_loadu_ps(&lights.y[first]);
+        const __m128 z = _mm_loadu_ps(&lights.z[first]);
+        // Distance à la boîte par axe : max(min - c, 0, c - max)
+        const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(box.min.x), x), zero),
+                                     _mm_sub_ps(x, _mm_set1_ps(box.max.x)));
+        const __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(box.min.y), y), zero),
+                                     _mm_sub_ps(y, _mm_set1_ps(box.max.y)));
+        const __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(box.min.z), z), zero),
+                                     _mm_sub_ps(z, _mm_set1_ps(box.max.z)));
+        const __m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        return static_cast<unsigned int>(
+            _mm_movemask_ps(_mm_cmple_ps(distanceSquared, _mm_loadu_ps(&lights.radiusSquared[first]))));
+#else
+        unsigned int mask = 0;
+        for (size_t k = 0; k < 4; ++k) {
+            const size_t i = first + k;
+            const float dx = std::max(std::max(box.min.x - lights.x[i], 0.0f), lights.x[i] - box.max.x);
+            const float dy = std::max(std::max(box.min.y - lights.y[i], 0.0f), lights.y[i] - box.max.y);
+            const float dz = std::max(std::max(box.min.z - lights.z[i], 0.0f), lights.z[i] - box.max.z);
+            if (dx * dx + dy * dy + dz * dz <= lights.radiusSquared[i]) {
+                mask |= 1u << k;
+            }
+        }
+        return mask;
+#endif
+    }
+
+    void UploadBuffer(int slot, GLenum format, const void* data, size_t bytes) {
+        // Réallocation à chaque frame : le pilote peut garder l'ancienne copie en vol
+        glBindBuffer(GL_TEXTURE_BUFFER, m_Buffers[slot]);
+        glBufferData(GL_TEXTURE_BUFFER, std::max<size_t>(bytes, 16), bytes > 0 ? data : nullptr, GL_STREAM_DRAW);
+        Metrics::Get().Add(METRIC_UPLOAD_BYTES, bytes);
+        glBindTexture(GL_TEXTURE_BUFFER, m_Textures[slot]);
+        glTexBuffer(GL_TEXTURE_BUFFER, format, m_Buffers[slot]);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    }
+
+    ClusterGridSettings m_Settings;
+    glm::mat4 m_Projection{0.0f};
+    float m_Near = 0.1f;
+    float m_Far = 100.0f;
+    std::vector<ClusterBounds> m_ClusterBounds;
+    std::vector<float> m_SliceDepths;
+
+    size_t m_LightCount = 0;
+    std::vector<float> m_ViewX, m_ViewY, m_ViewZ;
+    std::vector<SliceList> m_SliceLists;
+    std::vector<uint32_t> m_Grid;       // (début, nombre) par cluster
+    std::vector<uint32_t> m_Indices;
+    std::vector<float> m_LightData;     // 2 texels RGBA32F par lumière
+
+    enum { GRID, INDICES, LIGHTS, BUFFER_COUNT };
+    unsigned int m_Buffers[BUFFER_COUNT] = {0, 0, 0};
+    unsigned int m_Textures[BUFFER_COUNT] = {0, 0, 0};
+};
@@ -1,5 +1,10 @@
 #pragma once
 #include <glm/glm.hpp> // Pour les vecteurs 3D (tu devras installer GLM)
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Snapshot.h"
 
 // ============================================
 // Transform Component - Position, rotation, scale
@@ -49,6 +54,87 @@ struct Mesh {
         : meshID(mesh), materialID(mat) {}
 };
 
+// ============================================
+// BoundingBox Component - Boîte englobante en espace local
+// ============================================
+// Pour les entités sans mesh (physique) ou pour remplacer la boîte du mesh
+// dans l'index spatial de la scène.
+struct BoundingBox {
+    glm::vec3 min{-0.5f, -0.5f, -0.5f};
+    glm::vec3 max{0.5f, 0.5f, 0.5f};
+
+    BoundingBox() = default;
+    BoundingBox(const glm::vec3& minCorner, const glm::vec3& maxCorner)
+        : min(minCorner), max(maxCorner) {}
+};
+
+// ============================================
+// Occluder Component - L'entité cache ce qui est derrière elle
+// ============================================
+// Son mesh doit avoir été chargé avec MESH_LOAD_OCCLUDER ; il est alors
+// rastérisé dans le tampon de profondeur de l'OcclusionSystem (sauf si
+// l'entité a un Deformable actif).
+struct Occluder {
+    bool enabled = true;
+
+    Occluder() = default;
+    Occluder(bool isEnabled) : enabled(isEnabled) {}
+};
+
+// ============================================
+// Deformable Component - Pose d'un mesh animé
+// ============================================
+// Son mesh doit avoir été chargé avec MESH_LOAD_DEFORMABLE ; le
+// DeformationSystem applique cette pose (morph targets, puis skinning) et le
+// RenderSystem dessine le résultat au lieu du mesh au repos.
+struct Deformable {
+    std::vector<float> morphWeights;     // Un poids par morph target du mesh
+    std::vector<glm::mat4> jointPose;    // Transformations locales des articulations (vide : pose de liaison)
+    bool enabled = true;
+
+    Deformable() = default;
+};
+
+// Tableaux de taille variable : nombre d'éléments puis données brutes
+template<>
+struct SnapshotCodec<Deformable> {
+    static constexpr bool SUPPORTED = true;
+
+    static void Write(SnapshotWriter& writer, const Deformable& deformable) {
+        writer.Write(static_cast<uint32_t>(deformable.morphWeights.size()));
+        writer.WriteBytes(deformable.morphWeights.data(), deformable.morphWeights.size() * sizeof(float));
+        writer.Write(static_cast<uint32_t>(deformable.jointPose.size()));
+        writer.WriteBytes(deformable.jointPose.data(), deformable.jointPose.size() * sizeof(glm::mat4));
+        writer.Write(static_cast<uint8_t>(deformable.enabled ? 1 : 0));
+    }
+
+    static bool Read(SnapshotReader& reader, Deformable& deformable) {
+        uint8_t enabled = 0;
+        if (!ReadArray(reader, deformable.morphWeights) || !ReadArray(reader, deformable.jointPose) ||
+            !reader.Read(enabled)) {
+            return false;
+        }
+        deformable.enabled = enabled != 0;
+        return true;
+    }
+
+private:
+    // La taille est vérifiée avant d'allouer (snapshot tronqué ou corrompu)
+    template<typename T>
+    static bool ReadArray(SnapshotReader& reader, std::vector<T>& values) {
+        uint32_t count = 0;
+        const uint8_t* data = nullptr;
+        if (!reader.Read(count) || count > reader.Remaining() / sizeof(T) || !reader.Take(count * sizeof(T), data)) {
+            return false;
+        }
+        values.resize(count);
+        if (count > 0) {
+            std::memcpy(values.data(), data, count * sizeof(T));
+        }
+        return true;
+    }
+};
+
 // ============================================
 // Camera Component - Caméra pour le rendu
 // ============================================
@@ -70,4 +156,12 @@ struct Tag {
 
     Tag() = default;
     Tag(const std::string& n) : name(n) {}
-};
\ No newline at end of file
+};
+
+// Le nom n'est pas trivialement copiable : encodage explicite pour les snapshots
+template<>
+struct SnapshotCodec<Tag> {
+    static constexpr bool SUPPORTED = true;
+    static void Write(SnapshotWriter& writer, const Tag& tag) { writer.WriteString(tag.name); }
+    static bool Read(SnapshotReader& reader, Tag& tag) { return reader.ReadString(tag.name); }
+};
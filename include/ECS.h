@@ -1,11 +1,22 @@
 #pragma once
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <bitset>
 #include <array>
 #include <queue>
 #include <unordered_map>
 #include <memory>
 #include <set>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#include "Hash.h"
+#include "Log.h"
+#include "Memory.h"
+#include "Snapshot.h"
 
 // Types de base pour l'ECS
 using Entity = std::uint32_t;
@@ -17,6 +28,15 @@ const ComponentType MAX_COMPONENTS = 32;
 // Signature = quels components une entité possède
 using Signature = std::bitset<MAX_COMPONENTS>;
 
+// Entités d'un système : nœuds pris dans un pool plutôt qu'un new par insertion
+using EntitySet = std::set<Entity, std::less<Entity>, PoolAllocator<Entity>>;
+
+// Tick de changement : un compteur qui avance à la fin du passage de chaque
+// système (voir Coordinator::EndSystemRun). Un component écrit porte le tick
+// courant ; il a changé pour un système si son tick dépasse le dernier
+// passage de ce système.
+using ChangeTick = std::uint32_t;
+
 // ============================================
 // EntityManager - Gère la création/destruction d'entités
 // ============================================
@@ -36,6 +56,7 @@ public:
 
         Entity id = m_AvailableEntities.front();
         m_AvailableEntities.pop();
+        m_Living.set(id);
         ++m_LivingEntityCount;
 
         return id;
@@ -48,6 +69,7 @@ public:
 
         // Réinitialiser la signature
         m_Signatures[entity].reset();
+        m_Living.reset(entity);
 
         // Remettre l'ID dans la queue
         m_AvailableEntities.push(entity);
@@ -61,16 +83,40 @@ public:
         m_Signatures[entity] = signature;
     }
 
-    Signature GetSignature(Entity entity) {
+    Signature GetSignature(Entity entity) const {
         if (entity >= MAX_ENTITIES) {
             throw std::out_of_range("Entity out of range.");
         }
         return m_Signatures[entity];
     }
 
+    uint32_t GetLivingEntityCount() const { return m_LivingEntityCount; }
+
+    bool IsAlive(Entity entity) const { return entity < MAX_ENTITIES && m_Living.test(entity); }
+
+    // Remplace tout l'état (chargement d'un snapshot) ; les IDs libres
+    // repartent dans l'ordre croissant
+    void Restore(const std::vector<Entity>& entities, const std::vector<Signature>& signatures) {
+        m_Signatures.fill(Signature());
+        m_Living.reset();
+        for (size_t i = 0; i < entities.size(); ++i) {
+            m_Living.set(entities[i]);
+            m_Signatures[entities[i]] = signatures[i];
+        }
+
+        m_AvailableEntities = std::queue<Entity>();
+        for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+            if (!m_Living.test(entity)) {
+                m_AvailableEntities.push(entity);
+            }
+        }
+        m_LivingEntityCount = static_cast<uint32_t>(entities.size());
+    }
+
 private:
     std::queue<Entity> m_AvailableEntities{};
     std::array<Signature, MAX_ENTITIES> m_Signatures{};
+    std::bitset<MAX_ENTITIES> m_Living{};
     uint32_t m_LivingEntityCount{};
 };
 
@@ -81,64 +127,253 @@ class IComponentArray {
 public:
     virtual ~IComponentArray() = default;
     virtual void EntityDestroyed(Entity entity) = 0;
+    virtual size_t Size() const = 0;
+
+    // Snapshots (voir Coordinator::SaveSnapshot)
+    virtual bool IsSerializable() const = 0;
+    virtual uint32_t ElementSize() const = 0;
+    // base : le même tableau dans le snapshot de référence (delta), ou nullptr
+    virtual void WriteSnapshot(SnapshotWriter& writer, const SnapshotReader* base) const = 0;
+    virtual bool ReadSnapshot(SnapshotReader& reader, bool delta) = 0;
+    // Retire les components des entités mortes ou dont la signature n'a plus ce type
+    virtual void Retain(const EntityManager& entities, ComponentType type) = 0;
 };
 
+const uint32_t INVALID_COMPONENT_INDEX = UINT32_MAX;
+
 // ============================================
 // ComponentArray - Stocke tous les components d'un type donné
 // ============================================
+// Tableau dense (components contigus, sans trou) et tableau creux indexé par
+// entité pour retrouver la position d'un component : pas de table de hachage,
+// et un snapshot du tableau dense se sauvegarde et se recharge en bloc.
+// Chaque component porte le tick de sa dernière écriture : l'ajout et
+// GetData le mettent à jour, ReadData non.
 template<typename T>
 class ComponentArray : public IComponentArray {
 public:
+    explicit ComponentArray(const ChangeTick& changeTick) : m_ChangeTick(changeTick) {
+        m_EntityToIndex.fill(INVALID_COMPONENT_INDEX);
+    }
+
     void InsertData(Entity entity, T component) {
-        if (m_EntityToIndexMap.find(entity) != m_EntityToIndexMap.end()) {
+        if (entity >= MAX_ENTITIES) {
+            throw std::out_of_range("Entity out of range.");
+        }
+        if (m_EntityToIndex[entity] != INVALID_COMPONENT_INDEX) {
             throw std::runtime_error("Component added to same entity more than once.");
         }
 
         size_t newIndex = m_Size;
-        m_EntityToIndexMap[entity] = newIndex;
-        m_IndexToEntityMap[newIndex] = entity;
-        m_ComponentArray[newIndex] = component;
+        m_EntityToIndex[entity] = static_cast<uint32_t>(newIndex);
+        m_IndexToEntity[newIndex] = entity;
+        m_ComponentArray[newIndex] = std::move(component);
+        m_ChangeTicks[newIndex] = m_ChangeTick;
         ++m_Size;
     }
 
     void RemoveData(Entity entity) {
-        if (m_EntityToIndexMap.find(entity) == m_EntityToIndexMap.end()) {
+        if (!Contains(entity)) {
             throw std::runtime_error("Removing non-existent component.");
         }
 
         // Copier le dernier élément à la place de l'élément supprimé
-        size_t indexOfRemovedEntity = m_EntityToIndexMap[entity];
+        size_t indexOfRemovedEntity = m_EntityToIndex[entity];
         size_t indexOfLastElement = m_Size - 1;
         m_ComponentArray[indexOfRemovedEntity] = m_ComponentArray[indexOfLastElement];
+        m_ChangeTicks[indexOfRemovedEntity] = m_ChangeTicks[indexOfLastElement];
 
-        // Mettre à jour les maps
-        Entity entityOfLastElement = m_IndexToEntityMap[indexOfLastElement];
-        m_EntityToIndexMap[entityOfLastElement] = indexOfRemovedEntity;
-        m_IndexToEntityMap[indexOfRemovedEntity] = entityOfLastElement;
-
-        m_EntityToIndexMap.erase(entity);
-        m_IndexToEntityMap.erase(indexOfLastElement);
+        // Mettre à jour les index
+        Entity entityOfLastElement = m_IndexToEntity[indexOfLastElement];
+        m_EntityToIndex[entityOfLastElement] = static_cast<uint32_t>(indexOfRemovedEntity);
+        m_IndexToEntity[indexOfRemovedEntity] = entityOfLastElement;
+        m_EntityToIndex[entity] = INVALID_COMPONENT_INDEX;
 
         --m_Size;
     }
 
+    // Accès en écriture : le component est marqué comme modifié
     T& GetData(Entity entity) {
-        if (m_EntityToIndexMap.find(entity) == m_EntityToIndexMap.end()) {
+        if (!Contains(entity)) {
+            throw std::runtime_error("Retrieving non-existent component.");
+        }
+        const uint32_t index = m_EntityToIndex[entity];
+        m_ChangeTicks[index] = m_ChangeTick;
+        return m_ComponentArray[index];
+    }
+
+    const T& ReadData(Entity entity) const {
+        if (!Contains(entity)) {
             throw std::runtime_error("Retrieving non-existent component.");
         }
-        return m_ComponentArray[m_EntityToIndexMap[entity]];
+        return m_ComponentArray[m_EntityToIndex[entity]];
+    }
+
+    // Vrai si le component a été ajouté ou écrit après le tick since
+    bool ChangedSince(Entity entity, ChangeTick since) const {
+        return Contains(entity) && m_ChangeTicks[m_EntityToIndex[entity]] > since;
+    }
+
+    // fn(Entity, const T&) pour chaque component ajouté ou écrit après since ;
+    // parcours linéaire des ticks, sans toucher aux components inchangés
+    template<typename Fn>
+    void ForEachChanged(ChangeTick since, Fn&& fn) const {
+        for (size_t i = 0; i < m_Size; ++i) {
+            if (m_ChangeTicks[i] > since) {
+                fn(m_IndexToEntity[i], m_ComponentArray[i]);
+            }
+        }
+    }
+
+    bool Contains(Entity entity) const {
+        return entity < MAX_ENTITIES && m_EntityToIndex[entity] != INVALID_COMPONENT_INDEX;
     }
 
     void EntityDestroyed(Entity entity) override {
-        if (m_EntityToIndexMap.find(entity) != m_EntityToIndexMap.end()) {
+        if (Contains(entity)) {
             RemoveData(entity);
         }
     }
 
+    size_t Size() const override { return m_Size; }
+
+    bool IsSerializable() const override { return SnapshotCodec<T>::SUPPORTED; }
+    uint32_t ElementSize() const override { return static_cast<uint32_t>(sizeof(T)); }
+
+    // Format : uint32 nombre, les entités, puis les components dans le même
+    // ordre (bruts si T est trivialement copiable, sinon via SnapshotCodec)
+    void WriteSnapshot(SnapshotWriter& writer, const SnapshotReader* base) const override {
+        if (!base) {
+            writer.Write(static_cast<uint32_t>(m_Size));
+            writer.WriteBytes(m_IndexToEntity.data(), m_Size * sizeof(Entity));
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                writer.WriteBytes(m_ComponentArray.data(), m_Size * sizeof(T));
+            } else {
+                for (size_t i = 0; i < m_Size; ++i) {
+                    SnapshotCodec<T>::Write(writer, m_ComponentArray[i]);
+                }
+            }
+            return;
+        }
+
+        // Delta : position de l'encodage de chaque entité dans la référence
+        std::vector<uint32_t> baseStart(MAX_ENTITIES, INVALID_COMPONENT_INDEX);
+        std::vector<uint32_t> baseEnd(MAX_ENTITIES, 0);
+        SnapshotReader reader = *base;
+        uint32_t baseCount = 0;
+        const uint8_t* baseEntities = nullptr;
+        if (reader.Read(baseCount) && baseCount <= MAX_ENTITIES &&
+            reader.Take(baseCount * sizeof(Entity), baseEntities)) {
+            T value{};
+            for (uint32_t i = 0; i < baseCount; ++i) {
+                Entity entity;
+                std::memcpy(&entity, baseEntities + i * sizeof(Entity), sizeof(Entity));
+                const size_t start = reader.Offset();
+                if (!SnapshotCodec<T>::Read(reader, value)) {
+                    break;
+                }
+                if (entity < MAX_ENTITIES) {
+                    baseStart[entity] = static_cast<uint32_t>(start);
+                    baseEnd[entity] = static_cast<uint32_t>(reader.Offset());
+                }
+            }
+        }
+
+        // Seuls les components absents de la référence ou dont l'encodage diffère
+        std::vector<Entity> changed;
+        std::vector<uint8_t> payload;
+        SnapshotWriter payloadWriter(payload);
+        for (size_t i = 0; i < m_Size; ++i) {
+            const Entity entity = m_IndexToEntity[i];
+            const size_t start = payload.size();
+            SnapshotCodec<T>::Write(payloadWriter, m_ComponentArray[i]);
+            const size_t length = payload.size() - start;
+            if (baseStart[entity] != INVALID_COMPONENT_INDEX && baseEnd[entity] - baseStart[entity] == length &&
+                std::memcmp(payload.data() + start, base->Data() + baseStart[entity], length) == 0) {
+                payload.resize(start);
+            } else {
+                changed.push_back(entity);
+            }
+        }
+        writer.Write(static_cast<uint32_t>(changed.size()));
+        writer.WriteBytes(changed.data(), changed.size() * sizeof(Entity));
+        writer.WriteBytes(payload.data(), payload.size());
+    }
+
+    // Complet : remplace le contenu du tableau. Delta : ajoute ou écrase
+    // seulement les components listés.
+    bool ReadSnapshot(SnapshotReader& reader, bool delta) override {
+        uint32_t count = 0;
+        const uint8_t* entities = nullptr;
+        if (!reader.Read(count) || count > MAX_ENTITIES || !reader.Take(count * sizeof(Entity), entities)) {
+            return false;
+        }
+        if (!delta) {
+            Clear();
+        }
+
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (!delta) {
+                // Deux copies en bloc, puis reconstruction du tableau creux
+                const uint8_t* data = nullptr;
+                if (!reader.Take(count * sizeof(T), data)) {
+                    return false;
+                }
+                std::memcpy(m_IndexToEntity.data(), entities, count * sizeof(Entity));
+                std::memcpy(m_ComponentArray.data(), data, count * sizeof(T));
+                std::fill(m_ChangeTicks.begin(), m_ChangeTicks.begin() + count, m_ChangeTick);
+                for (uint32_t i = 0; i < count; ++i) {
+                    const Entity entity = m_IndexToEntity[i];
+                    if (entity >= MAX_ENTITIES || m_EntityToIndex[entity] != INVALID_COMPONENT_INDEX) {
+                        Clear();
+                        return false;
+                    }
+                    m_EntityToIndex[entity] = i;
+                    m_Size = i + 1;
+                }
+                return true;
+            }
+        }
+
+        for (uint32_t i = 0; i < count; ++i) {
+            Entity entity;
+            std::memcpy(&entity, entities + i * sizeof(Entity), sizeof(Entity));
+            T value{};
+            if (entity >= MAX_ENTITIES || !SnapshotCodec<T>::Read(reader, value)) {
+                return false;
+            }
+            if (Contains(entity)) {
+                GetData(entity) = std::move(value);
+            } else {
+                InsertData(entity, std::move(value));
+            }
+        }
+        return true;
+    }
+
+    void Retain(const EntityManager& entities, ComponentType type) override {
+        // À rebours : RemoveData déplace le dernier élément, déjà vérifié
+        for (size_t i = m_Size; i-- > 0;) {
+            const Entity entity = m_IndexToEntity[i];
+            if (!entities.IsAlive(entity) || !entities.GetSignature(entity).test(type)) {
+                RemoveData(entity);
+            }
+        }
+    }
+
 private:
+    void Clear() {
+        for (size_t i = 0; i < m_Size; ++i) {
+            m_EntityToIndex[m_IndexToEntity[i]] = INVALID_COMPONENT_INDEX;
+        }
+        m_Size = 0;
+    }
+
     std::array<T, MAX_ENTITIES> m_ComponentArray{};
-    std::unordered_map<Entity, size_t> m_EntityToIndexMap{};
-    std::unordered_map<size_t, Entity> m_IndexToEntityMap{};
+    std::array<uint32_t, MAX_ENTITIES> m_EntityToIndex;   // Entité -> index dense
+    std::array<Entity, MAX_ENTITIES> m_IndexToEntity{};   // Index dense -> entité
+    std::array<ChangeTick, MAX_ENTITIES> m_ChangeTicks{}; // Index dense -> dernière écriture
+    const ChangeTick& m_ChangeTick;                       // Tick courant (ComponentManager)
     size_t m_Size{};
 };
 
@@ -156,7 +391,7 @@ public:
         }
 
         m_ComponentTypes.insert({typeName, m_NextComponentType});
-        m_ComponentArrays.insert({typeName, std::make_shared<ComponentArray<T>>()});
+        m_ComponentArrays.insert({typeName, std::make_shared<ComponentArray<T>>(m_ChangeTick)});
 
         ++m_NextComponentType;
     }
@@ -172,6 +407,11 @@ public:
         return m_ComponentTypes[typeName];
     }
 
+    template<typename T>
+    bool IsComponentRegistered() const {
+        return m_ComponentTypes.find(typeid(T).name()) != m_ComponentTypes.end();
+    }
+
     template<typename T>
     void AddComponent(Entity entity, T component) {
         GetComponentArray<T>()->InsertData(entity, component);
@@ -187,6 +427,24 @@ public:
         return GetComponentArray<T>()->GetData(entity);
     }
 
+    template<typename T>
+    const T& ReadComponent(Entity entity) {
+        return GetComponentArray<T>()->ReadData(entity);
+    }
+
+    template<typename T>
+    bool ChangedSince(Entity entity, ChangeTick since) {
+        return GetComponentArray<T>()->ChangedSince(entity, since);
+    }
+
+    template<typename T, typename Fn>
+    void ForEachChanged(ChangeTick since, Fn&& fn) {
+        GetComponentArray<T>()->ForEachChanged(since, std::forward<Fn>(fn));
+    }
+
+    ChangeTick GetChangeTick() const { return m_ChangeTick; }
+    ChangeTick AdvanceChangeTick() { return m_ChangeTick++; }
+
     void EntityDestroyed(Entity entity) {
         for (auto const& pair : m_ComponentArrays) {
             auto const& component = pair.second;
@@ -194,10 +452,39 @@ public:
         }
     }
 
+    // Nombre total de components, tous types confondus
+    size_t GetComponentCount() const {
+        size_t count = 0;
+        for (auto const& pair : m_ComponentArrays) {
+            count += pair.second->Size();
+        }
+        return count;
+    }
+
+    // fn(nom du type, ComponentType, IComponentArray&) pour chaque type enregistré
+    template<typename Fn>
+    void ForEachComponentArray(Fn&& fn) const {
+        for (auto const& pair : m_ComponentTypes) {
+            fn(pair.first, pair.second, *m_ComponentArrays.at(pair.first));
+        }
+    }
+
+    // Recherche par nom de type (snapshots) ; nullptr si le type n'est pas enregistré
+    IComponentArray* FindComponentArray(const std::string& typeName, ComponentType& type) const {
+        for (auto const& pair : m_ComponentTypes) {
+            if (typeName == pair.first) {
+                type = pair.second;
+                return m_ComponentArrays.at(pair.first).get();
+            }
+        }
+        return nullptr;
+    }
+
 private:
     std::unordered_map<const char*, ComponentType> m_ComponentTypes{};
     std::unordered_map<const char*, std::shared_ptr<IComponentArray>> m_ComponentArrays{};
     ComponentType m_NextComponentType{};
+    ChangeTick m_ChangeTick = 1;   // 0 : "jamais passé", tout component a changé depuis
 
     template<typename T>
     std::shared_ptr<ComponentArray<T>> GetComponentArray() {
@@ -216,7 +503,8 @@ private:
 // ============================================
 class System {
 public:
-    std::set<Entity> m_Entities;
+    EntitySet m_Entities;
+    ChangeTick m_LastRunTick = 0;   // Fin du passage précédent (Coordinator::EndSystemRun)
 };
 
 // ============================================
@@ -284,6 +572,7 @@ public:
         m_EntityManager = std::make_unique<EntityManager>();
         m_ComponentManager = std::make_unique<ComponentManager>();
         m_SystemManager = std::make_unique<SystemManager>();
+        m_SignatureTicks.assign(MAX_ENTITIES, 0);
     }
 
     // Entity methods
@@ -295,6 +584,19 @@ public:
         m_EntityManager->DestroyEntity(entity);
         m_ComponentManager->EntityDestroyed(entity);
         m_SystemManager->EntityDestroyed(entity);
+        m_SignatureTicks[entity] = m_ComponentManager->GetChangeTick();
+    }
+
+    uint32_t GetEntityCount() const {
+        return m_EntityManager->GetLivingEntityCount();
+    }
+
+    bool IsAlive(Entity entity) const {
+        return m_EntityManager->IsAlive(entity);
+    }
+
+    size_t GetComponentCount() const {
+        return m_ComponentManager->GetComponentCount();
     }
 
     // Component methods
@@ -310,6 +612,7 @@ public:
         auto signature = m_EntityManager->GetSignature(entity);
         signature.set(m_ComponentManager->GetComponentType<T>(), true);
         m_EntityManager->SetSignature(entity, signature);
+        m_SignatureTicks[entity] = m_ComponentManager->GetChangeTick();
 
         m_SystemManager->EntitySignatureChanged(entity, signature);
     }
@@ -321,20 +624,36 @@ public:
         auto signature = m_EntityManager->GetSignature(entity);
         signature.set(m_ComponentManager->GetComponentType<T>(), false);
         m_EntityManager->SetSignature(entity, signature);
+        m_SignatureTicks[entity] = m_ComponentManager->GetChangeTick();
 
         m_SystemManager->EntitySignatureChanged(entity, signature);
     }
 
+    // Accès en écriture : le component compte comme modifié pour les
+    // systèmes qui suivent les changements. Pour une simple lecture,
+    // préférer ReadComponent.
     template<typename T>
     T& GetComponent(Entity entity) {
         return m_ComponentManager->GetComponent<T>(entity);
     }
 
+    template<typename T>
+    const T& ReadComponent(Entity entity) {
+        return m_ComponentManager->ReadComponent<T>(entity);
+    }
+
     template<typename T>
     ComponentType GetComponentType() {
         return m_ComponentManager->GetComponentType<T>();
     }
 
+    // Faux aussi si le type de component n'est pas enregistré
+    template<typename T>
+    bool HasComponent(Entity entity) {
+        return m_ComponentManager->IsComponentRegistered<T>() &&
+               m_EntityManager->GetSignature(entity).test(m_ComponentManager->GetComponentType<T>());
+    }
+
     // System methods
     template<typename T>
     std::shared_ptr<T> RegisterSystem() {
@@ -346,8 +665,261 @@ public:
         m_SystemManager->SetSignature<T>(signature);
     }
 
+    // Change tracking methods
+    // Dans un système : HasChanged<T>(entity, m_LastRunTick), ou
+    // ForEachChanged<T>(m_LastRunTick, ...), puis EndSystemRun(*this) en fin
+    // de passage. Les écritures faites pendant le passage ne comptent pas
+    // pour le système lui-même ; celles faites ensuite, par n'importe qui,
+    // seront vues au passage suivant.
+    // Faux aussi si le type de component n'est pas enregistré
+    template<typename T>
+    bool HasChanged(Entity entity, ChangeTick since) {
+        return m_ComponentManager->IsComponentRegistered<T>() &&
+               m_ComponentManager->ChangedSince<T>(entity, since);
+    }
+
+    // fn(Entity, const T&) pour chaque component T ajouté ou écrit après
+    // since ; sans effet si le type n'est pas enregistré
+    template<typename T, typename Fn>
+    void ForEachChanged(ChangeTick since, Fn&& fn) {
+        if (m_ComponentManager->IsComponentRegistered<T>()) {
+            m_ComponentManager->ForEachChanged<T>(since, std::forward<Fn>(fn));
+        }
+    }
+
+    // fn(Entity) pour chaque entité créée (premier component), détruite, ou
+    // dont un component a été ajouté ou retiré après since : c'est ainsi
+    // qu'un système voit les entrées et sorties sans comparer ses listes
+    template<typename Fn>
+    void ForEachSignatureChanged(ChangeTick since, Fn&& fn) {
+        for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+            if (m_SignatureTicks[entity] > since) {
+                fn(entity);
+            }
+        }
+    }
+
+    void EndSystemRun(System& system) {
+        system.m_LastRunTick = m_ComponentManager->AdvanceChangeTick();
+    }
+
+    ChangeTick GetChangeTick() const {
+        return m_ComponentManager->GetChangeTick();
+    }
+
+    // Snapshot methods
+    // Sauvegarde binaire du monde : les entités vivantes et leurs signatures,
+    // puis pour chaque type de component son tableau dense (copié en un bloc
+    // si le type est trivialement copiable). Les types sont identifiés par leur
+    // nom et leur taille : un snapshot se recharge avec le même exécutable,
+    // pas forcément avec le même ordre d'enregistrement des components. Les
+    // systèmes ne sont pas sauvegardés, leurs listes d'entités sont
+    // reconstruites à partir des signatures. Faux (et out vide) si un type
+    // enregistré n'a pas de SnapshotCodec : le recharger effacerait ces
+    // components, le snapshot est donc refusé plutôt qu'incomplet.
+    bool SaveSnapshot(std::vector<uint8_t>& out) const {
+        return WriteSnapshot(out, nullptr);
+    }
+
+    // Delta par rapport au snapshot complet base : les entités et signatures,
+    // puis seulement les components ajoutés ou modifiés depuis base (les
+    // suppressions se déduisent des signatures). Faux si base n'est pas un
+    // snapshot complet valide, ou pour un type sans SnapshotCodec.
+    bool SaveSnapshotDelta(const std::vector<uint8_t>& base, std::vector<uint8_t>& out) const {
+        return WriteSnapshot(out, &base);
+    }
+
+    // Charge un snapshot complet, ou un delta si le dernier snapshot complet
+    // chargé est sa référence. Faux si les données sont invalides ; le monde
+    // peut alors être à moitié chargé.
+    bool LoadSnapshot(const std::vector<uint8_t>& data) {
+        ParsedSnapshot snapshot;
+        if (!ParseSnapshot(data, snapshot)) {
+            LOG_ERROR("Invalid snapshot");
+            return false;
+        }
+        const bool delta = (snapshot.header.flags & SNAPSHOT_DELTA) != 0;
+        if (delta && (m_SnapshotBaseHash == 0 || snapshot.header.baseHash != m_SnapshotBaseHash)) {
+            LOG_ERROR("Snapshot delta does not apply to the current world (base snapshot not loaded)");
+            return false;
+        }
+
+        // ComponentType dans le snapshot -> ComponentType courant
+        std::array<int, MAX_COMPONENTS> remap;
+        remap.fill(-1);
+        for (SnapshotRecord& record : snapshot.records) {
+            ComponentType type = 0;
+            IComponentArray* array = m_ComponentManager->FindComponentArray(record.name, type);
+            if (!array) {
+                LOG_WARNING("Snapshot: component " << record.name << " is not registered, skipped");
+                continue;
+            }
+            if (record.elementSize != array->ElementSize() || record.type >= MAX_COMPONENTS) {
+                LOG_ERROR("Snapshot: component " << record.name << " has a different layout");
+                return false;
+            }
+            if (!array->ReadSnapshot(record.payload, delta)) {
+                LOG_ERROR("Snapshot: corrupted data for component " << record.name);
+                return false;
+            }
+            remap[record.type] = type;
+        }
+
+        std::vector<Entity> entities(snapshot.entityCount);
+        std::vector<Signature> signatures(snapshot.entityCount);
+        std::bitset<MAX_ENTITIES> seen;
+        for (uint32_t i = 0; i < snapshot.entityCount; ++i) {
+            uint32_t bits = 0;
+            std::memcpy(&entities[i], snapshot.entities + i * sizeof(Entity), sizeof(Entity));
+            std::memcpy(&bits, snapshot.signatures + i * sizeof(uint32_t), sizeof(uint32_t));
+            if (entities[i] >= MAX_ENTITIES || seen.test(entities[i])) {
+                LOG_ERROR("Snapshot: invalid entity table");
+                return false;
+            }
+            seen.set(entities[i]);
+            for (ComponentType type = 0; type < MAX_COMPONENTS; ++type) {
+                if ((bits >> type) & 1u && remap[type] >= 0) {
+                    signatures[i].set(static_cast<size_t>(remap[type]));
+                }
+            }
+        }
+
+        std::vector<Entity> previous;
+        for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+            if (m_EntityManager->IsAlive(entity) && !seen.test(entity)) {
+                previous.push_back(entity);
+            }
+        }
+        m_EntityManager->Restore(entities, signatures);
+        m_ComponentManager->ForEachComponentArray([this](const char*, ComponentType type, IComponentArray& array) {
+            array.Retain(*m_EntityManager, type);
+        });
+        for (Entity entity : previous) {
+            m_SystemManager->EntityDestroyed(entity);
+        }
+        for (size_t i = 0; i < entities.size(); ++i) {
+            m_SystemManager->EntitySignatureChanged(entities[i], signatures[i]);
+        }
+
+        // Un delta ne peut s'appliquer que sur l'état exact de sa référence
+        std::fill(m_SignatureTicks.begin(), m_SignatureTicks.end(), m_ComponentManager->GetChangeTick());
+        m_SnapshotBaseHash = delta ? 0 : HashBytes(data.data(), data.size());
+        return true;
+    }
+
 private:
+    struct SnapshotRecord {
+        std::string name;
+        ComponentType type = 0;
+        uint32_t elementSize = 0;
+        SnapshotReader payload;
+    };
+
+    struct ParsedSnapshot {
+        SnapshotHeader header;
+        uint32_t entityCount = 0;
+        const uint8_t* entities = nullptr;
+        const uint8_t* signatures = nullptr;
+        std::vector<SnapshotRecord> records;
+    };
+
+    static bool ParseSnapshot(const std::vector<uint8_t>& data, ParsedSnapshot& snapshot) {
+        const SnapshotHeader expected;
+        SnapshotReader reader(data.data(), data.size());
+        if (!reader.Read(snapshot.header) ||
+            std::memcmp(snapshot.header.magic, expected.magic, sizeof(expected.magic)) != 0 ||
+            snapshot.header.version != expected.version) {
+            return false;
+        }
+        if (!reader.Read(snapshot.entityCount) || snapshot.entityCount > MAX_ENTITIES ||
+            !reader.Take(snapshot.entityCount * sizeof(Entity), snapshot.entities) ||
+            !reader.Take(snapshot.entityCount * sizeof(uint32_t), snapshot.signatures)) {
+            return false;
+        }
+
+        // Chaque tableau : nom, type, taille d'un component, taille des données
+        snapshot.records.resize(snapshot.header.componentTypeCount);
+        for (SnapshotRecord& record : snapshot.records) {
+            uint64_t size = 0;
+            const uint8_t* payload = nullptr;
+            if (!reader.ReadString(record.name) || !reader.Read(record.type) || !reader.Read(record.elementSize) ||
+                !reader.Read(size) || size > reader.Remaining() || !reader.Take(static_cast<size_t>(size), payload)) {
+                return false;
+            }
+            record.payload = SnapshotReader(payload, static_cast<size_t>(size));
+        }
+        return true;
+    }
+
+    bool WriteSnapshot(std::vector<uint8_t>& out, const std::vector<uint8_t>* base) const {
+        SnapshotHeader header;
+        ParsedSnapshot baseSnapshot;
+        if (base) {
+            if (!ParseSnapshot(*base, baseSnapshot) || (baseSnapshot.header.flags & SNAPSHOT_DELTA) != 0) {
+                LOG_ERROR("Snapshot delta: the base is not a valid full snapshot");
+                return false;
+            }
+            header.flags = SNAPSHOT_DELTA;
+            header.baseHash = HashBytes(base->data(), base->size());
+        }
+
+        out.clear();
+        bool serializable = true;
+        m_ComponentManager->ForEachComponentArray([&](const char* name, ComponentType, const IComponentArray& array) {
+            if (!array.IsSerializable()) {
+                LOG_ERROR("Snapshot: component " << name << " has no SnapshotCodec");
+                serializable = false;
+            }
+        });
+        if (!serializable) {
+            return false;
+        }
+
+        SnapshotWriter writer(out);
+        writer.Reserve(sizeof(SnapshotHeader));
+
+        std::vector<Entity> entities;
+        std::vector<uint32_t> signatures;
+        entities.reserve(m_EntityManager->GetLivingEntityCount());
+        signatures.reserve(m_EntityManager->GetLivingEntityCount());
+        for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+            if (m_EntityManager->IsAlive(entity)) {
+                entities.push_back(entity);
+                signatures.push_back(static_cast<uint32_t>(m_EntityManager->GetSignature(entity).to_ulong()));
+            }
+        }
+        writer.Write(static_cast<uint32_t>(entities.size()));
+        writer.WriteBytes(entities.data(), entities.size() * sizeof(Entity));
+        writer.WriteBytes(signatures.data(), signatures.size() * sizeof(uint32_t));
+
+        const SnapshotReader noBase;
+        m_ComponentManager->ForEachComponentArray([&](const char* name, ComponentType type, const IComponentArray& array) {
+            writer.WriteString(name);
+            writer.Write(type);
+            writer.Write(array.ElementSize());
+            const size_t sizeOffset = writer.Reserve(sizeof(uint64_t));
+            const size_t start = writer.Size();
+
+            const SnapshotReader* baseRecord = nullptr;
+            if (base) {
+                baseRecord = &noBase;
+                for (const SnapshotRecord& record : baseSnapshot.records) {
+                    if (record.name == name && record.elementSize == array.ElementSize()) {
+                        baseRecord = &record.payload;
+                    }
+                }
+            }
+            array.WriteSnapshot(writer, baseRecord);
+            writer.Patch(sizeOffset, static_cast<uint64_t>(writer.Size() - start));
+            ++header.componentTypeCount;
+        });
+        writer.Patch(0, header);
+        return true;
+    }
+
     std::unique_ptr<EntityManager> m_EntityManager;
     std::unique_ptr<ComponentManager> m_ComponentManager;
     std::unique_ptr<SystemManager> m_SystemManager;
+    std::vector<ChangeTick> m_SignatureTicks;   // Entité -> dernier changement de signature
+    uint64_t m_SnapshotBaseHash = 0;   // Dernier snapshot complet chargé (référence des deltas)
 };
\ No newline at end of file
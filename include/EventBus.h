@@ -0,0 +1,231 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// ============================================
+// EventSpan - Lot d'événements d'un type, contigus en mémoire
+// ============================================
+template<typename T>
+struct EventSpan {
+    const T* data = nullptr;
+    size_t count = 0;
+
+    const T* begin() const { return data; }
+    const T* end() const { return data + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](size_t index) const { return data[index]; }
+};
+
+// ============================================
+// EventQueue - File d'événements d'un type, à double tampon
+// ============================================
+// Publish peut être appelé depuis n'importe quel thread : une réservation
+// atomique de place dans un tableau préalloué, puis une copie. Flip (un seul
+// thread, point fixe de la frame) fait des événements publiés depuis le
+// Flip précédent le lot lisible par Read, jusqu'au Flip suivant ; ce qui est
+// publié pendant la lecture va dans le lot d'après. Tableau plein : le
+// surplus passe par une liste sous verrou, recollée au Flip, et la capacité
+// double pour les lots suivants. Les événements sont des données simples
+// (trivialement copiables), jamais détruits un par un.
+template<typename T>
+class EventQueue {
+    static_assert(std::is_trivially_copyable_v<T>, "Events must be trivially copyable");
+    static_assert(std::is_default_constructible_v<T>, "Events must be default constructible");
+
+public:
+    explicit EventQueue(size_t capacity = 1024) : m_Capacity(std::max<size_t>(capacity, 1)) {
+        m_Buffers[0].events.resize(m_Capacity);
+        m_Buffers[1].events.resize(m_Capacity);
+        m_Active.store(&m_Buffers[0]);
+    }
+
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    void Publish(const T& event) {
+        PublishBatch(&event, 1);
+    }
+
+    // Une seule réservation pour tout le lot (émission depuis un job)
+    void PublishBatch(const T* events, size_t count) {
+        Buffer& buffer = AcquireActive();
+        const size_t first = buffer.reserved.fetch_add(count, std::memory_order_relaxed);
+        const size_t capacity = buffer.events.size();
+        const size_t direct = first < capacity ? std::min(count, capacity - first) : 0;
+        if (direct > 0) {
+            std::copy(events, events + direct, buffer.events.data() + first);
+        }
+        if (direct < count) {
+            std::lock_guard<std::mutex> lock(buffer.overflowMutex);
+            buffer.overflow.insert(buffer.overflow.end(), events + direct, events + count);
+        }
+        buffer.writers.fetch_sub(1, std::memory_order_release);
+    }
+
+    // Point de synchronisation : le lot publié devient lisible, l'ancien est oublié
+    void Flip() {
+        Buffer* published = m_Active.load();
+        Buffer* next = published == &m_Buffers[0] ? &m_Buffers[1] : &m_Buffers[0];
+        next->reserved.store(0, std::memory_order_relaxed);
+        next->events.resize(m_Capacity);
+        m_Active.store(next);
+
+        // Attendre les seules publications commencées sur l'ancien tampon ;
+        // celles du nouveau continuent pendant ce temps
+        while (published->writers.load() != 0) {
+            std::this_thread::yield();
+        }
+
+        const size_t reserved = published->reserved.load(std::memory_order_relaxed);
+        if (!published->overflow.empty()) {
+            // Recoller le surplus derrière le tableau ; lots suivants plus grands
+            published->events.insert(published->events.end(), published->overflow.begin(), published->overflow.end());
+            published->overflow.clear();
+            m_Capacity = std::max(m_Capacity * 2, reserved);
+            ++m_OverflowCount;
+        }
+        m_Read = published;
+        m_ReadCount = reserved;
+    }
+
+    // Lot courant (publié avant le dernier Flip), valable jusqu'au Flip suivant
+    EventSpan<T> Read() const {
+        return m_Read ? EventSpan<T>{m_Read->events.data(), m_ReadCount} : EventSpan<T>{};
+    }
+
+    size_t Capacity() const { return m_Capacity; }
+    size_t OverflowCount() const { return m_OverflowCount; }   // Flips où le tableau a débordé
+
+private:
+    struct Buffer {
+        std::vector<T> events;
+        std::atomic<size_t> reserved{0};
+        std::vector<T> overflow;
+        std::mutex overflowMutex;
+        std::atomic<uint32_t> writers{0};   // Publications en cours dans ce tampon
+    };
+
+    // Tampon actif, compté comme en cours d'écriture. Compter puis revérifier
+    // (ordre séquentiel) : soit Flip voit le compteur et attend, soit le
+    // producteur voit le nouveau tampon et recommence.
+    Buffer& AcquireActive() {
+        for (;;) {
+            Buffer* buffer = m_Active.load();
+            buffer->writers.fetch_add(1);
+            if (m_Active.load() == buffer) {
+                return *buffer;
+            }
+            buffer->writers.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    Buffer m_Buffers[2];
+    std::atomic<Buffer*> m_Active{nullptr};
+    const Buffer* m_Read = nullptr;
+    size_t m_ReadCount = 0;
+    size_t m_Capacity;
+    size_t m_OverflowCount = 0;
+};
+
+// Index stable d'un type d'événement, partagé par tous les bus
+inline size_t NextEventTypeIndex() {
+    static std::atomic<size_t> next{0};
+    return next++;
+}
+
+template<typename T>
+size_t EventTypeIndex() {
+    static const size_t index = NextEventTypeIndex();
+    return index;
+}
+
+// ============================================
+// EventBus - Événements typés entre systèmes
+// ============================================
+// Une EventQueue par type d'événement, enregistrée d'avance (Register, au
+// chargement, comme les components). Les producteurs publient depuis
+// n'importe quel thread ; les consommateurs lisent le lot avec Read<T>()
+// et le parcourent directement : ni allocation ni appel virtuel par
+// événement. Flip, appelé par le moteur au début de chaque frame, rend
+// lisibles les événements publiés pendant la frame précédente ; un job
+// encore en cours à ce moment peut continuer à publier, ses événements
+// iront au lot suivant.
+class EventBus {
+public:
+    EventBus() = default;
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    ~EventBus() {
+        for (Slot& slot : m_Queues) {
+            if (slot.queue) {
+                slot.destroy(slot.queue);
+            }
+        }
+    }
+
+    template<typename T>
+    void Register(size_t capacity = 1024) {
+        const size_t index = EventTypeIndex<T>();
+        if (index >= m_Queues.size()) {
+            m_Queues.resize(index + 1);
+        }
+        if (m_Queues[index].queue) {
+            throw std::runtime_error("Registering event type more than once.");
+        }
+        m_Queues[index].queue = new EventQueue<T>(capacity);
+        m_Queues[index].flip = [](void* queue) { static_cast<EventQueue<T>*>(queue)->Flip(); };
+        m_Queues[index].destroy = [](void* queue) { delete static_cast<EventQueue<T>*>(queue); };
+    }
+
+    template<typename T>
+    bool IsRegistered() const {
+        const size_t index = EventTypeIndex<T>();
+        return index < m_Queues.size() && m_Queues[index].queue;
+    }
+
+    template<typename T>
+    EventQueue<T>& Queue() {
+        const size_t index = EventTypeIndex<T>();
+        if (index >= m_Queues.size() || !m_Queues[index].queue) {
+            throw std::runtime_error("Event type not registered before use.");
+        }
+        return *static_cast<EventQueue<T>*>(m_Queues[index].queue);
+    }
+
+    template<typename T>
+    void Publish(const T& event) {
+        Queue<T>().Publish(event);
+    }
+
+    template<typename T>
+    EventSpan<T> Read() {
+        return Queue<T>().Read();
+    }
+
+    // Point de la frame où les lots changent (voir EventQueue::Flip)
+    void Flip() {
+        for (Slot& slot : m_Queues) {
+            if (slot.queue) {
+                slot.flip(slot.queue);
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        void* queue = nullptr;
+        void (*flip)(void*) = nullptr;
+        void (*destroy)(void*) = nullptr;
+    };
+
+    std::vector<Slot> m_Queues;   // Indexé par EventTypeIndex<T>()
+};
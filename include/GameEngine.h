@@ -1,9 +1,20 @@
 #pragma once
+#include <algorithm>
 #include <chrono>
-#include <iostream>
+#include <string>
 #include <thread>
+#include "AssetLoader.h"
 #include "ECS.h"
+#include "EventBus.h"
+#include "Input.h"
+#include "Log.h"
+#include "Memory.h"
+#include "Metrics.h"
+#include "Profiler.h"
 #include "Renderer.h"
+#include "Replay.h"
+#include "ResourceManager.h"
+#include "ThreadPool.h"
 
 // ============================================
 // GameEngine - Gère la boucle principale du jeu
@@ -18,12 +29,15 @@ public:
 
     // Initialisation du moteur (à override dans les classes dérivées)
     virtual void Init() {
-        std::cout << "GameEngine initialized!" << std::endl;
+        LOG_INFO("GameEngine initialized!");
         
-        // Initialiser le renderer
-        if (!m_Renderer.Init()) {
+        // Initialiser le renderer (fenêtre cachée et sans vsync pendant un replay)
+        if (!m_Renderer.Init(!m_Replay.IsOpen())) {
             throw std::runtime_error("Failed to initialize renderer");
         }
+        if (m_Replay.IsOpen()) {
+            m_Renderer.SetVSync(false);
+        }
     }
 
     // Méthode principale pour lancer le jeu
@@ -34,7 +48,15 @@ public:
         auto lastTime = std::chrono::high_resolution_clock::now();
         const double targetFrameTime = 1.0 / m_TargetFPS;
         
-        std::cout << "Game loop started (Target FPS: " << m_TargetFPS << ")" << std::endl;
+        LOG_INFO("Game loop started (Target FPS: " << m_TargetFPS << ")");
+        PROFILE_THREAD("Main");
+
+        // Enregistrement et replay partent du même état : tous les assets chargés
+        if (m_Replay.IsOpen() || m_Recorder.IsOpen()) {
+            WaitForAssets();
+            lastTime = std::chrono::high_resolution_clock::now();
+        }
+        const auto startTime = lastTime;
 
         // Boucle de jeu principale
         while (m_IsRunning && !m_Renderer.ShouldClose()) {
@@ -44,37 +66,104 @@ public:
             double deltaTime = elapsed.count();
             lastTime = currentTime;
 
-            // Gérer les événements (clavier, souris, fenêtre)
-            m_Renderer.PollEvents();
-
-            // Mettre à jour le jeu
-            ProcessInput(deltaTime);
-            Update(deltaTime);
-            
-            // Rendu
-            m_Renderer.Clear(0.1f, 0.1f, 0.15f);
-            Render();
-            m_Renderer.SwapBuffers();
-
-            // Limiter le framerate (optionnel)
-            if (deltaTime < targetFrameTime) {
-                std::chrono::duration<double> sleepDuration(targetFrameTime - deltaTime);
-                std::this_thread::sleep_for(sleepDuration);
+            {
+                PROFILE_SCOPE("Frame");
+                m_FrameArena.Reset();
+
+                // Les événements publiés pendant la frame précédente deviennent lisibles
+                m_Events.Flip();
+
+                // Gérer les événements (clavier, souris, fenêtre), ou rejouer la frame enregistrée
+                {
+                    PROFILE_SCOPE("PollEvents");
+                    MetricsTimer timer(PHASE_EVENTS);
+                    m_Renderer.PollEvents();
+                    if (m_Replay.IsOpen()) {
+                        if (!m_Replay.Next(deltaTime, m_Input)) {
+                            break;
+                        }
+                    } else {
+                        m_Input.Capture(m_Renderer.GetWindow());
+                        if (m_Recorder.IsOpen()) {
+                            m_Recorder.Write(deltaTime, m_Input);
+                        }
+                    }
+                }
+
+                // Envoyer au GPU les assets chargés en arrière-plan (budget limité par frame)
+                {
+                    PROFILE_SCOPE("Uploads");
+                    MetricsTimer timer(PHASE_UPLOADS);
+                    m_AssetLoader.ProcessUploads(m_UploadBudget);
+                    m_Resources.Update(&m_FrameArena);
+                }
+
+                // Mettre à jour le jeu
+                {
+                    PROFILE_SCOPE("Input");
+                    MetricsTimer timer(PHASE_INPUT);
+                    ProcessInput(deltaTime);
+                }
+                {
+                    PROFILE_SCOPE("Update");
+                    MetricsTimer timer(PHASE_UPDATE);
+                    Update(deltaTime);
+                }
+
+                // Rendu
+                {
+                    PROFILE_SCOPE("Render");
+                    MetricsTimer timer(PHASE_RENDER);
+                    m_Renderer.Clear(0.1f, 0.1f, 0.15f);
+                    Render();
+                }
+                {
+                    PROFILE_SCOPE("SwapBuffers");
+                    MetricsTimer timer(PHASE_SWAP);
+                    m_Renderer.SwapBuffers();
+                }
+
+                // Limiter le framerate (optionnel ; un replay va au plus vite)
+                if (!m_Replay.IsOpen() && deltaTime < targetFrameTime) {
+                    PROFILE_SCOPE("Sleep");
+                    std::chrono::duration<double> sleepDuration(targetFrameTime - deltaTime);
+                    std::this_thread::sleep_for(sleepDuration);
+                }
             }
+#ifdef GAMEENGINE_PROFILING
+            Profiler::Get().EndFrame();
+#endif
+
+            // Clore la frame dans le registre de mesures (attente comprise)
+            Metrics& metrics = Metrics::Get();
+            metrics.Set(METRIC_ENTITIES, m_Coordinator.GetEntityCount());
+            metrics.Set(METRIC_COMPONENTS, m_Coordinator.GetComponentCount());
+            metrics.Set(METRIC_FRAME_ARENA_BYTES, m_FrameArena.Used());
+            const std::chrono::duration<double, std::milli> frameTime =
+                std::chrono::high_resolution_clock::now() - currentTime;
+            metrics.EndFrame(frameTime.count());
 
             // Afficher les FPS toutes les secondes
-            static double fpsTimer = 0.0;
-            static int frameCount = 0;
-            fpsTimer += deltaTime;
-            frameCount++;
-
-            if (fpsTimer >= 1.0) {
-                std::cout << "FPS: " << frameCount << std::endl;
-                fpsTimer = 0.0;
-                frameCount = 0;
+            m_ReportTimer += deltaTime;
+            if (m_ReportTimer >= 1.0) {
+                const FrameSample& last = metrics.GetLastFrame();
+                LOG_INFO("FPS: " << metrics.FrameCount() - m_ReportFrame << " (p99 "
+                      << metrics.GetFrameTimes().Percentile(99.0) << " ms, "
+                      << last.counters[METRIC_DRAW_CALLS] << " draw calls, "
+                      << last.counters[METRIC_TRIANGLES] << " triangles, "
+                      << last.counters[METRIC_ALLOCATIONS] << " allocations)");
+                m_ReportTimer = 0.0;
+                m_ReportFrame = metrics.FrameCount();
             }
         }
 
+        if (m_Replay.IsOpen()) {
+            const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - startTime;
+            LOG_INFO("Replay finished: " << m_Replay.FrameCount() << " frames in " << elapsed.count() << " s ("
+                     << elapsed.count() * 1000.0 / std::max<uint64_t>(m_Replay.FrameCount(), 1) << " ms/frame)");
+        }
+        m_Recorder.Close();
+        WriteMetrics();
         Cleanup();
     }
 
@@ -92,18 +181,108 @@ public:
         return m_Renderer;
     }
 
+    // Événements entre systèmes : Register au chargement, Publish depuis
+    // n'importe quel thread, Read pendant la frame suivante
+    EventBus& GetEvents() {
+        return m_Events;
+    }
+
+    // Accès au chargeur d'assets asynchrone
+    AssetLoader& GetAssetLoader() {
+        return m_AssetLoader;
+    }
+
+    // Threads des tâches courtes de la frame (ParallelFor des systèmes) ; séparés du
+    // pool du chargeur pour ne jamais attendre derrière une cuisson ou un BVH
+    ThreadPool& GetFrameJobs() {
+        return m_FrameJobs;
+    }
+
+    // Accès aux meshes, shaders et matériaux partagés
+    ResourceManager& GetResources() {
+        return m_Resources;
+    }
+
+    // Octets envoyés au GPU au plus par frame pour les assets asynchrones (0 = illimité)
+    void SetUploadBudget(size_t bytesPerFrame) {
+        m_UploadBudget = bytesPerFrame;
+    }
+
+    // Enregistre l'entrée et le pas de temps de chaque frame de Run (voir Replay.h)
+    bool StartRecording(const std::string& path) {
+        return m_Recorder.Open(path);
+    }
+
+    // Rejoue un enregistrement : Run lit l'entrée et le deltaTime du fichier, sans
+    // attente entre les frames, et s'arrête à sa fin. À appeler avant Init
+    // (fenêtre cachée, vsync coupée).
+    bool StartReplay(const std::string& path) {
+        return m_Replay.Open(path);
+    }
+
+    bool IsReplaying() const { return m_Replay.IsOpen(); }
+
+    // Fichiers écrits à la fin de Run : historique par frame (CSV) et bilan (JSON) ; vide = pas d'écriture
+    void SetMetricsOutput(const std::string& csvPath, const std::string& jsonPath) {
+        m_MetricsCSV = csvPath;
+        m_MetricsJSON = jsonPath;
+    }
+
 protected:
+    // Entrée de la frame en cours (à lire plutôt que glfwGetKey, pour les replays)
+    const InputState& GetInput() const {
+        return m_Input;
+    }
+
+    // Mémoire temporaire de la frame en cours, libérée au début de la suivante
+    FrameArena& GetFrameArena() {
+        return m_FrameArena;
+    }
+
     // Méthodes à override dans les classes dérivées
     virtual void ProcessInput(double deltaTime) { (void)deltaTime; }
     virtual void Update(double deltaTime) { (void)deltaTime; }
     virtual void Render() {}
     virtual void Cleanup() {
-        std::cout << "GameEngine cleanup" << std::endl;
+        LOG_INFO("GameEngine cleanup");
+        m_Resources.Clear();
         m_Renderer.Cleanup();
     }
 
+    // Attend la fin des chargements asynchrones et leur envoi au GPU
+    void WaitForAssets() {
+        while (!m_AssetLoader.IsIdle()) {
+            m_AssetLoader.ProcessUploads(0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        m_Resources.Update();
+    }
+
+    void WriteMetrics() {
+        const Metrics& metrics = Metrics::Get();
+        if (!m_MetricsCSV.empty() && metrics.WriteCSV(m_MetricsCSV)) {
+            LOG_INFO("Metrics written: " << m_MetricsCSV);
+        }
+        if (!m_MetricsJSON.empty() && metrics.WriteJSON(m_MetricsJSON)) {
+            LOG_INFO("Metrics written: " << m_MetricsJSON);
+        }
+    }
+
     Coordinator m_Coordinator;
     Renderer m_Renderer;
+    AssetLoader m_AssetLoader;
+    ThreadPool m_FrameJobs;
+    ResourceManager m_Resources{m_AssetLoader};
+    size_t m_UploadBudget = DEFAULT_UPLOAD_BUDGET;
+    InputState m_Input;
+    ReplayWriter m_Recorder;
+    ReplayReader m_Replay;
+    FrameArena m_FrameArena;
+    EventBus m_Events;
+    std::string m_MetricsCSV;
+    std::string m_MetricsJSON;
+    double m_ReportTimer = 0.0;
+    uint64_t m_ReportFrame = 0;
     bool m_IsRunning;
     int m_TargetFPS;
 };
\ No newline at end of file
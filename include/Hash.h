@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// ============================================
+// Hash - Empreinte 64 bits non cryptographique
+// ============================================
+// Variante de FNV-1a traitant 8 octets par étape, suivie d'un brassage final
+// (fmix64 de MurmurHash3). Suffisant pour détecter le changement d'un
+// fichier source ou d'un shader, pas pour de la sécurité.
+inline uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ull) {
+    const uint64_t prime = 0x100000001b3ull;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t h = seed ^ (static_cast<uint64_t>(size) * prime);
+
+    while (size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        h = (h ^ word) * prime;
+        h ^= h >> 32;
+        p += 8;
+        size -= 8;
+    }
+    while (size > 0) {
+        h = (h ^ *p++) * prime;
+        --size;
+    }
+
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+inline uint64_t HashString(const std::string& text, uint64_t seed = 0xcbf29ce484222325ull) {
+    return HashBytes(text.data(), text.size(), seed);
+}
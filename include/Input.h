@@ -0,0 +1,50 @@
+#pragma once
+#include <bitset>
+#include <cstdint>
+#include <GLFW/glfw3.h>
+
+const int INPUT_KEY_COUNT = GLFW_KEY_LAST + 1;
+const int INPUT_MOUSE_BUTTON_COUNT = GLFW_MOUSE_BUTTON_LAST + 1;
+
+// ============================================
+// InputState - Clavier et souris d'une frame
+// ============================================
+// Relevé une fois par frame par le moteur (ou relu depuis un replay, voir
+// Replay.h) : le jeu lit cet état plutôt que GLFW, pour qu'une session
+// enregistrée se rejoue à l'identique.
+struct InputState {
+    std::bitset<INPUT_KEY_COUNT> keys;
+    uint8_t mouseButtons = 0;
+    double cursorX = 0.0;
+    double cursorY = 0.0;
+
+    bool IsKeyDown(int key) const {
+        return key >= 0 && key < INPUT_KEY_COUNT && keys.test(static_cast<size_t>(key));
+    }
+
+    bool IsMouseButtonDown(int button) const {
+        return button >= 0 && button < INPUT_MOUSE_BUTTON_COUNT && (mouseButtons & (1u << button)) != 0;
+    }
+
+    // Lit l'état courant de la fenêtre (après glfwPollEvents)
+    void Capture(GLFWwindow* window) {
+        // Codes de touche GLFW valides : glfwGetKey signale une erreur pour les autres
+        static const int ranges[][2] = {{32, 32}, {39, 39}, {44, 57}, {59, 59}, {61, 61}, {65, 93}, {96, 96},
+                                        {161, 162}, {256, 269}, {280, 284}, {290, 314}, {320, 336}, {340, 348}};
+        keys.reset();
+        for (const auto& range : ranges) {
+            for (int key = range[0]; key <= range[1]; ++key) {
+                if (glfwGetKey(window, key) == GLFW_PRESS) {
+                    keys.set(static_cast<size_t>(key));
+                }
+            }
+        }
+        mouseButtons = 0;
+        for (int button = 0; button < INPUT_MOUSE_BUTTON_COUNT; ++button) {
+            if (glfwGetMouseButton(window, button) == GLFW_PRESS) {
+                mouseButtons |= static_cast<uint8_t>(1u << button);
+            }
+        }
+        glfwGetCursorPos(window, &cursorX, &cursorY);
+    }
+};
@@ -3,22 +3,95 @@
 // ============================================
 // Vertex Shader avec support des normales
 // ============================================
+// Variantes (voir ShaderVariants), activées par des #define insérés après #version :
+// - QUANTIZED_VERTICES : décode les formats quantifiés (voir VertexLayout) ; la
+//   position est ramenée de [0, 1] vers l'espace objet, la normale
+//   octaédrique est dépliée si octNormals est vrai
+// - CPU_NORMAL_MATRIX : normalMatrix est fourni par le CPU au lieu d'inverser
+//   la matrice model pour chaque vertex
+// - MORPH_TARGETS : ajoute les déplacements pondérés des morph targets actifs,
+//   lus par gl_VertexID dans un texture buffer (voir DeformedMesh)
+// - SKINNING : articulations (location 10) et poids (11) par vertex, mélange
+//   de matrices skinMatrices en espace objet, après les morph targets
+// Sans aucun define, le shader se comporte comme la version d'origine.
 const char* lightingVertexShader = R"(
 #version 330 core
 layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
+layout (location = 1) in vec4 aNormal;
+
+uniform mat4 model;
+#ifdef CPU_NORMAL_MATRIX
+uniform mat3 normalMatrix;
+#endif
 
 out vec3 FragPos;
 out vec3 Normal;
 
-uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
+#ifdef MORPH_TARGETS
+uniform samplerBuffer morphDeltas;          // (position, 0), (normale, 0) par vertex, target après target
+uniform int morphVertexCount;
+uniform int morphCount;
+uniform int morphTargets[MAX_MORPH_TARGETS];
+uniform float morphWeights[MAX_MORPH_TARGETS];
+#endif
+
+#ifdef SKINNING
+layout (location = 10) in uvec4 aJoints;
+layout (location = 11) in vec4 aWeights;
+uniform mat4 skinMatrices[MAX_SKIN_JOINTS];
+#endif
+
+#ifdef QUANTIZED_VERTICES
+uniform vec3 positionScale = vec3(1.0);
+uniform vec3 positionOffset = vec3(0.0);
+uniform bool octNormals = false;
+
+vec3 OctDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+#endif
+
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+#ifdef QUANTIZED_VERTICES
+    vec3 position = positionOffset + aPos * positionScale;
+    vec3 normal = octNormals ? OctDecode(aNormal.xy) : aNormal.xyz;
+#else
+    vec3 position = aPos;
+    vec3 normal = aNormal.xyz;
+#endif
+
+#ifdef MORPH_TARGETS
+    for (int i = 0; i < morphCount; ++i)
+    {
+        int texel = (morphTargets[i] * morphVertexCount + gl_VertexID) * 2;
+        position += morphWeights[i] * texelFetch(morphDeltas, texel).xyz;
+        normal += morphWeights[i] * texelFetch(morphDeltas, texel + 1).xyz;
+    }
+#endif
+
+#ifdef SKINNING
+    mat4 skin = aWeights.x * skinMatrices[aJoints.x] + aWeights.y * skinMatrices[aJoints.y]
+              + aWeights.z * skinMatrices[aJoints.z] + aWeights.w * skinMatrices[aJoints.w];
+    position = vec3(skin * vec4(position, 1.0));
+    normal = mat3(skin) * normal;
+#endif
+
+#ifdef CPU_NORMAL_MATRIX
+    mat3 normalTransform = normalMatrix;
+#else
+    mat3 normalTransform = mat3(transpose(inverse(model)));
+#endif
+
+    FragPos = vec3(model * vec4(position, 1.0));
+    Normal = normalTransform * normal;
     
     gl_Position = projection * view * vec4(FragPos, 1.0);
 }
@@ -27,38 +100,98 @@ void main()
 // ============================================
 // Fragment Shader avec éclairage Phong
 // ============================================
+// NUM_LIGHTS (1 par défaut) : nombre de lumières ponctuelles, passées dans
+// les tableaux lightPos et lightColor.
+// CLUSTERED_LIGHTING : ajoute les lumières du cluster du fragment (voir
+// LightClusterer), lues dans trois texture buffers.
 const char* lightingFragmentShader = R"(
 #version 330 core
+#ifndef NUM_LIGHTS
+#define NUM_LIGHTS 1
+#endif
+
 out vec4 FragColor;
 
 in vec3 FragPos;
 in vec3 Normal;
 
 uniform vec3 objectColor;
-uniform vec3 lightPos;
+uniform vec3 lightPos[NUM_LIGHTS];
 uniform vec3 viewPos;
-uniform vec3 lightColor;
+uniform vec3 lightColor[NUM_LIGHTS];
+
+#ifdef CLUSTERED_LIGHTING
+uniform usamplerBuffer clusterGrid;          // (début, nombre) par cluster
+uniform usamplerBuffer clusterLightIndices;
+uniform samplerBuffer clusterLights;         // (position, rayon), (couleur, 0)
+uniform mat4 view;
+uniform uvec3 clusterDims;                   // Tuiles x, tuiles y, tranches
+uniform vec2 clusterDepthParams;             // Tranche = log(profondeur) * x + y
+uniform vec2 clusterScreenSize;
+
+vec3 ClusteredLighting(vec3 norm, vec3 viewDir)
+{
+    float depth = -(view * vec4(FragPos, 1.0)).z;
+    float slice = floor(log(max(depth, 1e-4)) * clusterDepthParams.x + clusterDepthParams.y);
+    uvec3 cell = uvec3(clamp(vec3(gl_FragCoord.xy / clusterScreenSize * vec2(clusterDims.xy), slice),
+                             vec3(0.0), vec3(clusterDims) - 1.0));
+    int cluster = int((cell.z * clusterDims.y + cell.y) * clusterDims.x + cell.x);
+    uvec2 range = texelFetch(clusterGrid, cluster).xy;
+
+    vec3 lighting = vec3(0.0);
+    for (uint i = 0u; i < range.y; ++i)
+    {
+        int light = int(texelFetch(clusterLightIndices, int(range.x + i)).x);
+        vec4 positionRadius = texelFetch(clusterLights, light * 2);
+        vec3 color = texelFetch(clusterLights, light * 2 + 1).rgb;
+
+        vec3 toLight = positionRadius.xyz - FragPos;
+        float distanceSquared = dot(toLight, toLight);
+        float window = clamp(1.0 - distanceSquared / (positionRadius.w * positionRadius.w), 0.0, 1.0);
+        if (window <= 0.0)
+            continue;
+        window *= window;
+
+        vec3 lightDir = toLight * inversesqrt(distanceSquared);
+        float diff = max(dot(norm, lightDir), 0.0);
+        float spec = pow(max(dot(viewDir, reflect(-lightDir, norm)), 0.0), 32);
+        lighting += (diff + 0.5 * spec) * color * window;
+    }
+    return lighting;
+}
+#endif
 
 void main()
 {
-    // Ambient
-    float ambientStrength = 0.3;
-    vec3 ambient = ambientStrength * lightColor;
-    
-    // Diffuse
     vec3 norm = normalize(Normal);
-    vec3 lightDir = normalize(lightPos - FragPos);
-    float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * lightColor;
-    
-    // Specular
-    float specularStrength = 0.5;
     vec3 viewDir = normalize(viewPos - FragPos);
-    vec3 reflectDir = reflect(-lightDir, norm);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
-    vec3 specular = specularStrength * spec * lightColor;
+    vec3 lighting = vec3(0.0);
+
+    for (int i = 0; i < NUM_LIGHTS; ++i)
+    {
+        // Ambient
+        float ambientStrength = 0.3;
+        vec3 ambient = ambientStrength * lightColor[i];
+        
+        // Diffuse
+        vec3 lightDir = normalize(lightPos[i] - FragPos);
+        float diff = max(dot(norm, lightDir), 0.0);
+        vec3 diffuse = diff * lightColor[i];
+        
+        // Specular
+        float specularStrength = 0.5;
+        vec3 reflectDir = reflect(-lightDir, norm);
+        float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
+        vec3 specular = specularStrength * spec * lightColor[i];
+
+        lighting += ambient + diffuse + specular;
+    }
+
+#ifdef CLUSTERED_LIGHTING
+    lighting += ClusteredLighting(norm, viewDir);
+#endif
     
-    vec3 result = (ambient + diffuse + specular) * objectColor;
+    vec3 result = lighting * objectColor;
     FragColor = vec4(result, 1.0);
 }
-)";
\ No newline at end of file
+)";
@@ -0,0 +1,289 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+// Niveaux de sévérité ; les valeurs servent aussi à GAMEENGINE_LOG_LEVEL
+enum LogLevel : uint8_t {
+    LOG_LEVEL_TRACE   = 0,
+    LOG_LEVEL_DEBUG   = 1,
+    LOG_LEVEL_INFO    = 2,
+    LOG_LEVEL_WARNING = 3,
+    LOG_LEVEL_ERROR   = 4
+};
+
+// Niveau minimal compilé : les messages en dessous disparaissent du binaire
+// (arguments compris). Par défaut debug, ou info avec NDEBUG.
+#ifndef GAMEENGINE_LOG_LEVEL
+#ifdef NDEBUG
+#define GAMEENGINE_LOG_LEVEL 2
+#else
+#define GAMEENGINE_LOG_LEVEL 1
+#endif
+#endif
+
+const size_t LOG_MESSAGE_SIZE = 512;   // Octets par message, au-delà le texte est tronqué
+
+inline const char* LogLevelName(LogLevel level) {
+    switch (level) {
+        case LOG_LEVEL_TRACE: return "trace";
+        case LOG_LEVEL_DEBUG: return "debug";
+        case LOG_LEVEL_INFO: return "info";
+        case LOG_LEVEL_WARNING: return "warning";
+        default: return "error";
+    }
+}
+
+// ============================================
+// Logger - Journal asynchrone
+// ============================================
+// Les messages sont mis en forme sur le thread appelant dans un tampon fixe,
+// puis déposés dans une file bornée à plusieurs producteurs et un seul
+// consommateur, sans verrou (séquences par case, à la Vyukov). Un thread
+// d'arrière-plan la vide vers stdout (stderr à partir de warning) et fait
+// les flush : le thread de la frame ne bloque jamais et n'écrit jamais sur
+// la console. File pleine : le message est compté comme perdu, pas attendu.
+class Logger {
+public:
+    static constexpr size_t QUEUE_SIZE = 1024;   // Puissance de 2
+
+    static Logger& Get() {
+        static Logger logger;
+        return logger;
+    }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    ~Logger() {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stopping = true;
+        }
+        m_Wake.notify_one();
+        if (m_Thread.joinable()) {
+            m_Thread.join();
+        }
+    }
+
+    // Niveau minimal à l'exécution (au-dessus du niveau compilé)
+    void SetLevel(LogLevel level) { m_Level.store(level, std::memory_order_relaxed); }
+    LogLevel GetLevel() const { return m_Level.load(std::memory_order_relaxed); }
+    bool IsEnabled(LogLevel level) const { return level >= GetLevel(); }
+
+    // Dépose un message ; faux si la file était pleine (message perdu)
+    bool Push(LogLevel level, const char* text, size_t length) {
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_Start).count();
+        size_t position = m_Enqueue.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        for (;;) {
+            slot = &m_Slots[position & (QUEUE_SIZE - 1)];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (m_Enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                m_Dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                position = m_Enqueue.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->level = level;
+        slot->seconds = seconds;
+        slot->length = static_cast<uint32_t>(std::min(length, LOG_MESSAGE_SIZE));
+        std::memcpy(slot->text, text, slot->length);
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Attend que tous les messages déjà déposés soient écrits (sortie, erreur fatale)
+    void Flush() {
+        const size_t target = m_Enqueue.load(std::memory_order_acquire);
+        m_Wake.notify_one();
+        while (m_Written.load(std::memory_order_acquire) < target && m_Thread.joinable()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    uint64_t GetDroppedCount() const { return m_Dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        LogLevel level = LOG_LEVEL_INFO;
+        uint32_t length = 0;
+        double seconds = 0.0;
+        char text[LOG_MESSAGE_SIZE];
+    };
+
+    Logger() : m_Start(std::chrono::steady_clock::now()) {
+        for (size_t i = 0; i < QUEUE_SIZE; ++i) {
+            m_Slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        m_Thread = std::thread([this] { WriterLoop(); });
+    }
+
+    void WriterLoop() {
+        uint64_t reportedDrops = 0;
+        for (;;) {
+            bool stopping = false;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                // Pas de notification à chaque message : réveil périodique
+                m_Wake.wait_for(lock, std::chrono::milliseconds(5));
+                stopping = m_Stopping;
+            }
+
+            bool wrote = false;
+            while (WriteNext()) {
+                wrote = true;
+            }
+            const uint64_t dropped = m_Dropped.load(std::memory_order_relaxed);
+            if (dropped != reportedDrops) {
+                std::fprintf(stderr, "[log] %llu messages dropped (queue full)\n",
+                             static_cast<unsigned long long>(dropped - reportedDrops));
+                reportedDrops = dropped;
+                wrote = true;
+            }
+            if (wrote) {
+                std::fflush(stdout);
+                std::fflush(stderr);
+            }
+            if (stopping) {
+                return;
+            }
+        }
+    }
+
+    // Écrit le message suivant s'il est prêt
+    bool WriteNext() {
+        Slot& slot = m_Slots[m_Dequeue & (QUEUE_SIZE - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != m_Dequeue + 1) {
+            return false;
+        }
+        std::FILE* stream = slot.level >= LOG_LEVEL_WARNING ? stderr : stdout;
+        std::fprintf(stream, "[%9.3f] [%s] %.*s\n", slot.seconds, LogLevelName(slot.level),
+                     static_cast<int>(slot.length), slot.text);
+        slot.sequence.store(m_Dequeue + QUEUE_SIZE, std::memory_order_release);
+        ++m_Dequeue;
+        m_Written.store(m_Dequeue, std::memory_order_release);
+        return true;
+    }
+
+    Slot m_Slots[QUEUE_SIZE];
+    std::atomic<size_t> m_Enqueue{0};
+    size_t m_Dequeue = 0;                      // Thread d'écriture seulement
+    std::atomic<size_t> m_Written{0};
+    std::atomic<uint64_t> m_Dropped{0};
+    std::atomic<LogLevel> m_Level{LOG_LEVEL_TRACE};
+    const std::chrono::steady_clock::time_point m_Start;
+    std::mutex m_Mutex;                        // Réveil du thread d'écriture seulement
+    std::condition_variable m_Wake;
+    bool m_Stopping = false;
+    std::thread m_Thread;
+};
+
+// ============================================
+// LogStream - Mise en forme d'un message, sans allocation
+// ============================================
+// Syntaxe de flux (LOG_INFO("Loaded " << path << " in " << ms << " ms")) ;
+// le texte est écrit dans un tampon de LOG_MESSAGE_SIZE octets sur la pile.
+class LogStream {
+public:
+    explicit LogStream(LogLevel level) : m_Level(level) {}
+
+    LogStream& operator<<(std::string_view text) {
+        Append(text.data(), text.size());
+        return *this;
+    }
+
+    LogStream& operator<<(const char* text) { return *this << std::string_view(text ? text : "(null)"); }
+    LogStream& operator<<(const std::string& text) { return *this << std::string_view(text); }
+    LogStream& operator<<(const unsigned char* text) { return *this << reinterpret_cast<const char*>(text); }
+    LogStream& operator<<(char c) { Append(&c, 1); return *this; }
+    LogStream& operator<<(bool value) { return *this << (value ? '1' : '0'); }
+
+    template<typename T>
+    std::enable_if_t<std::is_integral_v<T>, LogStream&> operator<<(T value) {
+        char digits[24];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        Append(digits, static_cast<size_t>(result.ptr - digits));
+        return *this;
+    }
+
+    // Comme std::ostream par défaut (%g, 6 chiffres significatifs)
+    template<typename T>
+    std::enable_if_t<std::is_floating_point_v<T>, LogStream&> operator<<(T value) {
+        char digits[32];
+        const int length = std::snprintf(digits, sizeof(digits), "%g", static_cast<double>(value));
+        Append(digits, static_cast<size_t>(std::max(length, 0)));
+        return *this;
+    }
+
+    template<typename T>
+    std::enable_if_t<std::is_enum_v<T>, LogStream&> operator<<(T value) {
+        return *this << static_cast<std::underlying_type_t<T>>(value);
+    }
+
+    void Submit() { Logger::Get().Push(m_Level, m_Text, m_Length); }
+
+private:
+    void Append(const char* text, size_t length) {
+        const size_t count = std::min(length, LOG_MESSAGE_SIZE - m_Length);
+        std::memcpy(m_Text + m_Length, text, count);
+        m_Length += count;
+    }
+
+    LogLevel m_Level;
+    size_t m_Length = 0;
+    char m_Text[LOG_MESSAGE_SIZE];
+};
+
+#define GAMEENGINE_LOG(level, message)                  \
+    do {                                                \
+        if (Logger::Get().IsEnabled(level)) {           \
+            LogStream logStream(level);                 \
+            logStream << message;                       \
+            logStream.Submit();                         \
+        }                                               \
+    } while (0)
+
+#if GAMEENGINE_LOG_LEVEL <= 0
+#define LOG_TRACE(message) GAMEENGINE_LOG(LOG_LEVEL_TRACE, message)
+#else
+#define LOG_TRACE(message) ((void)0)
+#endif
+
+#if GAMEENGINE_LOG_LEVEL <= 1
+#define LOG_DEBUG(message) GAMEENGINE_LOG(LOG_LEVEL_DEBUG, message)
+#else
+#define LOG_DEBUG(message) ((void)0)
+#endif
+
+#if GAMEENGINE_LOG_LEVEL <= 2
+#define LOG_INFO(message) GAMEENGINE_LOG(LOG_LEVEL_INFO, message)
+#else
+#define LOG_INFO(message) ((void)0)
+#endif
+
+#if GAMEENGINE_LOG_LEVEL <= 3
+#define LOG_WARNING(message) GAMEENGINE_LOG(LOG_LEVEL_WARNING, message)
+#else
+#define LOG_WARNING(message) ((void)0)
+#endif
+
+#define LOG_ERROR(message) GAMEENGINE_LOG(LOG_LEVEL_ERROR, message)
@@ -0,0 +1,150 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ============================================
+// MappedFile - Fichier projeté en mémoire (lecture seule)
+// ============================================
+// Le contenu est accessible sans copie ; les pages sont chargées par l'OS
+// à la demande. Non copiable, déplaçable.
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::string& filepath) {
+        Open(filepath);
+    }
+
+    ~MappedFile() {
+        Close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            Close();
+            m_Data = other.m_Data;
+            m_Size = other.m_Size;
+            m_IsOpen = other.m_IsOpen;
+#ifdef _WIN32
+            m_File = other.m_File;
+            m_Mapping = other.m_Mapping;
+            other.m_File = INVALID_HANDLE_VALUE;
+            other.m_Mapping = nullptr;
+#endif
+            other.m_Data = nullptr;
+            other.m_Size = 0;
+            other.m_IsOpen = false;
+        }
+        return *this;
+    }
+
+    bool Open(const std::string& filepath) {
+        Close();
+#ifdef _WIN32
+        m_File = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_File == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_File, &size)) {
+            Close();
+            return false;
+        }
+        m_Size = static_cast<size_t>(size.QuadPart);
+        if (m_Size == 0) {
+            // Un fichier vide ne peut pas être projeté, mais il est valide
+            m_IsOpen = true;
+            return true;
+        }
+
+        m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_Mapping) {
+            Close();
+            return false;
+        }
+        m_Data = static_cast<const char*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_Data) {
+            Close();
+            return false;
+        }
+#else
+        int fd = ::open(filepath.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        m_Size = static_cast<size_t>(info.st_size);
+        if (m_Size == 0) {
+            ::close(fd);
+            m_IsOpen = true;
+            return true;
+        }
+
+        void* data = ::mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // La projection reste valide après la fermeture
+        if (data == MAP_FAILED) {
+            m_Size = 0;
+            return false;
+        }
+        ::madvise(data, m_Size, MADV_SEQUENTIAL);
+        m_Data = static_cast<const char*>(data);
+#endif
+        m_IsOpen = true;
+        return true;
+    }
+
+    void Close() {
+#ifdef _WIN32
+        if (m_Data) UnmapViewOfFile(m_Data);
+        if (m_Mapping) CloseHandle(m_Mapping);
+        if (m_File != INVALID_HANDLE_VALUE) CloseHandle(m_File);
+        m_Mapping = nullptr;
+        m_File = INVALID_HANDLE_VALUE;
+#else
+        if (m_Data) ::munmap(const_cast<char*>(m_Data), m_Size);
+#endif
+        m_Data = nullptr;
+        m_Size = 0;
+        m_IsOpen = false;
+    }
+
+    bool IsOpen() const { return m_IsOpen; }
+    const char* Data() const { return m_Data; }
+    size_t Size() const { return m_Size; }
+
+private:
+    const char* m_Data = nullptr;
+    size_t m_Size = 0;
+    bool m_IsOpen = false;
+#ifdef _WIN32
+    HANDLE m_File = INVALID_HANDLE_VALUE;
+    HANDLE m_Mapping = nullptr;
+#endif
+};
\ No newline at end of file
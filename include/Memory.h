@@ -0,0 +1,263 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ============================================
+// FrameArena - Allocation linéaire pour les données d'une frame
+// ============================================
+// Un pointeur avance dans un bloc fixe et Reset (en début de frame) libère
+// tout d'un coup. Rien n'est détruit : n'y placer que des types au
+// destructeur trivial, ou des FrameVector qui ne survivent pas à la frame.
+// Bloc plein : l'allocation passe par le tas (voir OverflowCount) et la
+// capacité est agrandie au Reset suivant. Thread de la frame seulement.
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity = 1 << 20) {
+        Grow(capacity);
+    }
+
+    ~FrameArena() {
+        ReleaseOverflow();
+    }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        const uintptr_t base = reinterpret_cast<uintptr_t>(m_Buffer.get());
+        const uintptr_t aligned = (base + m_Used + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        const size_t offset = static_cast<size_t>(aligned - base);
+        if (offset + size <= m_Capacity) {
+            m_Used = offset + size;
+            return m_Buffer.get() + offset;
+        }
+
+        // Débordement : bloc du tas, libéré au prochain Reset
+        uint8_t* block = static_cast<uint8_t*>(::operator new(size + alignment));
+        m_Overflow.push_back(block);
+        m_OverflowBytes += size + alignment;
+        const uintptr_t address = reinterpret_cast<uintptr_t>(block);
+        return block + (((address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1)) - address);
+    }
+
+    template<typename T>
+    T* AllocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+        return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    template<typename T, typename... Args>
+    T* New(Args&&... args) {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // Début de frame : tout ce qui a été alloué devient invalide
+    void Reset() {
+        m_LastFrameBytes = m_Used + m_OverflowBytes;
+        if (!m_Overflow.empty()) {
+            Grow(std::max(m_Capacity * 2, m_LastFrameBytes));
+            ReleaseOverflow();
+        }
+        m_Used = 0;
+    }
+
+    size_t Used() const { return m_Used + m_OverflowBytes; }
+    size_t Capacity() const { return m_Capacity; }
+    size_t LastFrameBytes() const { return m_LastFrameBytes; }    // Octets utilisés par la frame précédente
+    size_t OverflowCount() const { return m_Overflow.size(); }    // Allocations passées par le tas cette frame
+
+private:
+    void Grow(size_t capacity) {
+        m_Buffer.reset(new uint8_t[capacity]);
+        m_Capacity = capacity;
+    }
+
+    void ReleaseOverflow() {
+        for (uint8_t* block : m_Overflow) {
+            ::operator delete(block);
+        }
+        m_Overflow.clear();
+        m_OverflowBytes = 0;
+    }
+
+    std::unique_ptr<uint8_t[]> m_Buffer;
+    size_t m_Capacity = 0;
+    size_t m_Used = 0;
+    size_t m_LastFrameBytes = 0;
+    std::vector<uint8_t*> m_Overflow;
+    size_t m_OverflowBytes = 0;
+};
+
+// ============================================
+// FrameAllocator - Allocateur STL sur une FrameArena
+// ============================================
+// deallocate ne fait rien : la mémoire revient à l'arène au Reset. Sans
+// arène (nullptr), c'est l'allocateur standard : le même code sert dans les
+// outils et tests qui n'ont pas de boucle de frame.
+template<typename T>
+class FrameAllocator {
+public:
+    using value_type = T;
+
+    FrameAllocator(FrameArena* arena = nullptr) noexcept : m_Arena(arena) {}
+
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept : m_Arena(other.Arena()) {}
+
+    T* allocate(size_t count) {
+        if (m_Arena) {
+            return static_cast<T*>(m_Arena->Allocate(count * sizeof(T), alignof(T)));
+        }
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        if (!m_Arena) {
+            std::allocator<T>().deallocate(pointer, count);
+        }
+    }
+
+    FrameArena* Arena() const { return m_Arena; }
+
+    template<typename U>
+    bool operator==(const FrameAllocator<U>& other) const { return m_Arena == other.Arena(); }
+    template<typename U>
+    bool operator!=(const FrameAllocator<U>& other) const { return m_Arena != other.Arena(); }
+
+private:
+    FrameArena* m_Arena;
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+// ============================================
+// MemoryPool - Blocs de taille fixe
+// ============================================
+// Les blocs sont découpés dans des chunks de blocksPerChunk ; un bloc libéré
+// rejoint une liste libre chaînée dans les blocs eux-mêmes. Les chunks ne
+// sont rendus qu'à la destruction du pool. Pas de verrou.
+class MemoryPool {
+public:
+    explicit MemoryPool(size_t blockSize, size_t blocksPerChunk = 256)
+        : m_BlockSize(RoundSize(blockSize)), m_BlocksPerChunk(blocksPerChunk) {}
+
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    // Taille réelle d'un bloc : de quoi chaîner la liste libre, alignée
+    static size_t RoundSize(size_t size) {
+        const size_t alignment = alignof(std::max_align_t);
+        return (std::max(size, sizeof(void*)) + alignment - 1) & ~(alignment - 1);
+    }
+
+    void* Allocate() {
+        if (!m_FreeList) {
+            AddChunk();
+        }
+        void* block = m_FreeList;
+        std::memcpy(&m_FreeList, block, sizeof(void*));
+        ++m_LiveCount;
+        return block;
+    }
+
+    void Free(void* block) {
+        std::memcpy(block, &m_FreeList, sizeof(void*));
+        m_FreeList = block;
+        --m_LiveCount;
+    }
+
+    size_t BlockSize() const { return m_BlockSize; }
+    size_t LiveCount() const { return m_LiveCount; }
+    size_t ChunkCount() const { return m_Chunks.size(); }
+
+private:
+    void AddChunk() {
+        m_Chunks.emplace_back(new uint8_t[m_BlockSize * m_BlocksPerChunk]);
+        uint8_t* chunk = m_Chunks.back().get();
+        for (size_t i = m_BlocksPerChunk; i-- > 0;) {
+            void* block = chunk + i * m_BlockSize;
+            std::memcpy(block, &m_FreeList, sizeof(void*));
+            m_FreeList = block;
+        }
+    }
+
+    size_t m_BlockSize;
+    size_t m_BlocksPerChunk;
+    void* m_FreeList = nullptr;
+    size_t m_LiveCount = 0;
+    std::vector<std::unique_ptr<uint8_t[]>> m_Chunks;
+};
+
+// Pools d'un conteneur et de ses allocateurs "rebind" (nœuds, en-têtes...),
+// un par taille de bloc
+class MemoryPoolGroup {
+public:
+    MemoryPool& ForSize(size_t size) {
+        const size_t blockSize = MemoryPool::RoundSize(size);
+        for (const std::unique_ptr<MemoryPool>& pool : m_Pools) {
+            if (pool->BlockSize() == blockSize) {
+                return *pool;
+            }
+        }
+        m_Pools.push_back(std::make_unique<MemoryPool>(blockSize));
+        return *m_Pools.back();
+    }
+
+private:
+    std::vector<std::unique_ptr<MemoryPool>> m_Pools;
+};
+
+// ============================================
+// PoolAllocator - Allocateur STL pour conteneurs à nœuds
+// ============================================
+// std::set, std::map, std::list, std::unordered_map : chaque nœud est un
+// bloc de MemoryPool au lieu d'un appel à operator new. Les allocations de
+// plusieurs éléments (tableau de buckets) passent par le tas. Les copies de
+// l'allocateur partagent les mêmes pools ; un conteneur et ses copies
+// restent sur le même thread.
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    PoolAllocator() : m_Pools(std::make_shared<MemoryPoolGroup>()) {}
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : m_Pools(other.Pools()) {}
+
+    T* allocate(size_t count) {
+        if (count == 1 && alignof(T) <= alignof(std::max_align_t)) {
+            return static_cast<T*>(m_Pools->ForSize(sizeof(T)).Allocate());
+        }
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        if (count == 1 && alignof(T) <= alignof(std::max_align_t)) {
+            m_Pools->ForSize(sizeof(T)).Free(pointer);
+        } else {
+            std::allocator<T>().deallocate(pointer, count);
+        }
+    }
+
+    const std::shared_ptr<MemoryPoolGroup>& Pools() const { return m_Pools; }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>& other) const { return m_Pools == other.Pools(); }
+    template<typename U>
+    bool operator!=(const PoolAllocator<U>& other) const { return m_Pools != other.Pools(); }
+
+private:
+    std::shared_ptr<MemoryPoolGroup> m_Pools;
+};
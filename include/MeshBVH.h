@@ -0,0 +1,472 @@
+#pragma once
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Bounds.h"
+#include "MeshCache.h"
+#include "OBJLoader.h"
+#include "SIMD.h"
+
+// Impact d'un rayon sur un triangle du mesh
+struct MeshHit {
+    uint32_t triangle = UINT32_MAX;   // Indice du triangle dans le buffer d'indices source (indices[3t..3t+2])
+    float distance = FLT_MAX;
+    float u = 0.0f, v = 0.0f;         // Point = (1 - u - v) * v0 + u * v1 + v * v2
+    glm::vec3 normal{0.0f};           // Normale géométrique normalisée (ordre v0, v1, v2)
+
+    bool Hit() const { return triangle != UINT32_MAX; }
+    glm::vec3 Barycentrics() const { return glm::vec3(1.0f - u - v, u, v); }
+};
+
+// ============================================
+// MeshBVH - Hiérarchie de boîtes sur les triangles d'un mesh
+// ============================================
+// Construite une fois (SAH par classes), en espace objet, puis interrogée par
+// lancer de rayon. Nœuds de 32 octets (deux par ligne de cache), enfants côte
+// à côte ; les triangles sont recopiés dans l'ordre des feuilles sous la forme
+// (v0, v1 - v0, v2 - v0) pour Möller-Trumbore, sans indirection par les
+// indices pendant la traversée. Les boîtes sont testées en SSE quand il est
+// disponible.
+class MeshBVH {
+public:
+    static constexpr uint32_t MAX_LEAF_SIZE = 4;
+    static constexpr uint32_t SAH_BINS = 16;
+
+    // Positions à stride floats d'écart (x, y, z en tête de chaque vertex)
+    template<typename Index>
+    void Build(const float* positions, size_t vertexCount, size_t stride, const Index* indices, size_t indexCount) {
+        Clear();
+
+        // Triangles valides uniquement (indices dans les bornes)
+        std::vector<BuildItem> items;
+        const size_t triangleCount = indexCount / 3;
+        items.reserve(triangleCount);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            const Index* tri = indices + t * 3;
+            if (tri[0] >= vertexCount || tri[1] >= vertexCount || tri[2] >= vertexCount) {
+                continue;
+            }
+            BuildItem item;
+            for (int k = 0; k < 3; ++k) {
+                item.bounds.Expand(Position(positions, stride, tri[k]));
+            }
+            item.center = item.bounds.Center();
+            item.triangle = static_cast<uint32_t>(t);
+            items.push_back(item);
+        }
+        if (items.empty()) {
+            return;
+        }
+
+        BuildNodes(items);
+
+        // Triangles dans l'ordre des feuilles
+        m_Triangles.resize(items.size());
+        m_TriangleIds.resize(items.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            const uint32_t source = items[i].triangle;
+            const Index* tri = indices + static_cast<size_t>(source) * 3;
+            const glm::vec3 v0 = Position(positions, stride, tri[0]);
+            m_Triangles[i] = Triangle{v0, Position(positions, stride, tri[1]) - v0, Position(positions, stride, tri[2]) - v0};
+            m_TriangleIds[i] = source;
+        }
+    }
+
+    // Depuis les données CPU d'un MeshData (avant qu'elles ne soient libérées)
+    void Build(const MeshData& mesh) {
+        Build(mesh.vertices.data(), mesh.VertexCount(), FLOATS_PER_VERTEX, mesh.indices.data(), mesh.indices.size());
+    }
+
+    // Depuis un niveau d'un mesh cuit : positions décodées (y compris quantifiées),
+    // donc identiques à ce que le GPU dessine
+    void Build(const CookedMesh& cooked, uint32_t level = 0) {
+        Clear();
+        if (!cooked.IsOpen() || level >= cooked.Header().lodCount) {
+            return;
+        }
+        const CookedMeshLOD& lod = cooked.LODs()[level];
+        const VertexLayout& layout = cooked.Header().layout;
+        const char* vertexData = cooked.VertexData(lod);
+
+        std::vector<float> positions(static_cast<size_t>(lod.vertexCount) * 3);
+        for (size_t v = 0; v < lod.vertexCount; ++v) {
+            const glm::vec3 position = layout.DecodePosition(vertexData + v * layout.stride);
+            positions[v * 3 + 0] = position.x;
+            positions[v * 3 + 1] = position.y;
+            positions[v * 3 + 2] = position.z;
+        }
+
+        if (cooked.Header().indexSize == 2) {
+            Build(positions.data(), lod.vertexCount, 3, reinterpret_cast<const uint16_t*>(cooked.IndexData(lod)), lod.indexCount);
+        } else {
+            Build(positions.data(), lod.vertexCount, 3, reinterpret_cast<const uint32_t*>(cooked.IndexData(lod)), lod.indexCount);
+        }
+    }
+
+    void Clear() {
+        m_Nodes.clear();
+        m_Triangles.clear();
+        m_TriangleIds.clear();
+    }
+
+    // ---------- Requêtes ----------
+
+    // Triangle le plus proche touché avant maxDistance
+    MeshHit Raycast(const Ray& ray, float maxDistance = FLT_MAX, bool cullBackFaces = false) const {
+        MeshHit hit;
+        hit.distance = maxDistance;
+        uint32_t best = UINT32_MAX;
+        Traverse(ray, hit.distance, [&](uint32_t i) {
+            float t, u, v;
+            if (IntersectTriangle(ray, m_Triangles[i], hit.distance, cullBackFaces, t, u, v)) {
+                hit.distance = t;
+                hit.u = u;
+                hit.v = v;
+                best = i;
+            }
+            return false;
+        });
+
+        if (best != UINT32_MAX) {
+            hit.triangle = m_TriangleIds[best];
+            const glm::vec3 normal = glm::cross(m_Triangles[best].edge1, m_Triangles[best].edge2);
+            const float length = glm::length(normal);
+            hit.normal = length > 0.0f ? normal / length : glm::vec3(0.0f);
+        }
+        return hit;
+    }
+
+    // Vrai si un triangle coupe le rayon avant maxDistance (arrêt au premier trouvé)
+    bool Occluded(const Ray& ray, float maxDistance = FLT_MAX) const {
+        float distance = maxDistance;
+        bool occluded = false;
+        Traverse(ray, distance, [&](uint32_t i) {
+            float t, u, v;
+            occluded = IntersectTriangle(ray, m_Triangles[i], distance, false, t, u, v);
+            return occluded;
+        });
+        return occluded;
+    }
+
+    // ---------- Statistiques ----------
+
+    bool Empty() const { return m_Nodes.empty(); }
+    size_t NodeCount() const { return m_Nodes.size(); }
+    size_t TriangleCount() const { return m_Triangles.size(); }
+
+    size_t MemoryBytes() const {
+        return m_Nodes.size() * sizeof(Node) + m_Triangles.size() * (sizeof(Triangle) + sizeof(uint32_t));
+    }
+
+    AABB Bounds() const {
+        if (m_Nodes.empty()) {
+            return AABB();
+        }
+        const Node& root = m_Nodes[0];
+        return AABB(glm::vec3(root.min[0], root.min[1], root.min[2]), glm::vec3(root.max[0], root.max[1], root.max[2]));
+    }
+
+private:
+    // Feuille : count > 0, triangles [leftFirst, leftFirst + count).
+    // Nœud interne : count = 0, enfants leftFirst et leftFirst + 1.
+    struct Node {
+        float min[3];
+        uint32_t leftFirst;
+        float max[3];
+        uint32_t count;
+    };
+    static_assert(sizeof(Node) == 32, "MeshBVH::Node must stay 32 bytes");
+
+    struct Triangle {
+        glm::vec3 v0;
+        glm::vec3 edge1;   // v1 - v0
+        glm::vec3 edge2;   // v2 - v0
+    };
+
+    // Triangle pendant la construction ; déplacé avec les partitions pour que
+    // chaque nœud lise une plage contiguë
+    struct BuildItem {
+        AABB bounds;
+        glm::vec3 center;
+        uint32_t triangle;
+    };
+
+    static constexpr uint32_t MAX_SAH_DEPTH = 64;
+    static constexpr uint32_t STACK_SIZE = 128;   // Profondeur SAH + coupes médianes (log2 des triangles)
+    static constexpr float TRAVERSAL_COST = 1.0f;
+    static constexpr float INTERSECTION_COST = 1.0f;
+
+    template<typename Index>
+    static glm::vec3 Position(const float* positions, size_t stride, Index index) {
+        const float* p = positions + static_cast<size_t>(index) * stride;
+        return glm::vec3(p[0], p[1], p[2]);
+    }
+
+    static void SetBounds(Node& node, const AABB& bounds) {
+        for (int i = 0; i < 3; ++i) {
+            node.min[i] = bounds.min[i];
+            node.max[i] = bounds.max[i];
+        }
+    }
+
+    // Pile explicite de (nœud, profondeur) ; items est réordonné dans l'ordre des feuilles
+    void BuildNodes(std::vector<BuildItem>& items) {
+        m_Nodes.reserve(items.size() * 2 / MAX_LEAF_SIZE + 1);
+        m_Nodes.push_back(Node{{0.0f, 0.0f, 0.0f}, 0, {0.0f, 0.0f, 0.0f}, static_cast<uint32_t>(items.size())});
+
+        std::vector<std::pair<uint32_t, uint32_t>> stack{{0, 0}};
+        while (!stack.empty()) {
+            const uint32_t nodeIndex = stack.back().first, depth = stack.back().second;
+            stack.pop_back();
+            const uint32_t first = m_Nodes[nodeIndex].leftFirst, count = m_Nodes[nodeIndex].count;
+
+            AABB bounds, centerBounds;
+            for (uint32_t i = first; i < first + count; ++i) {
+                bounds.Expand(items[i].bounds);
+                centerBounds.Expand(items[i].center);
+            }
+            SetBounds(m_Nodes[nodeIndex], bounds);
+            if (count <= MAX_LEAF_SIZE) {
+                continue;
+            }
+
+            uint32_t middle = first;
+            if (depth >= MAX_SAH_DEPTH) {
+                SplitMedian(items, first, count, centerBounds, middle);
+            } else if (!Split(items, first, count, bounds, centerBounds, middle)) {
+                continue;   // Garder en feuille : aucune séparation rentable
+            }
+
+            const uint32_t left = static_cast<uint32_t>(m_Nodes.size());
+            m_Nodes.push_back(Node{{0.0f, 0.0f, 0.0f}, first, {0.0f, 0.0f, 0.0f}, middle - first});
+            m_Nodes.push_back(Node{{0.0f, 0.0f, 0.0f}, middle, {0.0f, 0.0f, 0.0f}, first + count - middle});
+            m_Nodes[nodeIndex].leftFirst = left;
+            m_Nodes[nodeIndex].count = 0;
+            stack.emplace_back(left + 1, depth + 1);
+            stack.emplace_back(left, depth + 1);
+        }
+        m_Nodes.shrink_to_fit();
+    }
+
+    // Meilleur plan parmi SAH_BINS classes sur chaque axe (centres des triangles) ;
+    // les trois axes sont classés en un seul passage sur les triangles
+    static bool Split(std::vector<BuildItem>& items, uint32_t first, uint32_t count,
+                      const AABB& bounds, const AABB& centerBounds, uint32_t& middle) {
+        struct Bin {
+            AABB bounds;
+            uint32_t count = 0;
+        };
+
+        glm::vec3 scale(0.0f);
+        for (int axis = 0; axis < 3; ++axis) {
+            const float extent = centerBounds.max[axis] - centerBounds.min[axis];
+            scale[axis] = extent > 0.0f ? SAH_BINS / extent : 0.0f;
+        }
+
+        Bin bins[3][SAH_BINS];
+        for (uint32_t i = first; i < first + count; ++i) {
+            const BuildItem& item = items[i];
+            for (int axis = 0; axis < 3; ++axis) {
+                const uint32_t bin = std::min(SAH_BINS - 1,
+                    static_cast<uint32_t>((item.center[axis] - centerBounds.min[axis]) * scale[axis]));
+                bins[axis][bin].bounds.Expand(item.bounds);
+                ++bins[axis][bin].count;
+            }
+        }
+
+        float bestCost = count * INTERSECTION_COST;
+        int bestAxis = -1;
+        uint32_t bestBin = 0;
+        const float parentArea = std::max(bounds.SurfaceArea(), FLT_MIN);
+
+        for (int axis = 0; axis < 3; ++axis) {
+            if (scale[axis] == 0.0f) {
+                continue;
+            }
+
+            // Balayage des plans : aires et effectifs à gauche puis à droite
+            float leftArea[SAH_BINS - 1], rightArea[SAH_BINS - 1];
+            uint32_t leftCount[SAH_BINS - 1], rightCount[SAH_BINS - 1];
+            AABB left, right;
+            uint32_t leftSum = 0, rightSum = 0;
+            for (uint32_t b = 0; b < SAH_BINS - 1; ++b) {
+                left.Expand(bins[axis][b].bounds);
+                leftSum += bins[axis][b].count;
+                leftCount[b] = leftSum;
+                leftArea[b] = leftSum > 0 ? left.SurfaceArea() : 0.0f;
+
+                const uint32_t r = SAH_BINS - 1 - b;
+                right.Expand(bins[axis][r].bounds);
+                rightSum += bins[axis][r].count;
+                rightCount[r - 1] = rightSum;
+                rightArea[r - 1] = rightSum > 0 ? right.SurfaceArea() : 0.0f;
+            }
+            for (uint32_t b = 0; b < SAH_BINS - 1; ++b) {
+                if (leftCount[b] == 0 || rightCount[b] == 0) {
+                    continue;
+                }
+                const float cost = TRAVERSAL_COST +
+                    (leftArea[b] * leftCount[b] + rightArea[b] * rightCount[b]) * INTERSECTION_COST / parentArea;
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = b;
+                }
+            }
+        }
+
+        if (bestAxis < 0) {
+            if (count <= MAX_LEAF_SIZE * 4) {
+                return false;
+            }
+            // Centres confondus ou SAH défavorable : coupe à la médiane pour borner les feuilles
+            SplitMedian(items, first, count, centerBounds, middle);
+            return true;
+        }
+
+        const float minimum = centerBounds.min[bestAxis];
+        const float axisScale = scale[bestAxis];
+        auto split = std::partition(items.begin() + first, items.begin() + first + count, [&](const BuildItem& item) {
+            return std::min(SAH_BINS - 1, static_cast<uint32_t>((item.center[bestAxis] - minimum) * axisScale)) <= bestBin;
+        });
+        middle = static_cast<uint32_t>(split - items.begin());
+        return middle != first && middle != first + count;
+    }
+
+    static void SplitMedian(std::vector<BuildItem>& items, uint32_t first, uint32_t count,
+                            const AABB& centerBounds, uint32_t& middle) {
+        const glm::vec3 size = centerBounds.Size();
+        const int axis = (size.x >= size.y && size.x >= size.z) ? 0 : (size.y >= size.z ? 1 : 2);
+        middle = first + count / 2;
+        std::nth_element(items.begin() + first, items.begin() + middle, items.begin() + first + count,
+                         [&](const BuildItem& a, const BuildItem& b) { return a.center[axis] < b.center[axis]; });
+    }
+
+    // Rayon préparé pour les tests de boîtes
+    struct RayBoxTest {
+#ifdef GAMEENGINE_SSE
+        __m128 origin;
+        __m128 inverseDirection;
+        __m128 xyzMask;   // Voies x, y, z ; la 4e porte leftFirst / count des nœuds
+
+        explicit RayBoxTest(const Ray& ray)
+            : origin(_mm_set_ps(0.0f, ray.origin.z, ray.origin.y, ray.origin.x)),
+              inverseDirection(_mm_set_ps(0.0f, ray.inverseDirection.z, ray.inverseDirection.y, ray.inverseDirection.x)),
+              xyzMask(_mm_cmplt_ps(_mm_setzero_ps(), _mm_set_ps(0.0f, 1.0f, 1.0f, 1.0f))) {}
+
+        // Méthode des dalles sur les trois axes à la fois ; la 4e voie vaut 0
+        // pour l'entrée et maxDistance pour la sortie
+        bool Intersects(const Node& node, float maxDistance, float& tEnter) const {
+            const __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.min), origin), inverseDirection);
+            const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.max), origin), inverseDirection);
+            __m128 tNear = _mm_and_ps(_mm_min_ps(t0, t1), xyzMask);
+            __m128 tFar = _mm_or_ps(_mm_and_ps(_mm_max_ps(t0, t1), xyzMask), _mm_andnot_ps(xyzMask, _mm_set1_ps(maxDistance)));
+
+            tNear = _mm_max_ps(tNear, _mm_shuffle_ps(tNear, tNear, _MM_SHUFFLE(1, 0, 3, 2)));
+            tNear = _mm_max_ss(tNear, _mm_shuffle_ps(tNear, tNear, _MM_SHUFFLE(2, 3, 0, 1)));
+            tFar = _mm_min_ps(tFar, _mm_shuffle_ps(tFar, tFar, _MM_SHUFFLE(1, 0, 3, 2)));
+            tFar = _mm_min_ss(tFar, _mm_shuffle_ps(tFar, tFar, _MM_SHUFFLE(2, 3, 0, 1)));
+
+            _mm_store_ss(&tEnter, tNear);
+            return _mm_comile_ss(tNear, tFar) != 0;
+        }
+#else
+        Ray ray;
+
+        explicit RayBoxTest(const Ray& r) : ray(r) {}
+
+        bool Intersects(const Node& node, float maxDistance, float& tEnter) const {
+            const AABB box(glm::vec3(node.min[0], node.min[1], node.min[2]), glm::vec3(node.max[0], node.max[1], node.max[2]));
+            return ray.Intersects(box, maxDistance, tEnter);
+        }
+#endif
+    };
+
+    // Parcours d'avant en arrière ; visit(i) teste le triangle i (ordre des
+    // feuilles), peut réduire distance, et renvoie vrai pour tout arrêter
+    template<typename F>
+    void Traverse(const Ray& ray, float& distance, F&& visit) const {
+        if (m_Nodes.empty()) {
+            return;
+        }
+        const RayBoxTest test(ray);
+        float t = 0.0f;
+        if (!test.Intersects(m_Nodes[0], distance, t)) {
+            return;
+        }
+
+        struct Entry {
+            uint32_t node;
+            float distance;
+        };
+        Entry stack[STACK_SIZE];
+        uint32_t top = 0;
+        stack[top++] = {0, t};
+        while (top > 0) {
+            const Entry entry = stack[--top];
+            if (entry.distance > distance) {
+                continue;   // Déjà plus loin que l'impact trouvé
+            }
+            const Node& node = m_Nodes[entry.node];
+            if (node.count > 0) {
+                for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; ++i) {
+                    if (visit(i)) {
+                        return;
+                    }
+                }
+                continue;
+            }
+
+            // Enfant le plus proche en dernier sur la pile : visité d'abord
+            float tLeft = 0.0f, tRight = 0.0f;
+            const bool hitLeft = test.Intersects(m_Nodes[node.leftFirst], distance, tLeft);
+            const bool hitRight = test.Intersects(m_Nodes[node.leftFirst + 1], distance, tRight);
+            if (hitLeft && hitRight) {
+                if (tLeft <= tRight) {
+                    stack[top++] = {node.leftFirst + 1, tRight};
+                    stack[top++] = {node.leftFirst, tLeft};
+                } else {
+                    stack[top++] = {node.leftFirst, tLeft};
+                    stack[top++] = {node.leftFirst + 1, tRight};
+                }
+            } else if (hitLeft) {
+                stack[top++] = {node.leftFirst, tLeft};
+            } else if (hitRight) {
+                stack[top++] = {node.leftFirst + 1, tRight};
+            }
+        }
+    }
+
+    // Möller-Trumbore ; impact strictement avant maxDistance
+    static bool IntersectTriangle(const Ray& ray, const Triangle& triangle, float maxDistance, bool cullBackFaces,
+                                  float& t, float& u, float& v) {
+        const glm::vec3 p = glm::cross(ray.direction, triangle.edge2);
+        const float determinant = glm::dot(triangle.edge1, p);
+        if (cullBackFaces ? determinant <= 0.0f : determinant == 0.0f) {
+            return false;
+        }
+        const float inverse = 1.0f / determinant;
+
+        const glm::vec3 s = ray.origin - triangle.v0;
+        u = glm::dot(s, p) * inverse;
+        if (u < 0.0f || u > 1.0f) {
+            return false;
+        }
+        const glm::vec3 q = glm::cross(s, triangle.edge1);
+        v = glm::dot(ray.direction, q) * inverse;
+        if (v < 0.0f || u + v > 1.0f) {
+            return false;
+        }
+        t = glm::dot(triangle.edge2, q) * inverse;
+        return t >= 0.0f && t < maxDistance;
+    }
+
+    std::vector<Node> m_Nodes;
+    std::vector<Triangle> m_Triangles;     // Ordre des feuilles
+    std::vector<uint32_t> m_TriangleIds;   // Triangle source de chaque entrée de m_Triangles
+};
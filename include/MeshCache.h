@@ -0,0 +1,423 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Hash.h"
+#include "Log.h"
+#include "MappedFile.h"
+#include "MeshLOD.h"
+#include "OBJLoader.h"
+#include "VertexLayout.h"
+
+// Version du format : à incrémenter dès que la disposition ou le pipeline de cuisson change
+const uint32_t COOKED_MESH_VERSION = 2;
+
+// ============================================
+// Format binaire des meshes cuits (.gemesh)
+// ============================================
+// [CookedMeshHeader][CookedMeshLOD x lodCount][vertices][indices]
+// Les blocs sont alignés sur 16 octets. Tous les niveaux partagent les blocs ;
+// les indices d'un niveau sont relatifs à son premier vertex.
+struct CookedMeshHeader {
+    char magic[4] = {'G', 'E', 'M', 'S'};
+    uint32_t version = COOKED_MESH_VERSION;
+
+    // Identification du fichier source
+    uint64_t sourceHash = 0;
+    uint64_t sourceSize = 0;
+    int64_t sourceTime = 0;
+
+    float boundsMin[3] = {0.0f, 0.0f, 0.0f};
+    float boundsMax[3] = {0.0f, 0.0f, 0.0f};
+
+    VertexLayout layout;
+    uint32_t indexSize = 4;    // 2 ou 4 octets
+    uint32_t lodCount = 0;
+
+    uint64_t lodTableOffset = 0;
+    uint64_t vertexDataOffset = 0;
+    uint64_t vertexDataSize = 0;
+    uint64_t indexDataOffset = 0;
+    uint64_t indexDataSize = 0;
+};
+
+struct CookedMeshLOD {
+    uint32_t firstVertex = 0;
+    uint32_t vertexCount = 0;
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    float minScreenHeight = 0.0f;
+    uint32_t padding = 0;
+};
+
+// Identité du fichier source, pour savoir si le mesh cuit est à jour
+struct MeshSourceInfo {
+    uint64_t hash = 0;
+    uint64_t size = 0;
+    int64_t time = 0;
+};
+
+// ============================================
+// CookedMesh - Vue sur un mesh cuit
+// ============================================
+// Le mesh est soit un fichier .gemesh projeté en mémoire, soit une image
+// produite par MeshCache::CookToMemory. Aucune donnée n'est copiée : les
+// pointeurs renvoyés pointent dans la projection ou dans l'image.
+class CookedMesh {
+public:
+    bool Open(const std::string& filepath) {
+        Close();
+        if (!m_File.Open(filepath)) {
+            return false;
+        }
+        m_Data = m_File.Data();
+        m_Size = m_File.Size();
+        return Validate();
+    }
+
+    bool Open(std::vector<char>&& image) {
+        Close();
+        m_Memory = std::move(image);
+        m_Data = m_Memory.data();
+        m_Size = m_Memory.size();
+        return Validate();
+    }
+
+    void Close() {
+        m_File.Close();
+        m_Memory.clear();
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Header = CookedMeshHeader();
+    }
+
+    bool IsOpen() const { return m_Data != nullptr; }
+    const CookedMeshHeader& Header() const { return m_Header; }
+
+    AABB Bounds() const {
+        return AABB(glm::vec3(m_Header.boundsMin[0], m_Header.boundsMin[1], m_Header.boundsMin[2]),
+                    glm::vec3(m_Header.boundsMax[0], m_Header.boundsMax[1], m_Header.boundsMax[2]));
+    }
+
+    unsigned int IndexType() const {
+        return m_Header.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    }
+
+    const CookedMeshLOD* LODs() const {
+        return reinterpret_cast<const CookedMeshLOD*>(m_Data + m_Header.lodTableOffset);
+    }
+
+    const char* VertexData(const CookedMeshLOD& lod) const {
+        return m_Data + m_Header.vertexDataOffset + static_cast<uint64_t>(lod.firstVertex) * m_Header.layout.stride;
+    }
+
+    const char* IndexData(const CookedMeshLOD& lod) const {
+        return m_Data + m_Header.indexDataOffset + static_cast<uint64_t>(lod.firstIndex) * m_Header.indexSize;
+    }
+
+    size_t VertexBytes(const CookedMeshLOD& lod) const {
+        return static_cast<size_t>(lod.vertexCount) * m_Header.layout.stride;
+    }
+
+    size_t IndexBytes(const CookedMeshLOD& lod) const {
+        return static_cast<size_t>(lod.indexCount) * m_Header.indexSize;
+    }
+
+    // Prépare la chaîne (seuils, bornes, format) sans rien envoyer au GPU
+    void DescribeLevels(LODChain& chain) const {
+        const AABB bounds = Bounds();
+        chain.levels.clear();
+        chain.levels.resize(m_Header.lodCount);
+        for (uint32_t i = 0; i < m_Header.lodCount; ++i) {
+            MeshLOD& level = chain.levels[i];
+            level.minScreenHeight = LODs()[i].minScreenHeight;
+            level.mesh.bounds = bounds;
+            level.mesh.format = m_Header.layout.format;
+        }
+    }
+
+    // Envoie chaque niveau au GPU directement depuis la projection
+    void Upload(LODChain& chain) const {
+        DescribeLevels(chain);
+        for (uint32_t i = 0; i < m_Header.lodCount; ++i) {
+            const CookedMeshLOD& lod = LODs()[i];
+            chain.levels[i].mesh.Upload(VertexData(lod), VertexBytes(lod), IndexData(lod),
+                                        lod.indexCount, IndexType(), m_Header.layout);
+        }
+    }
+
+private:
+    bool Validate() {
+        if (!m_Data || m_Size < sizeof(CookedMeshHeader)) {
+            Close();
+            return false;
+        }
+
+        std::memcpy(&m_Header, m_Data, sizeof(CookedMeshHeader));
+        if (std::memcmp(m_Header.magic, "GEMS", 4) != 0 || m_Header.version != COOKED_MESH_VERSION) {
+            Close();
+            return false;
+        }
+
+        // Vérifier que tous les blocs sont dans le fichier
+        const uint64_t size = m_Size;
+        bool valid = m_Header.lodCount > 0
+            && m_Header.lodTableOffset + m_Header.lodCount * sizeof(CookedMeshLOD) <= size
+            && m_Header.vertexDataOffset + m_Header.vertexDataSize <= size
+            && m_Header.indexDataOffset + m_Header.indexDataSize <= size
+            && (m_Header.indexSize == 2 || m_Header.indexSize == 4)
+            && m_Header.layout.stride > 0
+            && m_Header.layout.attributeCount <= VertexLayout::MAX_ATTRIBUTES;
+        if (valid) {
+            for (uint32_t i = 0; i < m_Header.lodCount; ++i) {
+                const CookedMeshLOD& lod = LODs()[i];
+                valid = valid
+                    && (static_cast<uint64_t>(lod.firstVertex) + lod.vertexCount) * m_Header.layout.stride <= m_Header.vertexDataSize
+                    && (static_cast<uint64_t>(lod.firstIndex) + lod.indexCount) * m_Header.indexSize <= m_Header.indexDataSize;
+            }
+        }
+        if (!valid) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    MappedFile m_File;
+    std::vector<char> m_Memory;
+    const char* m_Data = nullptr;
+    size_t m_Size = 0;
+    CookedMeshHeader m_Header;
+};
+
+// ============================================
+// MeshCache - Cuisson et chargement des meshes
+// ============================================
+// Un OBJ est analysé, optimisé et décliné en LOD une seule fois ; le résultat
+// est écrit dans cacheDir et rechargé par projection mémoire aux démarrages
+// suivants. Le fichier cuit est invalidé quand le contenu de la source change
+// (empreinte du contenu ; la taille et la date évitent de la recalculer).
+class MeshCache {
+public:
+    static bool LoadOrCook(const std::string& sourcePath, LODChain& chain,
+                           VertexFormat format = VertexFormat::Float32, const std::string& cacheDir = "cache") {
+        CookedMesh cooked;
+        if (!Prepare(sourcePath, cooked, format, cacheDir)) {
+            return false;
+        }
+        cooked.Upload(chain);
+        return true;
+    }
+
+    // Partie CPU de LoadOrCook (aucun appel OpenGL, utilisable depuis un thread de travail) :
+    // ouvre le fichier cuit s'il est à jour, sinon cuit la source et garde l'image en mémoire
+    static bool Prepare(const std::string& sourcePath, CookedMesh& cooked,
+                        VertexFormat format = VertexFormat::Float32, const std::string& cacheDir = "cache") {
+        MeshSourceInfo info;
+        if (!GetSourceInfo(sourcePath, info)) {
+            LOG_ERROR("Failed to open mesh source: " << sourcePath);
+            return false;
+        }
+
+        const std::string cachePath = CachePath(sourcePath, format, cacheDir);
+
+        if (cooked.Open(cachePath) && cooked.Header().layout.format == format &&
+            IsUpToDate(StampOf(cooked.Header()), sourcePath, info, cachePath, offsetof(CookedMeshHeader, sourceTime))) {
+            LOG_INFO("Loaded cooked mesh: " << cachePath << " (" << cooked.Header().lodCount << " LODs)");
+            return true;
+        }
+        cooked.Close();
+
+        // Cuisson
+        MappedFile source(sourcePath);
+        MeshData mesh;
+        if (!source.IsOpen() || !OBJLoader::ParseOBJ(source.Data(), source.Size(), mesh)) {
+            LOG_ERROR("Failed to parse mesh source: " << sourcePath);
+            return false;
+        }
+        info.hash = HashBytes(source.Data(), source.Size());
+        LOG_INFO("Cooking mesh: " << sourcePath);
+
+        mesh.Optimize(true);
+        LODChain chain = LODGenerator::Build(std::move(mesh));
+
+        std::vector<char> image = CookToMemory(chain, info, format);
+        if (!WriteFile(image, cachePath)) {
+            LOG_ERROR("Failed to write cooked mesh: " << cachePath);
+        }
+        return cooked.Open(std::move(image));
+    }
+
+    // Écrit la chaîne de LOD (données CPU) dans un fichier .gemesh
+    static bool Cook(const LODChain& chain, const MeshSourceInfo& info, const std::string& outputPath,
+                     VertexFormat format = VertexFormat::Float32) {
+        std::vector<char> image = CookToMemory(chain, info, format);
+        return !image.empty() && WriteFile(image, outputPath);
+    }
+
+    // Construit l'image .gemesh de la chaîne ; les vertices sont encodés dans le
+    // format demandé, quantifiés dans la boîte de toute la chaîne
+    static std::vector<char> CookToMemory(const LODChain& chain, const MeshSourceInfo& info,
+                                          VertexFormat format = VertexFormat::Float32) {
+        std::vector<char> image;
+        if (chain.Empty()) {
+            return image;
+        }
+
+        CookedMeshHeader header;
+        header.sourceHash = info.hash;
+        header.sourceSize = info.size;
+        header.sourceTime = info.time;
+        header.lodCount = static_cast<uint32_t>(chain.levels.size());
+
+        // Les niveaux simplifiés peuvent légèrement déborder du niveau 0
+        AABB bounds;
+        for (const auto& level : chain.levels) {
+            bounds.Expand(level.mesh.bounds);
+        }
+        header.layout = VertexLayout::ForFormat(format, bounds);
+        for (int i = 0; i < 3; ++i) {
+            header.boundsMin[i] = bounds.min[i];
+            header.boundsMax[i] = bounds.max[i];
+        }
+
+        // Indices 16 bits si tous les niveaux le permettent
+        bool shortIndices = true;
+        for (const auto& level : chain.levels) {
+            shortIndices = shortIndices && level.mesh.VertexCount() <= 0x10000;
+        }
+        header.indexSize = shortIndices ? 2 : 4;
+
+        std::vector<CookedMeshLOD> lods(chain.levels.size());
+        uint64_t vertexCount = 0, indexCount = 0;
+        for (size_t i = 0; i < chain.levels.size(); ++i) {
+            const MeshData& mesh = chain.levels[i].mesh;
+            lods[i].firstVertex = static_cast<uint32_t>(vertexCount);
+            lods[i].vertexCount = static_cast<uint32_t>(mesh.VertexCount());
+            lods[i].firstIndex = static_cast<uint32_t>(indexCount);
+            lods[i].indexCount = static_cast<uint32_t>(mesh.indices.size());
+            lods[i].minScreenHeight = chain.levels[i].minScreenHeight;
+            vertexCount += lods[i].vertexCount;
+            indexCount += lods[i].indexCount;
+        }
+
+        header.lodTableOffset = Align(sizeof(CookedMeshHeader));
+        header.vertexDataOffset = Align(header.lodTableOffset + lods.size() * sizeof(CookedMeshLOD));
+        header.vertexDataSize = vertexCount * header.layout.stride;
+        header.indexDataOffset = Align(header.vertexDataOffset + header.vertexDataSize);
+        header.indexDataSize = indexCount * header.indexSize;
+
+        image.resize(header.indexDataOffset + header.indexDataSize, 0);
+        std::memcpy(image.data(), &header, sizeof(header));
+        std::memcpy(image.data() + header.lodTableOffset, lods.data(), lods.size() * sizeof(CookedMeshLOD));
+
+        for (size_t i = 0; i < chain.levels.size(); ++i) {
+            const MeshData& mesh = chain.levels[i].mesh;
+            char* vertexOut = image.data() + header.vertexDataOffset + static_cast<uint64_t>(lods[i].firstVertex) * header.layout.stride;
+            header.layout.Encode(mesh.vertices.data(), mesh.VertexCount(), FLOATS_PER_VERTEX, vertexOut);
+
+            char* indexOut = image.data() + header.indexDataOffset + static_cast<uint64_t>(lods[i].firstIndex) * header.indexSize;
+            if (shortIndices) {
+                uint16_t* out = reinterpret_cast<uint16_t*>(indexOut);
+                for (size_t k = 0; k < mesh.indices.size(); ++k) {
+                    out[k] = static_cast<uint16_t>(mesh.indices[k]);
+                }
+            } else {
+                std::memcpy(indexOut, mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t));
+            }
+        }
+        return image;
+    }
+
+    // cacheDir/<nom>_<empreinte du chemin>_<format><extension> : une même source peut être
+    // cuite dans plusieurs formats de vertex sans que les fichiers s'écrasent
+    static std::string CachePath(const std::string& sourcePath, VertexFormat format, const std::string& cacheDir,
+                                 const char* extension = ".gemesh") {
+        static const char* const formatNames[] = {"f32", "oct16", "packed"};
+        const uint32_t formatIndex = static_cast<uint32_t>(format);
+        std::ostringstream name;
+        name << std::filesystem::path(sourcePath).stem().string() << "_"
+             << std::hex << std::setw(16) << std::setfill('0') << HashString(sourcePath) << "_"
+             << (formatIndex < 3 ? formatNames[formatIndex] : "unknown") << extension;
+        return (std::filesystem::path(cacheDir) / name.str()).string();
+    }
+
+    // Taille et date de la source (l'empreinte n'est calculée qu'au besoin)
+    static bool GetSourceInfo(const std::string& sourcePath, MeshSourceInfo& info) {
+        std::error_code error;
+        info.size = std::filesystem::file_size(sourcePath, error);
+        if (error) {
+            return false;
+        }
+        info.time = static_cast<int64_t>(std::filesystem::last_write_time(sourcePath, error).time_since_epoch().count());
+        return true;
+    }
+
+    // Le fichier cuit correspond-il encore à la source ? Si seule la date a changé,
+    // elle est réécrite (int64 à timeOffset dans cachePath) pour éviter de recalculer l'empreinte
+    static bool IsUpToDate(const MeshSourceInfo& stored, const std::string& sourcePath,
+                           const MeshSourceInfo& info, const std::string& cachePath, size_t timeOffset) {
+        if (stored.size != info.size) {
+            return false;
+        }
+        if (stored.time == info.time) {
+            return true;
+        }
+
+        // Date différente : comparer le contenu
+        MappedFile source(sourcePath);
+        if (!source.IsOpen() || HashBytes(source.Data(), source.Size()) != stored.hash) {
+            return false;
+        }
+
+        std::fstream file(cachePath, std::ios::binary | std::ios::in | std::ios::out);
+        if (file.is_open()) {
+            file.seekp(static_cast<std::streamoff>(timeOffset));
+            file.write(reinterpret_cast<const char*>(&info.time), sizeof(info.time));
+        }
+        return true;
+    }
+
+    static uint64_t Align(uint64_t offset) {
+        return (offset + 15) & ~uint64_t(15);
+    }
+
+    // Écriture dans un fichier temporaire puis renommage : pas de fichier cuit à moitié écrit
+    static bool WriteFile(const std::vector<char>& image, const std::string& outputPath) {
+        std::error_code error;
+        std::filesystem::path path(outputPath);
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path(), error);
+        }
+
+        const std::string temporaryPath = outputPath + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                return false;
+            }
+            file.write(image.data(), static_cast<std::streamsize>(image.size()));
+            if (!file.good()) {
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporaryPath, outputPath, error);
+        return !error;
+    }
+
+private:
+    static MeshSourceInfo StampOf(const CookedMeshHeader& header) {
+        MeshSourceInfo stamp;
+        stamp.hash = header.sourceHash;
+        stamp.size = header.sourceSize;
+        stamp.time = header.sourceTime;
+        return stamp;
+    }
+};
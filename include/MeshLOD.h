@@ -0,0 +1,630 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <unordered_map>
+#include <glm/glm.hpp>
+#include "Log.h"
+#include "OBJLoader.h"
+#include "Camera.h"
+
+// ============================================
+// Quadric - Matrice d'erreur 4x4 symétrique (Garland & Heckbert)
+// ============================================
+// Seuls les 10 coefficients uniques sont stockés, en double pour la stabilité.
+struct Quadric {
+    double m[10] = {};
+
+    Quadric() = default;
+
+    // Quadric du plan ax + by + cz + d = 0
+    Quadric(double a, double b, double c, double d) {
+        m[0] = a * a; m[1] = a * b; m[2] = a * c; m[3] = a * d;
+        m[4] = b * b; m[5] = b * c; m[6] = b * d;
+        m[7] = c * c; m[8] = c * d;
+        m[9] = d * d;
+    }
+
+    Quadric& operator+=(const Quadric& other) {
+        for (int i = 0; i < 10; ++i) m[i] += other.m[i];
+        return *this;
+    }
+
+    Quadric operator+(const Quadric& other) const {
+        Quadric result = *this;
+        result += other;
+        return result;
+    }
+
+    // Erreur quadratique v^T Q v pour v = (p, 1)
+    double Error(const glm::dvec3& p) const {
+        return m[0] * p.x * p.x + 2.0 * m[1] * p.x * p.y + 2.0 * m[2] * p.x * p.z + 2.0 * m[3] * p.x
+             + m[4] * p.y * p.y + 2.0 * m[5] * p.y * p.z + 2.0 * m[6] * p.y
+             + m[7] * p.z * p.z + 2.0 * m[8] * p.z
+             + m[9];
+    }
+
+    // Position minimisant l'erreur, si le système 3x3 est inversible (règle de Cramer)
+    bool Optimal(glm::dvec3& out) const {
+        double det = Det(0, 1, 2, 1, 4, 5, 2, 5, 7);
+        if (std::abs(det) < 1e-12) {
+            return false;
+        }
+        out.x = -Det(1, 2, 3, 4, 5, 6, 5, 7, 8) / det;
+        out.y =  Det(0, 2, 3, 1, 5, 6, 2, 7, 8) / det;
+        out.z = -Det(0, 1, 3, 1, 4, 6, 2, 5, 8) / det;
+        return true;
+    }
+
+private:
+    // Déterminant 3x3 construit à partir des indices des coefficients
+    double Det(int a11, int a12, int a13,
+               int a21, int a22, int a23,
+               int a31, int a32, int a33) const {
+        return m[a11] * m[a22] * m[a33] + m[a13] * m[a21] * m[a32] + m[a12] * m[a23] * m[a31]
+             - m[a13] * m[a22] * m[a31] - m[a11] * m[a23] * m[a32] - m[a12] * m[a21] * m[a33];
+    }
+};
+
+// ============================================
+// MeshSimplifier - Simplification par contraction d'arêtes (QEM)
+// ============================================
+// Les vertices sont soudés par position avant la simplification (un OBJ
+// non indexé a un vertex par coin de triangle). Les bords ouverts sont
+// verrouillés pour préserver la silhouette des scans. Les normales du
+// résultat sont recalculées, les autres attributs viennent du vertex conservé.
+class MeshSimplifier {
+public:
+    static MeshData Simplify(const MeshData& source, size_t targetTriangleCount, double aggressiveness = 7.0) {
+        MeshSimplifier simplifier;
+        simplifier.Load(source);
+        simplifier.Run(targetTriangleCount, aggressiveness);
+        return simplifier.Build(source);
+    }
+
+private:
+    struct SVertex {
+        glm::dvec3 p;
+        Quadric q;
+        uint32_t tstart = 0;
+        uint32_t tcount = 0;
+        uint32_t source = 0; // Vertex d'origine (pour les attributs)
+        bool border = false;
+    };
+
+    struct STriangle {
+        uint32_t v[3];
+        double err[4];
+        glm::dvec3 n;
+        bool deleted = false;
+        bool dirty = false;
+    };
+
+    struct SRef {
+        uint32_t tid;
+        uint32_t tvertex;
+    };
+
+    std::vector<SVertex> m_Vertices;
+    std::vector<STriangle> m_Triangles;
+    std::vector<SRef> m_Refs;
+
+    // Normalisation dans un cube unité pour que les seuils soient indépendants de l'échelle
+    glm::dvec3 m_Offset{0.0};
+    double m_Scale = 1.0;
+
+    void Load(const MeshData& source) {
+        const size_t vertexCount = source.VertexCount();
+
+        AABB bounds = source.bounds.IsValid() ? source.bounds : AABB();
+        if (!bounds.IsValid()) {
+            for (size_t i = 0; i < vertexCount; ++i) {
+                const float* v = &source.vertices[i * FLOATS_PER_VERTEX];
+                bounds.Expand(glm::vec3(v[0], v[1], v[2]));
+            }
+        }
+        glm::vec3 size = bounds.Size();
+        double maxExtent = std::max(std::max(size.x, size.y), size.z);
+        m_Offset = glm::dvec3(bounds.min);
+        m_Scale = maxExtent > 0.0 ? 1.0 / maxExtent : 1.0;
+
+        // Soudure par position exacte
+        struct PositionKey {
+            uint32_t x, y, z;
+            bool operator==(const PositionKey& o) const { return x == o.x && y == o.y && z == o.z; }
+        };
+        struct PositionHash {
+            size_t operator()(const PositionKey& k) const {
+                return (k.x * 73856093u) ^ (k.y * 19349663u) ^ (k.z * 83492791u);
+            }
+        };
+
+        std::unordered_map<PositionKey, uint32_t, PositionHash> welded;
+        welded.reserve(vertexCount);
+        std::vector<uint32_t> remap(vertexCount);
+        m_Vertices.reserve(vertexCount);
+
+        for (size_t i = 0; i < vertexCount; ++i) {
+            const float* v = &source.vertices[i * FLOATS_PER_VERTEX];
+            PositionKey key;
+            std::memcpy(&key.x, &v[0], sizeof(float));
+            std::memcpy(&key.y, &v[1], sizeof(float));
+            std::memcpy(&key.z, &v[2], sizeof(float));
+
+            auto it = welded.find(key);
+            if (it != welded.end()) {
+                remap[i] = it->second;
+                continue;
+            }
+
+            SVertex vertex;
+            vertex.p = (glm::dvec3(v[0], v[1], v[2]) - m_Offset) * m_Scale;
+            vertex.source = static_cast<uint32_t>(i);
+            remap[i] = static_cast<uint32_t>(m_Vertices.size());
+            welded.emplace(key, remap[i]);
+            m_Vertices.push_back(vertex);
+        }
+
+        m_Triangles.reserve(source.indices.size() / 3);
+        for (size_t i = 0; i + 2 < source.indices.size(); i += 3) {
+            STriangle t;
+            t.v[0] = remap[source.indices[i]];
+            t.v[1] = remap[source.indices[i + 1]];
+            t.v[2] = remap[source.indices[i + 2]];
+            // Triangles dégénérés après soudure
+            if (t.v[0] == t.v[1] || t.v[1] == t.v[2] || t.v[0] == t.v[2]) {
+                continue;
+            }
+            m_Triangles.push_back(t);
+        }
+    }
+
+    void Run(size_t targetTriangleCount, double aggressiveness) {
+        const size_t triangleCount = m_Triangles.size();
+        size_t deletedTriangles = 0;
+        std::vector<int> deleted0, deleted1;
+
+        for (int iteration = 0; iteration < 100; ++iteration) {
+            if (triangleCount - deletedTriangles <= targetTriangleCount) {
+                break;
+            }
+
+            // Reconstruire les références de temps en temps
+            if (iteration % 5 == 0) {
+                UpdateMesh(iteration);
+            }
+
+            for (auto& t : m_Triangles) {
+                t.dirty = false;
+            }
+
+            // Le seuil augmente à chaque itération : on contracte d'abord les arêtes les moins coûteuses
+            const double threshold = 1e-9 * std::pow(static_cast<double>(iteration + 3), aggressiveness);
+
+            for (size_t ti = 0; ti < m_Triangles.size(); ++ti) {
+                STriangle& t = m_Triangles[ti];
+                if (t.err[3] > threshold || t.deleted || t.dirty) {
+                    continue;
+                }
+
+                for (int j = 0; j < 3; ++j) {
+                    if (t.err[j] >= threshold) {
+                        continue;
+                    }
+
+                    const uint32_t i0 = t.v[j];
+                    const uint32_t i1 = t.v[(j + 1) % 3];
+                    SVertex& v0 = m_Vertices[i0];
+                    SVertex& v1 = m_Vertices[i1];
+
+                    if (v0.border || v1.border) {
+                        continue;
+                    }
+
+                    glm::dvec3 p;
+                    CalculateError(i0, i1, p);
+
+                    deleted0.resize(v0.tcount);
+                    deleted1.resize(v1.tcount);
+
+                    // Refuser les contractions qui retournent des triangles
+                    if (Flipped(p, i1, v0, deleted0) || Flipped(p, i0, v1, deleted1)) {
+                        continue;
+                    }
+
+                    v0.p = p;
+                    v0.q += v1.q;
+
+                    const size_t tstart = m_Refs.size();
+                    UpdateTriangles(i0, v0, deleted0, deletedTriangles);
+                    UpdateTriangles(i0, v1, deleted1, deletedTriangles);
+                    const size_t tcount = m_Refs.size() - tstart;
+
+                    if (tcount <= v0.tcount) {
+                        // Réutiliser l'emplacement existant
+                        if (tcount > 0) {
+                            std::copy(m_Refs.begin() + tstart, m_Refs.end(), m_Refs.begin() + v0.tstart);
+                        }
+                        m_Refs.resize(tstart);
+                    } else {
+                        v0.tstart = static_cast<uint32_t>(tstart);
+                    }
+                    v0.tcount = static_cast<uint32_t>(tcount);
+                    break;
+                }
+
+                if (triangleCount - deletedTriangles <= targetTriangleCount) {
+                    break;
+                }
+            }
+        }
+
+        CompactTriangles();
+    }
+
+    MeshData Build(const MeshData& source) const {
+        MeshData mesh;
+
+        std::vector<uint32_t> remap(m_Vertices.size(), UINT32_MAX);
+        uint32_t used = 0;
+        for (const auto& t : m_Triangles) {
+            for (uint32_t id : t.v) {
+                if (remap[id] == UINT32_MAX) {
+                    remap[id] = used++;
+                }
+            }
+        }
+
+        mesh.vertices.assign(static_cast<size_t>(used) * FLOATS_PER_VERTEX, 0.0f);
+        for (size_t i = 0; i < m_Vertices.size(); ++i) {
+            if (remap[i] == UINT32_MAX) {
+                continue;
+            }
+            float* dst = &mesh.vertices[remap[i] * FLOATS_PER_VERTEX];
+            const float* src = &source.vertices[m_Vertices[i].source * FLOATS_PER_VERTEX];
+            std::copy(src, src + FLOATS_PER_VERTEX, dst);
+
+            glm::dvec3 p = m_Vertices[i].p / m_Scale + m_Offset;
+            dst[0] = static_cast<float>(p.x);
+            dst[1] = static_cast<float>(p.y);
+            dst[2] = static_cast<float>(p.z);
+            dst[3] = dst[4] = dst[5] = 0.0f;
+        }
+
+        mesh.indices.reserve(m_Triangles.size() * 3);
+        for (const auto& t : m_Triangles) {
+            for (uint32_t id : t.v) {
+                mesh.indices.push_back(remap[id]);
+            }
+        }
+
+        // Normales lissées pondérées par l'aire
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            float* a = &mesh.vertices[mesh.indices[i] * FLOATS_PER_VERTEX];
+            float* b = &mesh.vertices[mesh.indices[i + 1] * FLOATS_PER_VERTEX];
+            float* c = &mesh.vertices[mesh.indices[i + 2] * FLOATS_PER_VERTEX];
+            glm::vec3 pa(a[0], a[1], a[2]), pb(b[0], b[1], b[2]), pc(c[0], c[1], c[2]);
+            glm::vec3 n = glm::cross(pb - pa, pc - pa);
+            for (float* v : {a, b, c}) {
+                v[3] += n.x; v[4] += n.y; v[5] += n.z;
+            }
+        }
+        for (size_t i = 0; i < used; ++i) {
+            float* v = &mesh.vertices[i * FLOATS_PER_VERTEX];
+            glm::vec3 n(v[3], v[4], v[5]);
+            float len = glm::length(n);
+            n = len > 0.0f ? n / len : glm::vec3(0.0f, 1.0f, 0.0f);
+            v[3] = n.x; v[4] = n.y; v[5] = n.z;
+        }
+
+        mesh.ComputeBounds();
+        return mesh;
+    }
+
+    // Erreur de la contraction (i0, i1) et position résultante
+    double CalculateError(uint32_t i0, uint32_t i1, glm::dvec3& result) const {
+        const SVertex& v0 = m_Vertices[i0];
+        const SVertex& v1 = m_Vertices[i1];
+        Quadric q = v0.q + v1.q;
+
+        if (q.Optimal(result)) {
+            return q.Error(result);
+        }
+
+        // Matrice singulière : choisir entre les extrémités et le milieu
+        glm::dvec3 mid = (v0.p + v1.p) * 0.5;
+        double e0 = q.Error(v0.p);
+        double e1 = q.Error(v1.p);
+        double em = q.Error(mid);
+        double error = std::min(e0, std::min(e1, em));
+        if (error == e0) result = v0.p;
+        else if (error == e1) result = v1.p;
+        else result = mid;
+        return error;
+    }
+
+    bool Flipped(const glm::dvec3& p, uint32_t other, const SVertex& v, std::vector<int>& deleted) const {
+        for (uint32_t k = 0; k < v.tcount; ++k) {
+            const SRef& ref = m_Refs[v.tstart + k];
+            const STriangle& t = m_Triangles[ref.tid];
+            if (t.deleted) {
+                continue;
+            }
+
+            const uint32_t id1 = t.v[(ref.tvertex + 1) % 3];
+            const uint32_t id2 = t.v[(ref.tvertex + 2) % 3];
+
+            // Triangle qui disparaît avec la contraction
+            if (id1 == other || id2 == other) {
+                deleted[k] = 1;
+                continue;
+            }
+
+            glm::dvec3 d1 = m_Vertices[id1].p - p;
+            glm::dvec3 d2 = m_Vertices[id2].p - p;
+            double l1 = glm::length(d1);
+            double l2 = glm::length(d2);
+            if (l1 <= 0.0 || l2 <= 0.0) {
+                return true;
+            }
+            d1 /= l1;
+            d2 /= l2;
+            if (std::abs(glm::dot(d1, d2)) > 0.999) {
+                return true;
+            }
+
+            glm::dvec3 n = glm::normalize(glm::cross(d1, d2));
+            deleted[k] = 0;
+            if (glm::dot(n, t.n) < 0.2) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void UpdateTriangles(uint32_t i0, const SVertex& v, const std::vector<int>& deleted, size_t& deletedTriangles) {
+        for (uint32_t k = 0; k < v.tcount; ++k) {
+            const SRef ref = m_Refs[v.tstart + k];
+            STriangle& t = m_Triangles[ref.tid];
+            if (t.deleted) {
+                continue;
+            }
+            if (deleted[k]) {
+                t.deleted = true;
+                ++deletedTriangles;
+                continue;
+            }
+
+            t.v[ref.tvertex] = i0;
+            t.dirty = true;
+            glm::dvec3 p;
+            t.err[0] = CalculateError(t.v[0], t.v[1], p);
+            t.err[1] = CalculateError(t.v[1], t.v[2], p);
+            t.err[2] = CalculateError(t.v[2], t.v[0], p);
+            t.err[3] = std::min(t.err[0], std::min(t.err[1], t.err[2]));
+            m_Refs.push_back(ref);
+        }
+    }
+
+    void CompactTriangles() {
+        m_Triangles.erase(std::remove_if(m_Triangles.begin(), m_Triangles.end(),
+                                         [](const STriangle& t) { return t.deleted; }),
+                          m_Triangles.end());
+    }
+
+    void UpdateMesh(int iteration) {
+        if (iteration > 0) {
+            CompactTriangles();
+        }
+
+        // Construire la table triangle <- vertex
+        for (auto& v : m_Vertices) {
+            v.tstart = 0;
+            v.tcount = 0;
+        }
+        for (const auto& t : m_Triangles) {
+            for (uint32_t id : t.v) ++m_Vertices[id].tcount;
+        }
+        uint32_t tstart = 0;
+        for (auto& v : m_Vertices) {
+            v.tstart = tstart;
+            tstart += v.tcount;
+            v.tcount = 0;
+        }
+
+        m_Refs.resize(m_Triangles.size() * 3);
+        for (size_t i = 0; i < m_Triangles.size(); ++i) {
+            const STriangle& t = m_Triangles[i];
+            for (uint32_t j = 0; j < 3; ++j) {
+                SVertex& v = m_Vertices[t.v[j]];
+                m_Refs[v.tstart + v.tcount] = {static_cast<uint32_t>(i), j};
+                ++v.tcount;
+            }
+        }
+
+        if (iteration != 0) {
+            return;
+        }
+
+        // Détection des bords : une arête partagée par un seul triangle
+        std::vector<uint32_t> neighbors, counts;
+        for (auto& v : m_Vertices) {
+            neighbors.clear();
+            counts.clear();
+            for (uint32_t k = 0; k < v.tcount; ++k) {
+                const STriangle& t = m_Triangles[m_Refs[v.tstart + k].tid];
+                for (uint32_t id : t.v) {
+                    auto it = std::find(neighbors.begin(), neighbors.end(), id);
+                    if (it == neighbors.end()) {
+                        neighbors.push_back(id);
+                        counts.push_back(1);
+                    } else {
+                        ++counts[it - neighbors.begin()];
+                    }
+                }
+            }
+            for (size_t n = 0; n < neighbors.size(); ++n) {
+                if (counts[n] == 1) {
+                    v.border = true;
+                    m_Vertices[neighbors[n]].border = true;
+                }
+            }
+        }
+
+        // Quadrics des plans de chaque triangle
+        for (auto& t : m_Triangles) {
+            const glm::dvec3& p0 = m_Vertices[t.v[0]].p;
+            glm::dvec3 n = glm::cross(m_Vertices[t.v[1]].p - p0, m_Vertices[t.v[2]].p - p0);
+            double len = glm::length(n);
+            t.n = len > 0.0 ? n / len : glm::dvec3(0.0);
+            Quadric q(t.n.x, t.n.y, t.n.z, -glm::dot(t.n, p0));
+            for (uint32_t id : t.v) {
+                m_Vertices[id].q += q;
+            }
+        }
+
+        for (auto& t : m_Triangles) {
+            glm::dvec3 p;
+            t.err[0] = CalculateError(t.v[0], t.v[1], p);
+            t.err[1] = CalculateError(t.v[1], t.v[2], p);
+            t.err[2] = CalculateError(t.v[2], t.v[0], p);
+            t.err[3] = std::min(t.err[0], std::min(t.err[1], t.err[2]));
+        }
+    }
+};
+
+// ============================================
+// LODChain - Niveaux de détail d'un mesh
+// ============================================
+struct MeshLOD {
+    MeshData mesh;
+    float minScreenHeight = 0.0f; // Fraction de la hauteur d'écran à partir de laquelle ce niveau est utilisé
+};
+
+struct LODChain {
+    std::vector<MeshLOD> levels; // levels[0] = pleine résolution
+
+    bool Empty() const { return levels.empty(); }
+
+    const AABB& Bounds() const { return levels.front().mesh.bounds; }
+
+    size_t GpuBytes() const {
+        size_t bytes = 0;
+        for (const auto& level : levels) {
+            bytes += level.mesh.gpuBytes;
+        }
+        return bytes;
+    }
+
+    // Choisit le niveau le plus détaillé dont le seuil est atteint
+    size_t SelectLevel(float screenHeight) const {
+        for (size_t i = 0; i < levels.size(); ++i) {
+            if (screenHeight >= levels[i].minScreenHeight) {
+                return i;
+            }
+        }
+        return levels.empty() ? 0 : levels.size() - 1;
+    }
+
+    // Envoie au GPU les niveaux qui ne l'ont pas encore été
+    void Setup(VertexFormat format = VertexFormat::Float32) {
+        for (auto& level : levels) {
+            if (level.mesh.VAO == 0) {
+                level.mesh.format = format;
+                level.mesh.SetupMesh();
+            }
+        }
+    }
+
+    void Cleanup() {
+        for (auto& level : levels) {
+            level.mesh.Cleanup();
+        }
+    }
+};
+
+// ============================================
+// LODGenerator - Construit une chaîne de LOD
+// ============================================
+class LODGenerator {
+public:
+    // ratios[i] = fraction des triangles du niveau 0, screenHeights[i] = seuil de sélection
+    static LODChain Build(MeshData source,
+                          const std::vector<float>& ratios = {1.0f, 0.5f, 0.25f, 0.1f},
+                          const std::vector<float>& screenHeights = {0.5f, 0.25f, 0.1f, 0.0f}) {
+        LODChain chain;
+        if (!source.bounds.IsValid()) {
+            source.ComputeBounds();
+        }
+        const size_t fullTriangles = source.indices.size() / 3;
+
+        chain.levels.push_back({std::move(source), screenHeights.empty() ? 0.0f : screenHeights[0]});
+
+        for (size_t i = 1; i < ratios.size(); ++i) {
+            size_t target = static_cast<size_t>(fullTriangles * ratios[i]);
+            // Chaque niveau part du précédent : plus rapide et cohérent
+            const MeshData& previous = chain.levels.back().mesh;
+            if (previous.indices.size() / 3 <= target || target < 4) {
+                break;
+            }
+
+            MeshLOD level;
+            level.mesh = MeshSimplifier::Simplify(previous, target);
+            level.mesh.Optimize();
+            level.minScreenHeight = i < screenHeights.size() ? screenHeights[i] : 0.0f;
+            LOG_INFO("  LOD " << i << ": " << level.mesh.indices.size() / 3 << " triangles");
+            chain.levels.push_back(std::move(level));
+        }
+
+        // Le dernier niveau sert toujours de repli
+        chain.levels.back().minScreenHeight = 0.0f;
+        return chain;
+    }
+
+    // Sphère : les niveaux sont générés analytiquement en divisant la tessellation.
+    // Toujours au moins un niveau, même sans seuils ou avec une tessellation minimale
+    static LODChain BuildSphere(float radius = 1.0f, int sectors = 36, int stacks = 18,
+                                const std::vector<float>& screenHeights = {0.5f, 0.25f, 0.1f, 0.0f}) {
+        LODChain chain;
+        sectors = std::max(sectors, 3);
+        stacks = std::max(stacks, 2);
+        for (size_t i = 0; i == 0 || (i < screenHeights.size() && sectors >= 6 && stacks >= 3); ++i) {
+            MeshLOD level{MeshGenerator::BuildSphere(radius, sectors, stacks),
+                          i < screenHeights.size() ? screenHeights[i] : 0.0f};
+            level.mesh.Optimize();
+            chain.levels.push_back(std::move(level));
+            sectors /= 2;
+            stacks /= 2;
+        }
+        chain.levels.back().minScreenHeight = 0.0f;
+        return chain;
+    }
+};
+
+// ============================================
+// LODSelector - Sélection selon la taille projetée à l'écran
+// ============================================
+class LODSelector {
+public:
+    // Fraction de la hauteur d'écran couverte par la sphère englobante (1 = tout l'écran)
+    static float ComputeScreenHeight(const glm::vec3& center, float radius, const FPSCamera& camera) {
+        float distance = glm::length(center - camera.Position);
+        if (distance <= radius) {
+            return 1.0f;
+        }
+        float halfFov = glm::radians(camera.Zoom) * 0.5f;
+        return radius / (distance * std::tan(halfFov));
+    }
+
+    // Sélection pour un mesh placé avec la matrice model
+    static size_t Select(const LODChain& chain, const glm::mat4& model, const FPSCamera& camera) {
+        if (chain.Empty()) {
+            return 0;
+        }
+        AABB worldBounds = chain.Bounds().Transform(model);
+        float screenHeight = ComputeScreenHeight(worldBounds.Center(), worldBounds.Radius(), camera);
+        return chain.SelectLevel(screenHeight);
+    }
+};
\ No newline at end of file
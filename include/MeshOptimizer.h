@@ -0,0 +1,314 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+#include <glm/glm.hpp>
+
+// ============================================
+// VertexCacheStats - Efficacité du cache post-transformation
+// ============================================
+struct VertexCacheStats {
+    size_t transformedVertices = 0; // Défauts de cache (vertices réellement transformés)
+    float acmr = 0.0f;              // Average Cache Miss Ratio : transformations par triangle (0.5 idéal)
+    float atvr = 0.0f;              // Average Transformed Vertex Ratio : transformations par vertex (1.0 idéal)
+};
+
+// ============================================
+// MeshOptimizer - Réordonne triangles et vertices
+// ============================================
+// Travaille sur des tableaux bruts (aucun appel OpenGL) :
+// 1. OptimizeVertexCache : Tipsify (Sander et al. 2007)
+// 2. OptimizeOverdraw    : tri des clusters Tipsify de l'extérieur vers l'intérieur
+// 3. OptimizeVertexFetch : renumérote les vertices dans l'ordre du premier accès
+class MeshOptimizer {
+public:
+    // Simule un cache FIFO de taille cacheSize sur le flux d'indices
+    static VertexCacheStats AnalyzeVertexCache(const std::vector<unsigned int>& indices,
+                                               size_t vertexCount, unsigned int cacheSize = 16) {
+        VertexCacheStats stats;
+        if (indices.empty() || vertexCount == 0) {
+            return stats;
+        }
+
+        // Horodatage d'entrée dans le FIFO : un vertex est présent si time - entrée < cacheSize
+        std::vector<size_t> cacheTime(vertexCount, 0);
+        std::vector<char> referenced(vertexCount, 0);
+        size_t time = cacheSize + 1;
+        size_t uniqueVertices = 0;
+
+        for (unsigned int index : indices) {
+            if (time - cacheTime[index] > cacheSize) {
+                cacheTime[index] = time++;
+                ++stats.transformedVertices;
+            }
+            if (!referenced[index]) {
+                referenced[index] = 1;
+                ++uniqueVertices;
+            }
+        }
+
+        stats.acmr = static_cast<float>(stats.transformedVertices) / (indices.size() / 3);
+        stats.atvr = static_cast<float>(stats.transformedVertices) / uniqueVertices;
+        return stats;
+    }
+
+    // Tipsify : renvoie les triangles réordonnés ; clusters reçoit l'indice du premier
+    // triangle de chaque cluster (frontières où le cache doit être rechargé)
+    static std::vector<unsigned int> OptimizeVertexCache(const std::vector<unsigned int>& indices,
+                                                         size_t vertexCount,
+                                                         unsigned int cacheSize = 16,
+                                                         std::vector<unsigned int>* clusters = nullptr) {
+        const size_t triangleCount = indices.size() / 3;
+        std::vector<unsigned int> result;
+        result.reserve(triangleCount * 3);
+        if (clusters) {
+            clusters->clear();
+        }
+        if (triangleCount == 0) {
+            return result;
+        }
+
+        // Adjacence vertex -> triangles (CSR)
+        std::vector<unsigned int> liveTriangles(vertexCount, 0);
+        for (unsigned int index : indices) {
+            ++liveTriangles[index];
+        }
+        std::vector<unsigned int> offsets(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            offsets[v + 1] = offsets[v] + liveTriangles[v];
+        }
+        std::vector<unsigned int> adjacency(indices.size());
+        {
+            std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < indices.size(); ++i) {
+                adjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+            }
+        }
+
+        std::vector<size_t> cacheTime(vertexCount, 0);
+        std::vector<char> emitted(triangleCount, 0);
+        std::vector<unsigned int> deadEnd;
+        std::vector<unsigned int> candidates;
+        deadEnd.reserve(indices.size());
+        candidates.reserve(64);
+
+        size_t time = cacheSize + 1;
+        size_t cursor = 0;
+        long fanning = static_cast<long>(indices[0]);
+
+        if (clusters) {
+            clusters->push_back(0);
+        }
+
+        while (fanning >= 0) {
+            candidates.clear();
+
+            // Émettre tous les triangles restants autour du vertex courant
+            for (unsigned int a = offsets[fanning]; a < offsets[fanning + 1]; ++a) {
+                unsigned int triangle = adjacency[a];
+                if (emitted[triangle]) {
+                    continue;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    unsigned int v = indices[triangle * 3 + k];
+                    result.push_back(v);
+                    deadEnd.push_back(v);
+                    candidates.push_back(v);
+                    --liveTriangles[v];
+                    if (time - cacheTime[v] > cacheSize) {
+                        cacheTime[v] = time++;
+                    }
+                }
+                emitted[triangle] = 1;
+            }
+
+            // Prochain vertex : le plus ancien encore en cache après son éventail
+            long next = -1;
+            long bestPriority = -1;
+            for (unsigned int v : candidates) {
+                if (liveTriangles[v] == 0) {
+                    continue;
+                }
+                long priority = 0;
+                if (time - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize) {
+                    priority = static_cast<long>(time - cacheTime[v]);
+                }
+                if (priority > bestPriority) {
+                    bestPriority = priority;
+                    next = static_cast<long>(v);
+                }
+            }
+
+            if (next < 0) {
+                // Impasse : remonter la pile des vertices récents
+                while (!deadEnd.empty()) {
+                    unsigned int v = deadEnd.back();
+                    deadEnd.pop_back();
+                    if (liveTriangles[v] > 0) {
+                        next = static_cast<long>(v);
+                        break;
+                    }
+                }
+            }
+
+            if (next < 0) {
+                // Sinon, premier vertex encore vivant dans l'ordre d'entrée : saut non local
+                while (cursor < vertexCount && liveTriangles[cursor] == 0) {
+                    ++cursor;
+                }
+                if (cursor < vertexCount) {
+                    next = static_cast<long>(cursor);
+                    if (clusters) {
+                        clusters->push_back(static_cast<unsigned int>(result.size() / 3));
+                    }
+                }
+            }
+
+            fanning = next;
+        }
+
+        return result;
+    }
+
+    // Trie les clusters pour dessiner d'abord les faces extérieures (moins de surdessin).
+    // Les clusters durs de Tipsify sont d'abord subdivisés tant que l'ACMR local reste
+    // sous threshold * ACMR global, pour donner plus de liberté au tri.
+    static void OptimizeOverdraw(std::vector<unsigned int>& indices,
+                                 const std::vector<unsigned int>& hardClusters,
+                                 const std::vector<float>& vertices, unsigned int floatsPerVertex,
+                                 unsigned int cacheSize = 16, float threshold = 1.05f) {
+        const size_t triangleCount = indices.size() / 3;
+        const size_t vertexCount = vertices.size() / floatsPerVertex;
+        if (triangleCount == 0 || hardClusters.empty()) {
+            return;
+        }
+
+        const float globalAcmr = AnalyzeVertexCache(indices, vertexCount, cacheSize).acmr;
+
+        // Subdivision en clusters souples
+        std::vector<unsigned int> clusters;
+        std::vector<size_t> cacheTime(vertexCount, 0);
+        size_t time = cacheSize + 1;
+        for (size_t c = 0; c < hardClusters.size(); ++c) {
+            const size_t start = hardClusters[c];
+            const size_t end = (c + 1 < hardClusters.size()) ? hardClusters[c + 1] : triangleCount;
+            size_t clusterStart = start;
+            size_t misses = 0;
+            clusters.push_back(static_cast<unsigned int>(start));
+            time += cacheSize + 1; // Cache vide au début d'un cluster dur
+
+            for (size_t t = start; t < end; ++t) {
+                for (int k = 0; k < 3; ++k) {
+                    unsigned int v = indices[t * 3 + k];
+                    if (time - cacheTime[v] > cacheSize) {
+                        cacheTime[v] = time++;
+                        ++misses;
+                    }
+                }
+                const size_t clusterTriangles = t - clusterStart + 1;
+                if (t + 1 < end && clusterTriangles >= 8 &&
+                    static_cast<float>(misses) / clusterTriangles <= threshold * globalAcmr) {
+                    // Chaque cluster doit rester efficace seul, cache vide (il sera déplacé)
+                    clusters.push_back(static_cast<unsigned int>(t + 1));
+                    clusterStart = t + 1;
+                    misses = 0;
+                    time += cacheSize + 1;
+                }
+            }
+        }
+
+        auto position = [&](unsigned int v) {
+            const float* p = &vertices[static_cast<size_t>(v) * floatsPerVertex];
+            return glm::vec3(p[0], p[1], p[2]);
+        };
+
+        // Centre du mesh pondéré par l'aire
+        glm::vec3 meshCenter(0.0f);
+        float meshArea = 0.0f;
+        for (size_t t = 0; t < triangleCount; ++t) {
+            glm::vec3 a = position(indices[t * 3]), b = position(indices[t * 3 + 1]), c = position(indices[t * 3 + 2]);
+            float area = glm::length(glm::cross(b - a, c - a));
+            meshCenter += (a + b + c) * (area / 3.0f);
+            meshArea += area;
+        }
+        if (meshArea > 0.0f) {
+            meshCenter /= meshArea;
+        }
+
+        // Score : les clusters loin du centre et orientés vers l'extérieur passent en premier
+        std::vector<float> scores(clusters.size(), 0.0f);
+        for (size_t c = 0; c < clusters.size(); ++c) {
+            const size_t start = clusters[c];
+            const size_t end = (c + 1 < clusters.size()) ? clusters[c + 1] : triangleCount;
+            glm::vec3 center(0.0f), normal(0.0f);
+            float area = 0.0f;
+            for (size_t t = start; t < end; ++t) {
+                glm::vec3 a = position(indices[t * 3]), b = position(indices[t * 3 + 1]), cc = position(indices[t * 3 + 2]);
+                glm::vec3 n = glm::cross(b - a, cc - a);
+                float triangleArea = glm::length(n);
+                center += (a + b + cc) * (triangleArea / 3.0f);
+                normal += n;
+                area += triangleArea;
+            }
+            if (area > 0.0f) {
+                center /= area;
+            }
+            float normalLength = glm::length(normal);
+            if (normalLength > 0.0f) {
+                normal /= normalLength;
+            }
+            scores[c] = glm::dot(center - meshCenter, normal);
+        }
+
+        std::vector<unsigned int> order(clusters.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(),
+                         [&](unsigned int a, unsigned int b) { return scores[a] > scores[b]; });
+
+        std::vector<unsigned int> sorted;
+        sorted.reserve(indices.size());
+        for (unsigned int c : order) {
+            const size_t start = clusters[c];
+            const size_t end = (c + 1 < clusters.size()) ? clusters[c + 1] : triangleCount;
+            sorted.insert(sorted.end(), indices.begin() + start * 3, indices.begin() + end * 3);
+        }
+        indices.swap(sorted);
+    }
+
+    // Renumérote les vertices dans l'ordre du premier accès (localité des lectures)
+    // et supprime ceux qui ne sont pas référencés
+    static void OptimizeVertexFetch(std::vector<float>& vertices, std::vector<unsigned int>& indices,
+                                    unsigned int floatsPerVertex) {
+        const size_t vertexCount = vertices.size() / floatsPerVertex;
+        std::vector<unsigned int> remap(vertexCount, UINT32_MAX);
+        std::vector<float> reordered;
+        reordered.reserve(vertices.size());
+
+        unsigned int next = 0;
+        for (unsigned int& index : indices) {
+            if (remap[index] == UINT32_MAX) {
+                remap[index] = next++;
+                const float* src = &vertices[static_cast<size_t>(index) * floatsPerVertex];
+                reordered.insert(reordered.end(), src, src + floatsPerVertex);
+            }
+            index = remap[index];
+        }
+
+        vertices.swap(reordered);
+    }
+
+    // Passe complète : cache, surdessin puis lecture des vertices
+    static void Optimize(std::vector<float>& vertices, std::vector<unsigned int>& indices,
+                         unsigned int floatsPerVertex, unsigned int cacheSize = 16) {
+        const size_t vertexCount = vertices.size() / floatsPerVertex;
+        if (indices.size() < 3 || vertexCount == 0) {
+            return;
+        }
+
+        std::vector<unsigned int> clusters;
+        indices = OptimizeVertexCache(indices, vertexCount, cacheSize, &clusters);
+        OptimizeOverdraw(indices, clusters, vertices, floatsPerVertex, cacheSize);
+        OptimizeVertexFetch(vertices, indices, floatsPerVertex);
+    }
+};
\ No newline at end of file
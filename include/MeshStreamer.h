@@ -0,0 +1,629 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "Bounds.h"
+#include "Log.h"
+#include "MeshCache.h"
+#include "OBJLoader.h"
+#include "Renderer.h"
+#include "ThreadPool.h"
+#include "VertexLayout.h"
+
+// Version du format : à incrémenter dès que la disposition ou le découpage change
+const uint32_t CHUNKED_MESH_VERSION = 1;
+
+// Triangles par morceau par défaut (16 bits d'indices suffisent toujours)
+const uint32_t DEFAULT_CHUNK_TRIANGLES = 16384;
+
+// ============================================
+// Format binaire des meshes découpés (.gechunks)
+// ============================================
+// [ChunkedMeshHeader][données des morceaux...][ChunkRecord x chunkCount]
+// Les données d'un morceau sont contiguës (vertices puis indices, alignés sur
+// 16 octets) : une seule lecture par morceau. Tous les morceaux partagent la
+// même disposition, quantifiée dans la boîte du mesh complet.
+struct ChunkedMeshHeader {
+    char magic[4] = {'G', 'E', 'C', 'H'};
+    uint32_t version = CHUNKED_MESH_VERSION;
+
+    // Identification du fichier source (même place que dans CookedMeshHeader)
+    uint64_t sourceHash = 0;
+    uint64_t sourceSize = 0;
+    int64_t sourceTime = 0;
+
+    float boundsMin[3] = {0.0f, 0.0f, 0.0f};
+    float boundsMax[3] = {0.0f, 0.0f, 0.0f};
+
+    VertexLayout layout;
+    uint32_t indexSize = 2;
+    uint32_t chunkCount = 0;
+    uint32_t maxChunkTriangles = 0;
+    uint32_t padding = 0;
+    uint64_t chunkTableOffset = 0;
+};
+
+static_assert(offsetof(ChunkedMeshHeader, sourceTime) == offsetof(CookedMeshHeader, sourceTime),
+              "MeshCache::IsUpToDate réécrit sourceTime à la même position");
+
+struct ChunkRecord {
+    float boundsMin[3] = {0.0f, 0.0f, 0.0f};
+    float boundsMax[3] = {0.0f, 0.0f, 0.0f};
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    uint64_t dataOffset = 0;
+    uint64_t vertexBytes = 0;
+    uint64_t indexBytes = 0;
+
+    AABB Bounds() const {
+        return AABB(glm::vec3(boundsMin[0], boundsMin[1], boundsMin[2]),
+                    glm::vec3(boundsMax[0], boundsMax[1], boundsMax[2]));
+    }
+
+    // Décalage des indices dans les données du morceau
+    uint64_t IndexOffset() const { return MeshCache::Align(vertexBytes); }
+    uint64_t DataBytes() const { return IndexOffset() + indexBytes; }
+    uint64_t GpuBytes() const { return vertexBytes + indexBytes; }
+};
+
+// ============================================
+// MeshChunker - Découpe un mesh en morceaux spatialement cohérents
+// ============================================
+// Les triangles sont séparés récursivement à la médiane de leurs centres, sur
+// l'axe le plus long, jusqu'à maxTriangles par morceau. Chaque morceau est
+// ensuite optimisé pour le cache de vertices.
+class MeshChunker {
+public:
+    // Ordre des triangles et intervalles [début, fin) de chaque morceau dans cet ordre
+    static void Partition(const MeshData& mesh, size_t maxTriangles,
+                          std::vector<uint32_t>& order, std::vector<std::pair<size_t, size_t>>& ranges) {
+        const size_t triangleCount = mesh.indices.size() / 3;
+        maxTriangles = std::max<size_t>(maxTriangles, 1);
+
+        std::vector<glm::vec3> centers(triangleCount);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            glm::vec3 sum(0.0f);
+            for (int k = 0; k < 3; ++k) {
+                const float* p = &mesh.vertices[static_cast<size_t>(mesh.indices[t * 3 + k]) * FLOATS_PER_VERTEX];
+                sum += glm::vec3(p[0], p[1], p[2]);
+            }
+            centers[t] = sum / 3.0f;
+        }
+
+        order.resize(triangleCount);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            order[t] = static_cast<uint32_t>(t);
+        }
+        ranges.clear();
+
+        std::vector<std::pair<size_t, size_t>> stack;
+        if (triangleCount > 0) {
+            stack.emplace_back(0, triangleCount);
+        }
+        while (!stack.empty()) {
+            const auto range = stack.back();
+            stack.pop_back();
+            const size_t count = range.second - range.first;
+            if (count <= maxTriangles) {
+                ranges.push_back(range);
+                continue;
+            }
+
+            AABB centerBounds;
+            for (size_t i = range.first; i < range.second; ++i) {
+                centerBounds.Expand(centers[order[i]]);
+            }
+            const glm::vec3 size = centerBounds.Size();
+            const int axis = (size.x >= size.y && size.x >= size.z) ? 0 : (size.y >= size.z ? 1 : 2);
+
+            const size_t middle = range.first + count / 2;
+            std::nth_element(order.begin() + range.first, order.begin() + middle, order.begin() + range.second,
+                             [&](uint32_t a, uint32_t b) { return centers[a][axis] < centers[b][axis]; });
+            // Empilé à l'envers pour garder les morceaux dans l'ordre spatial
+            stack.emplace_back(middle, range.second);
+            stack.emplace_back(range.first, middle);
+        }
+    }
+
+    // Mesh autonome formé des triangles donnés (vertices renumérotés)
+    static MeshData Extract(const MeshData& mesh, const uint32_t* triangles, size_t triangleCount) {
+        MeshData chunk;
+        std::unordered_map<unsigned int, unsigned int> remap;
+        remap.reserve(triangleCount * 2);
+        chunk.indices.reserve(triangleCount * 3);
+        chunk.vertices.reserve(triangleCount * FLOATS_PER_VERTEX);
+
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                const unsigned int source = mesh.indices[static_cast<size_t>(triangles[t]) * 3 + k];
+                auto inserted = remap.emplace(source, static_cast<unsigned int>(chunk.VertexCount()));
+                if (inserted.second) {
+                    const float* p = &mesh.vertices[static_cast<size_t>(source) * FLOATS_PER_VERTEX];
+                    chunk.vertices.insert(chunk.vertices.end(), p, p + FLOATS_PER_VERTEX);
+                }
+                chunk.indices.push_back(inserted.first->second);
+            }
+        }
+
+        chunk.ComputeBounds();
+        return chunk;
+    }
+
+    // Découpe et écrit le fichier .gechunks ; les morceaux sont produits un par
+    // un pour ne jamais doubler la mémoire du mesh source
+    static bool Cook(const MeshData& mesh, const std::string& outputPath,
+                     VertexFormat format = VertexFormat::QuantizedOct16,
+                     size_t maxTriangles = DEFAULT_CHUNK_TRIANGLES,
+                     const MeshSourceInfo& info = MeshSourceInfo()) {
+        if (mesh.indices.size() < 3) {
+            return false;
+        }
+
+        AABB bounds = mesh.bounds;
+        if (!bounds.IsValid()) {
+            for (size_t i = 0; i + 2 < mesh.vertices.size(); i += FLOATS_PER_VERTEX) {
+                bounds.Expand(glm::vec3(mesh.vertices[i], mesh.vertices[i + 1], mesh.vertices[i + 2]));
+            }
+        }
+
+        ChunkedMeshHeader header;
+        header.sourceHash = info.hash;
+        header.sourceSize = info.size;
+        header.sourceTime = info.time;
+        header.layout = VertexLayout::ForFormat(format, bounds);
+        header.maxChunkTriangles = static_cast<uint32_t>(maxTriangles);
+        for (int i = 0; i < 3; ++i) {
+            header.boundsMin[i] = bounds.min[i];
+            header.boundsMax[i] = bounds.max[i];
+        }
+
+        std::vector<uint32_t> order;
+        std::vector<std::pair<size_t, size_t>> ranges;
+        Partition(mesh, maxTriangles, order, ranges);
+        header.indexSize = maxTriangles * 3 <= 0x10000 ? 2 : 4;
+        header.chunkCount = static_cast<uint32_t>(ranges.size());
+
+        std::error_code error;
+        std::filesystem::path path(outputPath);
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path(), error);
+        }
+
+        // Écriture dans un fichier temporaire puis renommage
+        const std::string temporaryPath = outputPath + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                return false;
+            }
+
+            std::vector<ChunkRecord> records(ranges.size());
+            std::vector<char> data;
+            uint64_t offset = MeshCache::Align(sizeof(ChunkedMeshHeader));
+
+            for (size_t c = 0; c < ranges.size(); ++c) {
+                MeshData chunk = Extract(mesh, order.data() + ranges[c].first, ranges[c].second - ranges[c].first);
+                chunk.Optimize();
+
+                ChunkRecord& record = records[c];
+                for (int i = 0; i < 3; ++i) {
+                    record.boundsMin[i] = chunk.bounds.min[i];
+                    record.boundsMax[i] = chunk.bounds.max[i];
+                }
+                record.vertexCount = static_cast<uint32_t>(chunk.VertexCount());
+                record.indexCount = static_cast<uint32_t>(chunk.indices.size());
+                record.dataOffset = offset;
+                record.vertexBytes = static_cast<uint64_t>(record.vertexCount) * header.layout.stride;
+                record.indexBytes = static_cast<uint64_t>(record.indexCount) * header.indexSize;
+
+                data.assign(record.DataBytes(), 0);
+                header.layout.Encode(chunk.vertices.data(), chunk.VertexCount(), FLOATS_PER_VERTEX, data.data());
+                char* indexOut = data.data() + record.IndexOffset();
+                if (header.indexSize == 2) {
+                    for (size_t k = 0; k < chunk.indices.size(); ++k) {
+                        const uint16_t index = static_cast<uint16_t>(chunk.indices[k]);
+                        std::memcpy(indexOut + k * sizeof(uint16_t), &index, sizeof(uint16_t));
+                    }
+                } else {
+                    std::memcpy(indexOut, chunk.indices.data(), chunk.indices.size() * sizeof(uint32_t));
+                }
+
+                file.seekp(static_cast<std::streamoff>(offset));
+                file.write(data.data(), static_cast<std::streamsize>(data.size()));
+                offset = MeshCache::Align(offset + data.size());
+            }
+
+            header.chunkTableOffset = offset;
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.write(reinterpret_cast<const char*>(records.data()),
+                       static_cast<std::streamsize>(records.size() * sizeof(ChunkRecord)));
+            file.seekp(0);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            if (!file.good()) {
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporaryPath, outputPath, error);
+        return !error;
+    }
+
+    // Chemin du fichier .gechunks à jour pour cette source (cuit si nécessaire), vide en cas d'échec
+    static std::string LoadOrCook(const std::string& sourcePath, VertexFormat format = VertexFormat::QuantizedOct16,
+                                  size_t maxTriangles = DEFAULT_CHUNK_TRIANGLES,
+                                  const std::string& cacheDir = "cache") {
+        MeshSourceInfo info;
+        if (!MeshCache::GetSourceInfo(sourcePath, info)) {
+            LOG_ERROR("Failed to open mesh source: " << sourcePath);
+            return std::string();
+        }
+
+        const std::string cachePath = MeshCache::CachePath(sourcePath, format, cacheDir, ".gechunks");
+        ChunkedMeshHeader header;
+        if (ReadHeader(cachePath, header) && header.layout.format == format &&
+            header.maxChunkTriangles == maxTriangles) {
+            MeshSourceInfo stored;
+            stored.hash = header.sourceHash;
+            stored.size = header.sourceSize;
+            stored.time = header.sourceTime;
+            if (MeshCache::IsUpToDate(stored, sourcePath, info, cachePath, offsetof(ChunkedMeshHeader, sourceTime))) {
+                return cachePath;
+            }
+        }
+
+        MappedFile source(sourcePath);
+        MeshData mesh;
+        if (!source.IsOpen() || !OBJLoader::ParseOBJ(source.Data(), source.Size(), mesh)) {
+            LOG_ERROR("Failed to parse mesh source: " << sourcePath);
+            return std::string();
+        }
+        info.hash = HashBytes(source.Data(), source.Size());
+        LOG_INFO("Cooking chunked mesh: " << sourcePath);
+
+        if (!Cook(mesh, cachePath, format, maxTriangles, info)) {
+            LOG_ERROR("Failed to write chunked mesh: " << cachePath);
+            return std::string();
+        }
+        return cachePath;
+    }
+
+    static bool ReadHeader(const std::string& path, ChunkedMeshHeader& header) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            return false;
+        }
+        return std::memcmp(header.magic, "GECH", 4) == 0 && header.version == CHUNKED_MESH_VERSION;
+    }
+};
+
+// ============================================
+// MeshStreamer - Résidence des morceaux d'un mesh découpé
+// ============================================
+// Seuls les morceaux proches du spectateur, ou visibles et pas trop loin,
+// restent sur le GPU. Les morceaux manquants sont lus sur le ThreadPool puis
+// envoyés au GPU par Update, dans un budget d'octets par appel. Les positions
+// et le frustum sont en espace objet (frustum construit avec
+// projection * vue * modèle). En mode headless aucun appel OpenGL n'est fait :
+// un morceau lu devient résident sans être envoyé, ce qui permet de tester
+// les décisions de résidence et les lectures sans contexte.
+struct StreamingSettings {
+    float loadRadius = 5.0f;        // Chargé dans ce rayon, visible ou non
+    float viewDistance = 50.0f;     // Chargé s'il est visible et plus proche
+    float hysteresis = 1.25f;       // Gardé jusqu'à distance * hysteresis
+    size_t memoryBudget = 256 * 1024 * 1024; // Octets résidents au plus (GPU)
+    size_t maxPendingReads = 8;
+    size_t uploadBudget = 4 * 1024 * 1024;   // Octets envoyés au plus par Update
+};
+
+struct StreamingStats {
+    uint32_t residentChunks = 0;
+    uint32_t pendingChunks = 0;     // En lecture ou en attente d'envoi
+    uint64_t residentBytes = 0;
+    uint64_t bytesRead = 0;
+    uint32_t reads = 0;
+    uint32_t evictions = 0;
+};
+
+enum class ChunkState : uint8_t {
+    Unloaded,
+    Reading,    // Lecture en cours sur un thread de travail
+    Loaded,     // Données en mémoire, en attente d'envoi
+    Resident
+};
+
+class MeshStreamer {
+public:
+    explicit MeshStreamer(ThreadPool& pool, bool headless = false)
+        : m_Pool(pool), m_Headless(headless), m_Completed(std::make_shared<CompletedReads>()) {}
+
+    ~MeshStreamer() {
+        if (m_Headless) {
+            Close();
+        }
+    }
+
+    MeshStreamer(const MeshStreamer&) = delete;
+    MeshStreamer& operator=(const MeshStreamer&) = delete;
+
+    bool Open(const std::string& path) {
+        Close();
+        ChunkedMeshHeader header;
+        if (!MeshChunker::ReadHeader(path, header) || header.chunkCount == 0) {
+            return false;
+        }
+
+        std::ifstream file(path, std::ios::binary);
+        std::vector<ChunkRecord> records(header.chunkCount);
+        file.seekg(static_cast<std::streamoff>(header.chunkTableOffset));
+        if (!file.read(reinterpret_cast<char*>(records.data()),
+                       static_cast<std::streamsize>(records.size() * sizeof(ChunkRecord)))) {
+            return false;
+        }
+
+        m_Path = path;
+        m_Header = header;
+        m_Chunks.resize(records.size());
+        for (size_t i = 0; i < records.size(); ++i) {
+            m_Chunks[i].record = records[i];
+            m_Chunks[i].bounds = records[i].Bounds();
+        }
+        return true;
+    }
+
+    // Libère tous les morceaux (à appeler tant que le contexte OpenGL existe)
+    void Close() {
+        for (auto& chunk : m_Chunks) {
+            Evict(chunk);
+        }
+        m_Chunks.clear();
+        m_Stats = StreamingStats();
+    }
+
+    // Une fois par frame : récupère les lectures terminées, décide de la
+    // résidence, lance les lectures et envoie au GPU dans le budget
+    void Update(const glm::vec3& viewerPosition, const Frustum& frustum) {
+        CollectReads();
+
+        // Priorité : 0 = proche, 1 = visible, 2 = à garder seulement
+        struct Candidate {
+            uint32_t index;
+            int category;
+            float distance;
+        };
+        std::vector<Candidate> candidates;
+        candidates.reserve(m_Chunks.size());
+        const float keepRadius = m_Settings.loadRadius * m_Settings.hysteresis;
+        const float keepDistance = m_Settings.viewDistance * m_Settings.hysteresis;
+
+        for (uint32_t i = 0; i < m_Chunks.size(); ++i) {
+            Chunk& chunk = m_Chunks[i];
+            const float distance = Distance(chunk.bounds, viewerPosition);
+            const bool visible = frustum.Intersects(chunk.bounds);
+            chunk.visible = visible;
+
+            int category = -1;
+            if (distance <= m_Settings.loadRadius) {
+                category = 0;
+            } else if (visible && distance <= m_Settings.viewDistance) {
+                category = 1;
+            } else if (chunk.state != ChunkState::Unloaded && (distance <= keepRadius || (visible && distance <= keepDistance))) {
+                category = 2;
+            }
+            if (category >= 0) {
+                candidates.push_back({i, category, distance});
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return a.category != b.category ? a.category < b.category : a.distance < b.distance;
+        });
+
+        // Les plus prioritaires tant que le budget le permet
+        for (auto& chunk : m_Chunks) {
+            chunk.wanted = false;
+        }
+        uint64_t budgetUsed = 0;
+        for (const Candidate& candidate : candidates) {
+            const uint64_t bytes = m_Chunks[candidate.index].record.GpuBytes();
+            if (m_Settings.memoryBudget != 0 && budgetUsed + bytes > m_Settings.memoryBudget) {
+                break;
+            }
+            budgetUsed += bytes;
+            m_Chunks[candidate.index].wanted = true;
+        }
+
+        for (auto& chunk : m_Chunks) {
+            if (!chunk.wanted && chunk.state != ChunkState::Unloaded) {
+                Evict(chunk);
+                ++m_Stats.evictions;
+            }
+        }
+
+        // Lectures, par priorité
+        for (const Candidate& candidate : candidates) {
+            if (m_PendingReads >= m_Settings.maxPendingReads) {
+                break;
+            }
+            Chunk& chunk = m_Chunks[candidate.index];
+            if (chunk.wanted && chunk.state == ChunkState::Unloaded) {
+                IssueRead(candidate.index);
+            }
+        }
+
+        // Envois, par priorité ; au moins un par appel
+        uint64_t uploaded = 0;
+        for (const Candidate& candidate : candidates) {
+            Chunk& chunk = m_Chunks[candidate.index];
+            if (chunk.state != ChunkState::Loaded) {
+                continue;
+            }
+            if (uploaded > 0 && m_Settings.uploadBudget != 0 &&
+                uploaded + chunk.record.GpuBytes() > m_Settings.uploadBudget) {
+                break;
+            }
+            MakeResident(chunk);
+            uploaded += chunk.record.GpuBytes();
+        }
+
+        RefreshStats();
+    }
+
+    // Dessine les morceaux résidents visibles (frustum en espace objet)
+    void Draw(Shader& shader, const Frustum& frustum) const {
+        shader.SetVertexLayout(m_Header.layout);
+        for (const auto& chunk : m_Chunks) {
+            if (chunk.state == ChunkState::Resident && frustum.Intersects(chunk.bounds)) {
+                chunk.mesh.Draw();
+            }
+        }
+    }
+
+    bool HasPendingReads() const { return m_PendingReads > 0; }
+
+    StreamingSettings& Settings() { return m_Settings; }
+    const StreamingStats& Stats() const { return m_Stats; }
+
+    size_t ChunkCount() const { return m_Chunks.size(); }
+    const AABB& ChunkBounds(size_t index) const { return m_Chunks[index].bounds; }
+    ChunkState GetChunkState(size_t index) const { return m_Chunks[index].state; }
+    AABB Bounds() const {
+        return AABB(glm::vec3(m_Header.boundsMin[0], m_Header.boundsMin[1], m_Header.boundsMin[2]),
+                    glm::vec3(m_Header.boundsMax[0], m_Header.boundsMax[1], m_Header.boundsMax[2]));
+    }
+
+private:
+    struct Chunk {
+        ChunkRecord record;
+        AABB bounds;
+        ChunkState state = ChunkState::Unloaded;
+        uint32_t generation = 0;    // Incrémenté à chaque éviction : les lectures périmées sont ignorées
+        bool wanted = false;
+        bool visible = false;
+        std::vector<char> data;     // État Loaded uniquement
+        MeshData mesh;              // État Resident (buffers GPU)
+    };
+
+    struct ReadResult {
+        uint32_t index;
+        uint32_t generation;
+        bool ok;
+        std::vector<char> data;
+    };
+
+    // Partagé avec les lectures en cours, qui peuvent survivre au streamer
+    struct CompletedReads {
+        std::mutex mutex;
+        std::vector<ReadResult> results;
+    };
+
+    static float Distance(const AABB& box, const glm::vec3& point) {
+        const glm::vec3 closest = glm::clamp(point, box.min, box.max);
+        return glm::length(point - closest);
+    }
+
+    void IssueRead(uint32_t index) {
+        Chunk& chunk = m_Chunks[index];
+        chunk.state = ChunkState::Reading;
+        ++m_PendingReads;
+        ++m_Stats.reads;
+
+        const std::string path = m_Path;
+        const uint64_t offset = chunk.record.dataOffset;
+        const uint64_t bytes = chunk.record.DataBytes();
+        const uint32_t generation = chunk.generation;
+        std::shared_ptr<CompletedReads> completed = m_Completed;
+
+        m_Pool.Submit([=] {
+            ReadResult result{index, generation, false, std::vector<char>(bytes)};
+            std::ifstream file(path, std::ios::binary);
+            file.seekg(static_cast<std::streamoff>(offset));
+            result.ok = static_cast<bool>(file.read(result.data.data(), static_cast<std::streamsize>(bytes)));
+
+            std::lock_guard<std::mutex> lock(completed->mutex);
+            completed->results.push_back(std::move(result));
+        });
+    }
+
+    void CollectReads() {
+        std::vector<ReadResult> results;
+        {
+            std::lock_guard<std::mutex> lock(m_Completed->mutex);
+            results.swap(m_Completed->results);
+        }
+
+        for (auto& result : results) {
+            --m_PendingReads;
+            if (result.index >= m_Chunks.size()) {
+                continue;
+            }
+            Chunk& chunk = m_Chunks[result.index];
+            if (chunk.generation != result.generation || chunk.state != ChunkState::Reading) {
+                continue;
+            }
+            if (!result.ok) {
+                LOG_ERROR("Failed to read mesh chunk " << result.index << " from " << m_Path);
+                chunk.state = ChunkState::Unloaded;
+                continue;
+            }
+            m_Stats.bytesRead += result.data.size();
+            chunk.data = std::move(result.data);
+            chunk.state = ChunkState::Loaded;
+        }
+    }
+
+    void MakeResident(Chunk& chunk) {
+        if (!m_Headless) {
+            chunk.mesh.bounds = chunk.bounds;
+            chunk.mesh.format = m_Header.layout.format;
+            chunk.mesh.Upload(chunk.data.data(), static_cast<size_t>(chunk.record.vertexBytes),
+                              chunk.data.data() + chunk.record.IndexOffset(), chunk.record.indexCount,
+                              m_Header.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, m_Header.layout);
+        }
+        std::vector<char>().swap(chunk.data);
+        chunk.state = ChunkState::Resident;
+    }
+
+    void Evict(Chunk& chunk) {
+        if (chunk.state == ChunkState::Resident && !m_Headless) {
+            chunk.mesh.Cleanup();
+        }
+        std::vector<char>().swap(chunk.data);
+        ++chunk.generation;
+        chunk.state = ChunkState::Unloaded;
+    }
+
+    void RefreshStats() {
+        m_Stats.residentChunks = 0;
+        m_Stats.pendingChunks = 0;
+        m_Stats.residentBytes = 0;
+        for (const auto& chunk : m_Chunks) {
+            if (chunk.state == ChunkState::Resident) {
+                ++m_Stats.residentChunks;
+                m_Stats.residentBytes += chunk.record.GpuBytes();
+            } else if (chunk.state != ChunkState::Unloaded) {
+                ++m_Stats.pendingChunks;
+            }
+        }
+    }
+
+    ThreadPool& m_Pool;
+    bool m_Headless;
+    std::string m_Path;
+    ChunkedMeshHeader m_Header;
+    std::vector<Chunk> m_Chunks;
+    std::shared_ptr<CompletedReads> m_Completed;
+    size_t m_PendingReads = 0;
+    StreamingSettings m_Settings;
+    StreamingStats m_Stats;
+};
@@ -0,0 +1,345 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+#include "Log.h"
+
+// Compteurs par frame (remis à zéro à chaque EndFrame), puis jauges (gardent leur valeur)
+enum MetricCounter : uint32_t {
+    METRIC_DRAW_CALLS,
+    METRIC_TRIANGLES,
+    METRIC_UPLOAD_BYTES,   // Octets envoyés dans des buffers GPU
+    METRIC_ALLOCATIONS,    // operator new, tous threads (voir GAMEENGINE_COUNT_ALLOCATIONS)
+    METRIC_ENTITIES,
+    METRIC_COMPONENTS,
+    METRIC_FRAME_ARENA_BYTES,   // Octets pris dans la FrameArena du moteur
+    METRIC_COUNT
+};
+
+const uint32_t METRIC_FIRST_GAUGE = METRIC_ENTITIES;
+
+// Phases de GameEngine::Run
+enum FramePhase : uint32_t {
+    PHASE_EVENTS,
+    PHASE_UPLOADS,
+    PHASE_INPUT,
+    PHASE_UPDATE,
+    PHASE_RENDER,
+    PHASE_SWAP,
+    PHASE_COUNT
+};
+
+inline const char* MetricCounterName(uint32_t counter) {
+    static const char* names[METRIC_COUNT] = {"draw_calls", "triangles", "upload_bytes", "allocations",
+                                              "entities", "components", "frame_arena_bytes"};
+    return counter < METRIC_COUNT ? names[counter] : "unknown";
+}
+
+inline const char* FramePhaseName(uint32_t phase) {
+    static const char* names[PHASE_COUNT] = {"events", "uploads", "input", "update", "render", "swap"};
+    return phase < PHASE_COUNT ? names[phase] : "unknown";
+}
+
+// ============================================
+// DurationHistogram - Répartition de durées sur toute une session
+// ============================================
+// Cases de 0,1 ms jusqu'à 250 ms (au-delà : une case de débordement) ; la
+// mémoire reste fixe quelle que soit la durée du run. Les percentiles sont
+// donnés à la résolution d'une case, le maximum est exact.
+class DurationHistogram {
+public:
+    static constexpr double BUCKET_MILLISECONDS = 0.1;
+    static constexpr size_t BUCKET_COUNT = 2500;
+
+    void Add(double milliseconds) {
+        const size_t bucket = static_cast<size_t>(std::max(milliseconds, 0.0) / BUCKET_MILLISECONDS);
+        ++m_Buckets[std::min(bucket, BUCKET_COUNT)];
+        ++m_Count;
+        m_Total += milliseconds;
+        m_Max = std::max(m_Max, milliseconds);
+    }
+
+    // Borne haute de la case contenant le percentile p (0..100)
+    double Percentile(double p) const {
+        if (m_Count == 0) {
+            return 0.0;
+        }
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(m_Count * p / 100.0)));
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+            seen += m_Buckets[bucket];
+            if (seen >= rank) {
+                return std::min((bucket + 1) * BUCKET_MILLISECONDS, m_Max);
+            }
+        }
+        return m_Max;
+    }
+
+    uint64_t Count() const { return m_Count; }
+    double Mean() const { return m_Count ? m_Total / m_Count : 0.0; }
+    double Max() const { return m_Max; }
+
+    void Reset() { *this = DurationHistogram(); }
+
+private:
+    std::array<uint64_t, BUCKET_COUNT + 1> m_Buckets{};
+    uint64_t m_Count = 0;
+    double m_Total = 0.0;
+    double m_Max = 0.0;
+};
+
+// Une frame de l'historique
+struct FrameSample {
+    uint64_t frame = 0;
+    float frameMilliseconds = 0.0f;              // Intervalle complet, attente comprise
+    float phaseMilliseconds[PHASE_COUNT] = {};
+    uint64_t counters[METRIC_COUNT] = {};
+};
+
+// ============================================
+// Metrics - Registre des mesures de performance
+// ============================================
+// Le moteur y inscrit la durée de chaque frame et de ses phases, le nombre
+// d'entités et de components ; les appels de dessin, les triangles et les
+// octets envoyés au GPU sont comptés là où ils ont lieu (Add, sans verrou,
+// depuis n'importe quel thread). EndFrame fige la frame : histogrammes sur
+// toute la session, totaux et maxima par compteur, et un historique des
+// dernières frames. Tout est interrogeable pendant le run et peut être écrit
+// en CSV (historique) ou JSON (bilan) à la fin, pour les longs runs d'endurance.
+class Metrics {
+public:
+    static Metrics& Get() {
+        static Metrics metrics;
+        return metrics;
+    }
+
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    // ---------- Pendant la frame ----------
+
+    void Add(MetricCounter counter, uint64_t value = 1) {
+        m_Current[counter].fetch_add(value, std::memory_order_relaxed);
+    }
+
+    void Set(MetricCounter counter, uint64_t value) {
+        m_Current[counter].store(value, std::memory_order_relaxed);
+    }
+
+    // Valeur de la frame en cours
+    uint64_t GetCounter(MetricCounter counter) const {
+        return m_Current[counter].load(std::memory_order_relaxed);
+    }
+
+    void AddPhase(FramePhase phase, double milliseconds) { m_Phases[phase] += milliseconds; }
+
+    // Clôt la frame (thread principal seulement)
+    void EndFrame(double frameMilliseconds) {
+        FrameSample sample;
+        sample.frame = m_FrameCount++;
+        sample.frameMilliseconds = static_cast<float>(frameMilliseconds);
+        m_FrameTimes.Add(frameMilliseconds);
+        for (uint32_t phase = 0; phase < PHASE_COUNT; ++phase) {
+            sample.phaseMilliseconds[phase] = static_cast<float>(m_Phases[phase]);
+            m_PhaseTimes[phase].Add(m_Phases[phase]);
+            m_Phases[phase] = 0.0;
+        }
+        for (uint32_t counter = 0; counter < METRIC_COUNT; ++counter) {
+            const uint64_t value = counter < METRIC_FIRST_GAUGE
+                                       ? m_Current[counter].exchange(0, std::memory_order_relaxed)
+                                       : m_Current[counter].load(std::memory_order_relaxed);
+            sample.counters[counter] = value;
+            m_Totals[counter] += value;
+            m_Maxima[counter] = std::max(m_Maxima[counter], value);
+        }
+
+        if (m_HistorySize > 0) {
+            if (m_History.size() < m_HistorySize) {
+                m_History.push_back(sample);
+            } else {
+                m_History[m_HistoryNext] = sample;
+            }
+            m_HistoryNext = (m_HistoryNext + 1) % m_HistorySize;
+        }
+        m_Last = sample;
+    }
+
+    // ---------- Requêtes ----------
+
+    uint64_t FrameCount() const { return m_FrameCount; }
+    const FrameSample& GetLastFrame() const { return m_Last; }
+    const DurationHistogram& GetFrameTimes() const { return m_FrameTimes; }
+    const DurationHistogram& GetPhaseTimes(FramePhase phase) const { return m_PhaseTimes[phase]; }
+    uint64_t GetCounterTotal(MetricCounter counter) const { return m_Totals[counter]; }
+    uint64_t GetCounterMax(MetricCounter counter) const { return m_Maxima[counter]; }
+    double GetCounterAverage(MetricCounter counter) const {
+        return m_FrameCount ? static_cast<double>(m_Totals[counter]) / m_FrameCount : 0.0;
+    }
+
+    // Dernières frames, de la plus ancienne à la plus récente
+    std::vector<FrameSample> GetHistory() const {
+        std::vector<FrameSample> history;
+        history.reserve(m_History.size());
+        const size_t start = m_History.size() < m_HistorySize ? 0 : m_HistoryNext;
+        for (size_t i = 0; i < m_History.size(); ++i) {
+            history.push_back(m_History[(start + i) % m_History.size()]);
+        }
+        return history;
+    }
+
+    // Nombre de frames gardées pour le CSV (0 : aucun historique)
+    void SetHistorySize(size_t frames) {
+        m_HistorySize = frames;
+        m_History.clear();
+        m_HistoryNext = 0;
+    }
+
+    void Reset() {
+        for (auto& counter : m_Current) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        m_Phases.fill(0.0);
+        m_FrameTimes.Reset();
+        for (auto& histogram : m_PhaseTimes) {
+            histogram.Reset();
+        }
+        m_Totals.fill(0);
+        m_Maxima.fill(0);
+        m_History.clear();
+        m_HistoryNext = 0;
+        m_FrameCount = 0;
+        m_Last = FrameSample();
+    }
+
+    // ---------- Export ----------
+
+    // Une ligne par frame de l'historique
+    bool WriteCSV(const std::string& path) const {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_ERROR("Failed to write metrics: " << path);
+            return false;
+        }
+        file << "frame,frame_ms";
+        for (uint32_t phase = 0; phase < PHASE_COUNT; ++phase) {
+            file << "," << FramePhaseName(phase) << "_ms";
+        }
+        for (uint32_t counter = 0; counter < METRIC_COUNT; ++counter) {
+            file << "," << MetricCounterName(counter);
+        }
+        file << "\n";
+        for (const FrameSample& sample : GetHistory()) {
+            file << sample.frame << "," << sample.frameMilliseconds;
+            for (float milliseconds : sample.phaseMilliseconds) {
+                file << "," << milliseconds;
+            }
+            for (uint64_t value : sample.counters) {
+                file << "," << value;
+            }
+            file << "\n";
+        }
+        return file.good();
+    }
+
+    // Bilan de la session : percentiles des durées, totaux et maxima des compteurs
+    bool WriteJSON(const std::string& path) const {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_ERROR("Failed to write metrics: " << path);
+            return false;
+        }
+        file << "{\n  \"frames\": " << m_FrameCount << ",\n";
+        file << "  \"frame_ms\": " << HistogramJSON(m_FrameTimes) << ",\n";
+        file << "  \"phases_ms\": {";
+        for (uint32_t phase = 0; phase < PHASE_COUNT; ++phase) {
+            file << (phase ? ", " : "") << "\n    \"" << FramePhaseName(phase) << "\": " << HistogramJSON(m_PhaseTimes[phase]);
+        }
+        file << "\n  },\n  \"counters\": {";
+        for (uint32_t counter = 0; counter < METRIC_COUNT; ++counter) {
+            const MetricCounter id = static_cast<MetricCounter>(counter);
+            file << (counter ? ", " : "") << "\n    \"" << MetricCounterName(counter) << "\": {\"total\": " << m_Totals[counter]
+                 << ", \"avg\": " << GetCounterAverage(id) << ", \"max\": " << m_Maxima[counter]
+                 << ", \"last\": " << m_Last.counters[counter] << "}";
+        }
+        file << "\n  }\n}\n";
+        return file.good();
+    }
+
+    // Compté par les operator new de GAMEENGINE_COUNT_ALLOCATIONS
+    static void CountAllocation() {
+        Get().Add(METRIC_ALLOCATIONS);
+    }
+
+private:
+    Metrics() = default;
+
+    static std::string HistogramJSON(const DurationHistogram& histogram) {
+        return "{\"avg\": " + std::to_string(histogram.Mean()) + ", \"p50\": " + std::to_string(histogram.Percentile(50.0)) +
+               ", \"p95\": " + std::to_string(histogram.Percentile(95.0)) + ", \"p99\": " +
+               std::to_string(histogram.Percentile(99.0)) + ", \"max\": " + std::to_string(histogram.Max()) + "}";
+    }
+
+    std::array<std::atomic<uint64_t>, METRIC_COUNT> m_Current{};
+    std::array<double, PHASE_COUNT> m_Phases{};
+    DurationHistogram m_FrameTimes;
+    std::array<DurationHistogram, PHASE_COUNT> m_PhaseTimes;
+    std::array<uint64_t, METRIC_COUNT> m_Totals{};
+    std::array<uint64_t, METRIC_COUNT> m_Maxima{};
+    std::vector<FrameSample> m_History;
+    size_t m_HistorySize = 18000;   // 5 minutes à 60 FPS
+    size_t m_HistoryNext = 0;
+    uint64_t m_FrameCount = 0;
+    FrameSample m_Last;
+};
+
+// ============================================
+// MetricsTimer - Ajoute la durée d'un bloc à une phase
+// ============================================
+class MetricsTimer {
+public:
+    explicit MetricsTimer(FramePhase phase) : m_Phase(phase), m_Start(std::chrono::steady_clock::now()) {}
+
+    ~MetricsTimer() {
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_Start;
+        Metrics::Get().AddPhase(m_Phase, elapsed.count());
+    }
+
+    MetricsTimer(const MetricsTimer&) = delete;
+    MetricsTimer& operator=(const MetricsTimer&) = delete;
+
+private:
+    FramePhase m_Phase;
+    std::chrono::steady_clock::time_point m_Start;
+};
+
+// Remplace operator new / delete pour compter les allocations (METRIC_ALLOCATIONS).
+// À placer une seule fois, dans le fichier de l'application (hors de tout namespace).
+// GCC prend à tort le free de ces remplacements pour un mauvais appariement avec new.
+#if defined(__GNUC__) && !defined(__clang__)
+#define GAMEENGINE_ALLOCATION_PRAGMA(text) _Pragma(text)
+#else
+#define GAMEENGINE_ALLOCATION_PRAGMA(text)
+#endif
+
+#define GAMEENGINE_COUNT_ALLOCATIONS()                                     \
+    GAMEENGINE_ALLOCATION_PRAGMA("GCC diagnostic push")                    \
+    GAMEENGINE_ALLOCATION_PRAGMA("GCC diagnostic ignored \"-Wpragmas\"")   \
+    GAMEENGINE_ALLOCATION_PRAGMA("GCC diagnostic ignored \"-Wmismatched-new-delete\"") \
+    void* operator new(std::size_t size) {                                 \
+        Metrics::CountAllocation();                                        \
+        if (void* memory = std::malloc(size ? size : 1)) {                 \
+            return memory;                                                 \
+        }                                                                  \
+        throw std::bad_alloc();                                            \
+    }                                                                      \
+    void operator delete(void* memory) noexcept { std::free(memory); }     \
+    void operator delete(void* memory, std::size_t) noexcept { std::free(memory); } \
+    GAMEENGINE_ALLOCATION_PRAGMA("GCC diagnostic pop")
@@ -1,23 +1,99 @@
 #pragma once
 #include <vector>
 #include <string>
-#include <fstream>
-#include <sstream>
-#include <iostream>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <charconv>
+#include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include "Bounds.h"
+#include "Log.h"
+#include "MappedFile.h"
+#include "Metrics.h"
+#include "MeshOptimizer.h"
+#include "VertexLayout.h"
+
+// Nombre de floats par vertex dans MeshData::vertices
+const unsigned int FLOATS_PER_VERTEX = 8;
 
 // ============================================
 // Mesh - Structure pour stocker un modèle 3D
 // ============================================
 struct MeshData {
-    std::vector<float> vertices;  // Position + Normale (x,y,z, nx,ny,nz)
+    std::vector<float> vertices;  // Position + Normale + UV (x,y,z, nx,ny,nz, u,v)
     std::vector<unsigned int> indices;
+    AABB bounds;                  // Boîte englobante en espace objet
     
     unsigned int VAO = 0;
     unsigned int VBO = 0;
     unsigned int EBO = 0;
+    unsigned int indexCount = 0;              // Nombre d'indices envoyés au GPU
+    unsigned int indexType = GL_UNSIGNED_INT; // GL_UNSIGNED_SHORT si le mesh a au plus 65536 vertices
+    size_t gpuBytes = 0;                      // Taille des buffers GPU (VBO + EBO)
+    VertexFormat format = VertexFormat::Float32; // Encodage demandé pour SetupMesh
+    VertexLayout layout;                      // Disposition des vertices dans le VBO
+
+    size_t VertexCount() const {
+        return vertices.size() / FLOATS_PER_VERTEX;
+    }
+
+    void ComputeBounds() {
+        bounds = AABB();
+        for (size_t i = 0; i + 2 < vertices.size(); i += FLOATS_PER_VERTEX) {
+            bounds.Expand(glm::vec3(vertices[i], vertices[i + 1], vertices[i + 2]));
+        }
+    }
     
+    // Réordonne triangles et vertices pour le cache GPU (à faire avant SetupMesh)
+    void Optimize(bool verbose = false) {
+        VertexCacheStats before = MeshOptimizer::AnalyzeVertexCache(indices, VertexCount());
+        MeshOptimizer::Optimize(vertices, indices, FLOATS_PER_VERTEX);
+
+        if (verbose) {
+            VertexCacheStats after = MeshOptimizer::AnalyzeVertexCache(indices, VertexCount());
+            LOG_INFO("  Vertex cache ACMR: " << before.acmr << " -> " << after.acmr
+                  << ", ATVR: " << before.atvr << " -> " << after.atvr);
+        }
+    }
+
     void SetupMesh() {
+        // Les formats quantifiés sont relatifs à la boîte englobante
+        if (format != VertexFormat::Float32 && !bounds.IsValid()) {
+            ComputeBounds();
+        }
+        const VertexLayout vertexLayout = VertexLayout::ForFormat(format, bounds);
+
+        std::vector<char> encoded;
+        const void* vertexData = vertices.data();
+        size_t vertexBytes = vertices.size() * sizeof(float);
+        if (vertexLayout.IsQuantized()) {
+            encoded.resize(VertexCount() * vertexLayout.stride);
+            vertexLayout.Encode(vertices.data(), VertexCount(), FLOATS_PER_VERTEX, encoded.data());
+            vertexData = encoded.data();
+            vertexBytes = encoded.size();
+        }
+
+        if (VertexCount() <= 0x10000) {
+            // Indices 16 bits : moitié moins de mémoire et de bande passante
+            std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+            Upload(vertexData, vertexBytes, shortIndices.data(),
+                   static_cast<unsigned int>(shortIndices.size()), GL_UNSIGNED_SHORT, vertexLayout);
+        } else {
+            Upload(vertexData, vertexBytes, indices.data(),
+                   static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, vertexLayout);
+        }
+    }
+
+    // Envoie au GPU des données déjà formatées, sans copie intermédiaire
+    // (par exemple directement depuis un fichier projeté en mémoire).
+    // Avec des pointeurs nuls, les buffers sont seulement réservés et remplis
+    // plus tard par morceaux (glBufferSubData, voir AssetLoader).
+    void Upload(const void* vertexData, size_t vertexBytes,
+                const void* indexData, unsigned int count, unsigned int type,
+                const VertexLayout& vertexLayout) {
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
         glGenBuffers(1, &EBO);
@@ -25,165 +101,442 @@ struct MeshData {
         glBindVertexArray(VAO);
 
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), &vertices[0], GL_STATIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, vertexBytes, vertexData, GL_STATIC_DRAW);
 
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
-
-        // Position attribute
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * IndexSize(type), indexData, GL_STATIC_DRAW);
 
-        // Normal attribute
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+        // Position, normal and texture coordinate attributes
+        vertexLayout.Apply();
 
         glBindVertexArray(0);
+
+        if (vertexData) {
+            Metrics::Get().Add(METRIC_UPLOAD_BYTES, vertexBytes);
+        }
+        if (indexData) {
+            Metrics::Get().Add(METRIC_UPLOAD_BYTES, count * IndexSize(type));
+        }
+
+        layout = vertexLayout;
+        indexCount = count;
+        indexType = type;
+        gpuBytes = vertexBytes + count * IndexSize(type);
+    }
+
+    static size_t IndexSize(unsigned int type) {
+        return (type == GL_UNSIGNED_SHORT) ? sizeof(uint16_t) : sizeof(uint32_t);
     }
     
     void Draw() const {
         glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
+        glDrawElements(GL_TRIANGLES, indexCount, indexType, 0);
         glBindVertexArray(0);
+        Metrics::Get().Add(METRIC_DRAW_CALLS);
+        Metrics::Get().Add(METRIC_TRIANGLES, indexCount / 3);
     }
     
     void Cleanup() {
         if (VAO != 0) glDeleteVertexArrays(1, &VAO);
         if (VBO != 0) glDeleteBuffers(1, &VBO);
         if (EBO != 0) glDeleteBuffers(1, &EBO);
+        VAO = VBO = EBO = 0;
+        indexCount = 0;
+        gpuBytes = 0;
     }
 };
 
 // ============================================
 // OBJLoader - Charge des fichiers .obj
 // ============================================
+// Le fichier est projeté en mémoire puis analysé par un tokenizer écrit à
+// la main (std::from_chars) en deux passes : la première compte les
+// éléments pour tout réserver, la seconde remplit les tableaux sans
+// allocation supplémentaire. Supporte les faces à n côtés (triangulées en
+// éventail), les indices négatifs et les coordonnées de texture.
 class OBJLoader {
 public:
     static bool LoadOBJ(const std::string& filepath, MeshData& mesh) {
-        std::ifstream file(filepath);
-        if (!file.is_open()) {
-            std::cerr << "Failed to open OBJ file: " << filepath << std::endl;
+        if (!ParseOBJ(filepath, mesh)) {
             return false;
         }
 
-        std::vector<glm::vec3> temp_vertices;
-        std::vector<glm::vec3> temp_normals;
-        std::vector<unsigned int> vertex_indices;
-        std::vector<unsigned int> normal_indices;
+        mesh.Optimize(true);
+        mesh.SetupMesh();
+        return true;
+    }
 
-        std::string line;
-        while (std::getline(file, line)) {
-            std::istringstream iss(line);
-            std::string prefix;
-            iss >> prefix;
+    // Analyse le fichier sans rien envoyer au GPU
+    static bool ParseOBJ(const std::string& filepath, MeshData& mesh) {
+        MappedFile file;
+        if (!file.Open(filepath)) {
+            LOG_ERROR("Failed to open OBJ file: " << filepath);
+            return false;
+        }
+
+        if (!ParseOBJ(file.Data(), file.Size(), mesh)) {
+            LOG_ERROR("Failed to parse OBJ file: " << filepath);
+            return false;
+        }
+
+        LOG_INFO("Loaded OBJ: " << filepath);
+        LOG_INFO("  Vertices: " << mesh.VertexCount());
+        LOG_INFO("  Triangles: " << mesh.indices.size() / 3);
+        return true;
+    }
+
+    // Analyse un OBJ déjà en mémoire (data n'a pas besoin d'être terminé par '\0')
+    static bool ParseOBJ(const char* data, size_t size, MeshData& mesh) {
+        const char* end = data + size;
+
+        // Passe 1 : compter pour réserver
+        size_t positionCount = 0, normalCount = 0, texcoordCount = 0, triangleCount = 0;
+        for (const char* p = data; p < end; p = NextLine(p, end)) {
+            p = SkipSpaces(p, end);
+            if (end - p < 2) {
+                continue;
+            }
+            if (p[0] == 'v') {
+                if (IsSpace(p[1])) ++positionCount;
+                else if (p[1] == 'n') ++normalCount;
+                else if (p[1] == 't') ++texcoordCount;
+            } else if (p[0] == 'f' && IsSpace(p[1])) {
+                size_t corners = CountTokens(p + 1, end);
+                if (corners >= 3) triangleCount += corners - 2;
+            }
+        }
 
-            if (prefix == "v") {
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec3> normals;
+        std::vector<glm::vec2> texcoords;
+        std::vector<Corner> corners; // 3 coins par triangle
+        std::vector<Corner> face;    // Coins de la face en cours
+        positions.reserve(positionCount);
+        normals.reserve(normalCount);
+        texcoords.reserve(texcoordCount);
+        corners.reserve(triangleCount * 3);
+        face.reserve(16);
+
+        // Passe 2 : analyse
+        bool missingNormals = false;
+        for (const char* p = data; p < end; p = NextLine(p, end)) {
+            p = SkipSpaces(p, end);
+            if (end - p < 2) {
+                continue;
+            }
+
+            if (p[0] == 'v' && IsSpace(p[1])) {
                 // Vertex position
-                glm::vec3 vertex;
-                iss >> vertex.x >> vertex.y >> vertex.z;
-                temp_vertices.push_back(vertex);
+                glm::vec3 v(0.0f);
+                p = ParseFloat(p + 1, end, v.x);
+                p = ParseFloat(p, end, v.y);
+                ParseFloat(p, end, v.z);
+                positions.push_back(v);
             }
-            else if (prefix == "vn") {
+            else if (p[0] == 'v' && p[1] == 'n') {
                 // Vertex normal
-                glm::vec3 normal;
-                iss >> normal.x >> normal.y >> normal.z;
-                temp_normals.push_back(normal);
+                glm::vec3 n(0.0f);
+                p = ParseFloat(p + 2, end, n.x);
+                p = ParseFloat(p, end, n.y);
+                ParseFloat(p, end, n.z);
+                normals.push_back(n);
+            }
+            else if (p[0] == 'v' && p[1] == 't') {
+                // Texture coordinate (w ignoré)
+                glm::vec2 t(0.0f);
+                p = ParseFloat(p + 2, end, t.x);
+                ParseFloat(p, end, t.y);
+                texcoords.push_back(t);
             }
-            else if (prefix == "f") {
-                // Face (triangle)
-                std::string vertex1, vertex2, vertex3;
-                iss >> vertex1 >> vertex2 >> vertex3;
+            else if (p[0] == 'f' && IsSpace(p[1])) {
+                // Face : v, v/vt, v//vn ou v/vt/vn
+                face.clear();
+                p = SkipSpaces(p + 1, end);
+                while (p < end && *p != '\n') {
+                    Corner corner;
+                    p = ParseCorner(p, end, corner, positions.size(), texcoords.size(), normals.size());
+                    if (corner.v < 0) {
+                        break;
+                    }
+                    missingNormals |= corner.vn < 0;
+                    face.push_back(corner);
+                    p = SkipSpaces(p, end);
+                }
 
-                // Parse face format: v/vt/vn ou v//vn ou v
-                ParseFace(vertex1, vertex_indices, normal_indices);
-                ParseFace(vertex2, vertex_indices, normal_indices);
-                ParseFace(vertex3, vertex_indices, normal_indices);
+                // Triangulation en éventail
+                for (size_t i = 1; i + 1 < face.size(); ++i) {
+                    corners.push_back(face[0]);
+                    corners.push_back(face[i]);
+                    corners.push_back(face[i + 1]);
+                }
             }
+            // Les autres lignes (o, g, s, usemtl, mtllib, #) sont ignorées
         }
 
-        file.close();
+        if (positions.empty()) {
+            return false;
+        }
 
-        // Si pas de normales, on les génère
-        if (temp_normals.empty()) {
-            temp_normals.resize(temp_vertices.size(), glm::vec3(0.0f));
-            GenerateNormals(temp_vertices, vertex_indices, temp_normals);
+        // Si des normales manquent, on les génère à partir des positions
+        std::vector<glm::vec3> generatedNormals;
+        if (missingNormals) {
+            generatedNormals.resize(positions.size(), glm::vec3(0.0f));
+            GenerateNormals(positions, corners, generatedNormals);
         }
 
-        // Construire le mesh final
-        for (size_t i = 0; i < vertex_indices.size(); i++) {
-            unsigned int vi = vertex_indices[i];
-            unsigned int ni = (i < normal_indices.size()) ? normal_indices[i] : vi;
+        // Construire le mesh final : un vertex par triplet (position, uv, normale) unique
+        const size_t base = mesh.VertexCount();
+        CornerTable table(std::max(positions.size(), std::max(texcoords.size(), normals.size())));
+        mesh.indices.reserve(mesh.indices.size() + corners.size());
+        for (const Corner& c : corners) {
+            mesh.indices.push_back(static_cast<unsigned int>(base + table.Insert(c)));
+        }
 
-            if (vi < temp_vertices.size()) {
-                glm::vec3 v = temp_vertices[vi];
-                glm::vec3 n = (ni < temp_normals.size()) ? temp_normals[ni] : glm::vec3(0.0f, 1.0f, 0.0f);
+        const std::vector<Corner>& unique = table.Corners();
+        mesh.vertices.resize(mesh.vertices.size() + unique.size() * FLOATS_PER_VERTEX);
 
-                mesh.vertices.push_back(v.x);
-                mesh.vertices.push_back(v.y);
-                mesh.vertices.push_back(v.z);
-                mesh.vertices.push_back(n.x);
-                mesh.vertices.push_back(n.y);
-                mesh.vertices.push_back(n.z);
+        float* out = mesh.vertices.data() + base * FLOATS_PER_VERTEX;
+        for (const Corner& c : unique) {
+            const glm::vec3& v = positions[c.v];
+            const glm::vec3 n = c.vn >= 0 ? normals[c.vn] : generatedNormals[c.v];
+            const glm::vec2 t = c.vt >= 0 ? texcoords[c.vt] : glm::vec2(0.0f);
 
-                mesh.indices.push_back(static_cast<unsigned int>(mesh.indices.size()));
-            }
+            out[0] = v.x; out[1] = v.y; out[2] = v.z;
+            out[3] = n.x; out[4] = n.y; out[5] = n.z;
+            out[6] = t.x; out[7] = t.y;
+            out += FLOATS_PER_VERTEX;
         }
 
-        std::cout << "Loaded OBJ: " << filepath << std::endl;
-        std::cout << "  Vertices: " << temp_vertices.size() << std::endl;
-        std::cout << "  Triangles: " << mesh.indices.size() / 3 << std::endl;
-
-        mesh.SetupMesh();
+        mesh.ComputeBounds();
         return true;
     }
 
 private:
-    static void ParseFace(const std::string& face, 
-                          std::vector<unsigned int>& vertex_indices,
-                          std::vector<unsigned int>& normal_indices) {
-        std::istringstream iss(face);
-        std::string vi, ti, ni;
-
-        // Format: v/vt/vn
-        if (std::getline(iss, vi, '/')) {
-            vertex_indices.push_back(std::stoi(vi) - 1); // OBJ indices start at 1
-
-            if (std::getline(iss, ti, '/')) {
-                // Skip texture coordinate
-                if (std::getline(iss, ni)) {
-                    normal_indices.push_back(std::stoi(ni) - 1);
+    // Indices (base 0) d'un coin de face, -1 si absent
+    struct Corner {
+        int v = -1;
+        int vt = -1;
+        int vn = -1;
+
+        bool operator==(const Corner& o) const { return v == o.v && vt == o.vt && vn == o.vn; }
+    };
+
+    // Table de hachage à adressage ouvert : coin (v, vt, vn) -> indice du vertex unique
+    class CornerTable {
+    public:
+        explicit CornerTable(size_t expected) {
+            size_t capacity = 16;
+            while (capacity < expected * 2) capacity <<= 1;
+            m_Slots.assign(capacity, EMPTY_SLOT);
+            m_Corners.reserve(expected);
+        }
+
+        uint32_t Insert(const Corner& corner) {
+            if ((m_Corners.size() + 1) * 2 > m_Slots.size()) {
+                Grow();
+            }
+
+            const size_t mask = m_Slots.size() - 1;
+            for (size_t i = Hash(corner) & mask;; i = (i + 1) & mask) {
+                uint32_t id = m_Slots[i];
+                if (id == EMPTY_SLOT) {
+                    id = static_cast<uint32_t>(m_Corners.size());
+                    m_Slots[i] = id;
+                    m_Corners.push_back(corner);
+                    return id;
                 }
+                if (m_Corners[id] == corner) {
+                    return id;
+                }
+            }
+        }
+
+        const std::vector<Corner>& Corners() const { return m_Corners; }
+
+    private:
+        static constexpr uint32_t EMPTY_SLOT = 0xFFFFFFFFu;
+
+        std::vector<uint32_t> m_Slots;
+        std::vector<Corner> m_Corners;
+
+        static size_t Hash(const Corner& c) {
+            uint64_t h = static_cast<uint32_t>(c.v) * 0x9E3779B97F4A7C15ull;
+            h ^= static_cast<uint32_t>(c.vt) * 0xC2B2AE3D27D4EB4Full;
+            h ^= static_cast<uint32_t>(c.vn) * 0x165667B19E3779F9ull;
+            return static_cast<size_t>(h ^ (h >> 32));
+        }
+
+        void Grow() {
+            m_Slots.assign(m_Slots.size() * 2, EMPTY_SLOT);
+            const size_t mask = m_Slots.size() - 1;
+            for (uint32_t id = 0; id < m_Corners.size(); ++id) {
+                size_t i = Hash(m_Corners[id]) & mask;
+                while (m_Slots[i] != EMPTY_SLOT) i = (i + 1) & mask;
+                m_Slots[i] = id;
             }
         }
+    };
+
+    static bool IsSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
     }
 
-    static void GenerateNormals(const std::vector<glm::vec3>& vertices,
-                                const std::vector<unsigned int>& indices,
-                                std::vector<glm::vec3>& normals) {
-        // Generate flat normals for each triangle
-        for (size_t i = 0; i < indices.size(); i += 3) {
-            unsigned int i0 = indices[i];
-            unsigned int i1 = indices[i + 1];
-            unsigned int i2 = indices[i + 2];
+    static const char* SkipSpaces(const char* p, const char* end) {
+        while (p < end && IsSpace(*p)) ++p;
+        return p;
+    }
+
+    static const char* NextLine(const char* p, const char* end) {
+        const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+        return newline ? static_cast<const char*>(newline) + 1 : end;
+    }
+
+    static size_t CountTokens(const char* p, const char* end) {
+        size_t count = 0;
+        bool inToken = false;
+        for (; p < end && *p != '\n'; ++p) {
+            bool space = IsSpace(*p);
+            if (!space && !inToken) ++count;
+            inToken = !space;
+        }
+        return count;
+    }
+
+    static const char* ParseFloat(const char* p, const char* end, float& value) {
+        p = SkipSpaces(p, end);
+        if (p < end && *p == '+') ++p;
+
+        // Chemin rapide : notation décimale simple avec au plus 15 chiffres,
+        // représentable exactement en double puis divisée par une puissance de 10 exacte
+        static const double powersOf10[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15
+        };
+        const char* start = p;
+        bool negative = false;
+        if (p < end && *p == '-') { negative = true; ++p; }
+
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int fractionDigits = 0;
+        while (p < end && static_cast<unsigned>(*p - '0') < 10u) {
+            mantissa = mantissa * 10 + static_cast<unsigned>(*p++ - '0');
+            ++digits;
+        }
+        if (p < end && *p == '.') {
+            ++p;
+            while (p < end && static_cast<unsigned>(*p - '0') < 10u) {
+                mantissa = mantissa * 10 + static_cast<unsigned>(*p++ - '0');
+                ++digits;
+                ++fractionDigits;
+            }
+        }
+        if (digits > 0 && digits <= 15 && (p == end || (*p != 'e' && *p != 'E'))) {
+            double result = static_cast<double>(mantissa) / powersOf10[fractionDigits];
+            value = static_cast<float>(negative ? -result : result);
+            return p;
+        }
+
+        // Cas général (exposant, nombreux chiffres, inf/nan)
+        p = start;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto result = std::from_chars(p, end, value);
+        return result.ptr;
+#else
+        // Repli pour les bibliothèques sans from_chars sur les flottants
+        double sign = 1.0;
+        if (p < end && *p == '-') { sign = -1.0; ++p; }
+        double number = 0.0;
+        while (p < end && *p >= '0' && *p <= '9') number = number * 10.0 + (*p++ - '0');
+        if (p < end && *p == '.') {
+            double scale = 0.1;
+            for (++p; p < end && *p >= '0' && *p <= '9'; ++p, scale *= 0.1) number += (*p - '0') * scale;
+        }
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            ++p;
+            int exponentSign = 1, exponent = 0;
+            if (p < end && (*p == '-' || *p == '+')) exponentSign = (*p++ == '-') ? -1 : 1;
+            while (p < end && *p >= '0' && *p <= '9') exponent = exponent * 10 + (*p++ - '0');
+            number *= std::pow(10.0, exponentSign * exponent);
+        }
+        value = static_cast<float>(sign * number);
+        return p;
+#endif
+    }
 
-            if (i0 < vertices.size() && i1 < vertices.size() && i2 < vertices.size()) {
-                glm::vec3 v0 = vertices[i0];
-                glm::vec3 v1 = vertices[i1];
-                glm::vec3 v2 = vertices[i2];
+    // Entier signé en base 10 ; renvoie nullptr si aucun chiffre
+    static const char* ParseInt(const char* p, const char* end, long& value) {
+        bool negative = false;
+        if (p < end && *p == '-') { negative = true; ++p; }
+        const char* digitsStart = p;
+        long result = 0;
+        while (p < end && static_cast<unsigned>(*p - '0') < 10u) {
+            result = result * 10 + (*p++ - '0');
+        }
+        if (p == digitsStart) {
+            return nullptr;
+        }
+        value = negative ? -result : result;
+        return p;
+    }
 
-                glm::vec3 edge1 = v1 - v0;
-                glm::vec3 edge2 = v2 - v0;
-                glm::vec3 normal = glm::normalize(glm::cross(edge1, edge2));
+    // Convertit un indice OBJ (base 1, négatif = relatif à la fin) en base 0
+    static int ResolveIndex(long index, size_t count) {
+        long resolved = index > 0 ? index - 1 : static_cast<long>(count) + index;
+        return (resolved >= 0 && resolved < static_cast<long>(count)) ? static_cast<int>(resolved) : -1;
+    }
+
+    static const char* ParseCorner(const char* p, const char* end, Corner& corner,
+                                   size_t positionCount, size_t texcoordCount, size_t normalCount) {
+        long index = 0;
+        const char* next = ParseInt(p, end, index);
+        if (!next) {
+            // Jeton invalide : passer au jeton suivant
+            while (p < end && !IsSpace(*p) && *p != '\n') ++p;
+            return p;
+        }
+        p = next;
+        corner.v = ResolveIndex(index, positionCount);
+
+        if (p < end && *p == '/') {
+            ++p;
+            if (p < end && *p != '/' && (next = ParseInt(p, end, index))) {
+                corner.vt = ResolveIndex(index, texcoordCount);
+                p = next;
+            }
+            if (p < end && *p == '/') {
+                ++p;
+                if ((next = ParseInt(p, end, index))) {
+                    corner.vn = ResolveIndex(index, normalCount);
+                    p = next;
+                }
+            }
+        }
+        return p;
+    }
 
-                normals[i0] += normal;
-                normals[i1] += normal;
-                normals[i2] += normal;
+    static void GenerateNormals(const std::vector<glm::vec3>& vertices,
+                                const std::vector<Corner>& corners,
+                                std::vector<glm::vec3>& normals) {
+        // Accumuler la normale de chaque triangle sur ses sommets
+        for (size_t i = 0; i + 2 < corners.size(); i += 3) {
+            const glm::vec3& v0 = vertices[corners[i].v];
+            const glm::vec3& v1 = vertices[corners[i + 1].v];
+            const glm::vec3& v2 = vertices[corners[i + 2].v];
+
+            glm::vec3 normal = glm::cross(v1 - v0, v2 - v0);
+            float length = glm::length(normal);
+            if (length > 0.0f) {
+                normal /= length;
+                normals[corners[i].v] += normal;
+                normals[corners[i + 1].v] += normal;
+                normals[corners[i + 2].v] += normal;
             }
         }
 
         // Normalize all normals
         for (auto& n : normals) {
-            n = glm::normalize(n);
+            float length = glm::length(n);
+            n = length > 0.0f ? n / length : glm::vec3(0.0f, 1.0f, 0.0f);
         }
     }
 };
@@ -194,7 +547,17 @@ private:
 class MeshGenerator {
 public:
     static MeshData CreateSphere(float radius = 1.0f, int sectors = 36, int stacks = 18) {
+        MeshData mesh = BuildSphere(radius, sectors, stacks);
+        mesh.Optimize();
+        mesh.SetupMesh();
+        return mesh;
+    }
+
+    // Génère la géométrie de la sphère sans l'envoyer au GPU
+    static MeshData BuildSphere(float radius = 1.0f, int sectors = 36, int stacks = 18) {
         MeshData mesh;
+        mesh.vertices.reserve(static_cast<size_t>(stacks + 1) * (sectors + 1) * FLOATS_PER_VERTEX);
+        mesh.indices.reserve(static_cast<size_t>(stacks) * sectors * 6);
 
         float x, y, z, xy;
         float nx, ny, nz;
@@ -223,6 +586,8 @@ public:
                 mesh.vertices.push_back(nx);
                 mesh.vertices.push_back(ny);
                 mesh.vertices.push_back(nz);
+                mesh.vertices.push_back(static_cast<float>(j) / sectors);
+                mesh.vertices.push_back(static_cast<float>(i) / stacks);
             }
         }
 
@@ -247,7 +612,7 @@ public:
             }
         }
 
-        mesh.SetupMesh();
+        mesh.bounds = AABB(glm::vec3(-radius), glm::vec3(radius));
         return mesh;
     }
 };
\ No newline at end of file
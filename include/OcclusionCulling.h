@@ -0,0 +1,393 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Bounds.h"
+#include "MeshCache.h"
+#include "OBJLoader.h"
+#include "Profiler.h"
+#include "SIMD.h"
+#include "ThreadPool.h"
+
+// ============================================
+// OccluderMesh - Géométrie CPU d'un occulteur
+// ============================================
+// Positions et indices seulement, en espace objet. Un occulteur doit rester à
+// l'intérieur de la surface dessinée, sinon il cache à tort ce qui dépasse
+// juste derrière la silhouette : par défaut le niveau 0 du mesh. Les niveaux
+// simplifiés (QEM) peuvent déborder de la source et ne sont pris que sur
+// demande explicite, pour une géométrie dont on sait qu'elle reste dedans.
+struct OccluderMesh {
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+
+    bool Empty() const { return indices.empty(); }
+    size_t TriangleCount() const { return indices.size() / 3; }
+
+    void Build(const MeshData& mesh) {
+        positions.resize(mesh.VertexCount());
+        for (size_t v = 0; v < positions.size(); ++v) {
+            const float* p = &mesh.vertices[v * FLOATS_PER_VERTEX];
+            positions[v] = glm::vec3(p[0], p[1], p[2]);
+        }
+        indices = mesh.indices;
+    }
+
+    // Niveau d'un mesh cuit (ramené au dernier s'il n'existe pas) ; par défaut le niveau 0
+    void Build(const CookedMesh& cooked, uint32_t level = 0) {
+        positions.clear();
+        indices.clear();
+        if (!cooked.IsOpen() || cooked.Header().lodCount == 0) {
+            return;
+        }
+        level = std::min(level, cooked.Header().lodCount - 1);
+        const CookedMeshLOD& lod = cooked.LODs()[level];
+        const VertexLayout& layout = cooked.Header().layout;
+
+        positions.resize(lod.vertexCount);
+        for (size_t v = 0; v < positions.size(); ++v) {
+            positions[v] = layout.DecodePosition(cooked.VertexData(lod) + v * layout.stride);
+        }
+        indices.resize(lod.indexCount);
+        if (cooked.Header().indexSize == 2) {
+            const uint16_t* source = reinterpret_cast<const uint16_t*>(cooked.IndexData(lod));
+            std::copy(source, source + lod.indexCount, indices.begin());
+        } else {
+            const uint32_t* source = reinterpret_cast<const uint32_t*>(cooked.IndexData(lod));
+            std::copy(source, source + lod.indexCount, indices.begin());
+        }
+    }
+};
+
+struct OcclusionSettings {
+    int width = 256;        // Résolution du tampon de profondeur (multiples de tileWidth / tileHeight)
+    int height = 128;
+    int tileWidth = 64;     // Multiple de 4 (4 pixels par instruction SSE)
+    int tileHeight = 32;
+};
+
+// Compteurs de la frame (remis à zéro par Begin)
+struct OcclusionStats {
+    size_t occluders = 0;
+    size_t occluderTriangles = 0;     // Soumis
+    size_t rasterizedTriangles = 0;   // Après élimination (dos, hors écran, plan proche)
+    size_t testedObjects = 0;
+    size_t culledObjects = 0;
+    double setupMilliseconds = 0.0;   // Transformation des occulteurs
+    double rasterMilliseconds = 0.0;  // Répartition en tuiles + rastérisation
+    double testMilliseconds = 0.0;    // Tests des boîtes
+};
+
+// ============================================
+// OcclusionCuller - Élimination des objets cachés, sur le CPU
+// ============================================
+// Chaque frame : Begin, AddOccluder pour chaque occulteur, Rasterize, puis
+// IsVisible pour les boîtes des objets à dessiner. Les occulteurs sont
+// rastérisés dans un petit tampon de profondeur (1/w, linéaire à l'écran, le
+// plus grand est le plus proche), découpé en tuiles traitées en parallèle,
+// 4 pixels à la fois. Une boîte est cachée si tous les pixels de son
+// rectangle à l'écran sont plus proches que son point le plus proche.
+// Résultat conservatif à la précision du pixel près : les triangles coupant
+// le plan proche ne sont pas rastérisés, les boîtes qui le coupent sont
+// toujours visibles.
+class OcclusionCuller {
+public:
+    explicit OcclusionCuller(const OcclusionSettings& settings = OcclusionSettings()) {
+        SetSettings(settings);
+    }
+
+    void SetSettings(const OcclusionSettings& settings) {
+        m_Settings = settings;
+        m_Settings.tileWidth = std::max(4, settings.tileWidth / 4 * 4);
+        m_Settings.tileHeight = std::max(1, settings.tileHeight);
+        m_TilesX = std::max(1, (settings.width + m_Settings.tileWidth - 1) / m_Settings.tileWidth);
+        m_TilesY = std::max(1, (settings.height + m_Settings.tileHeight - 1) / m_Settings.tileHeight);
+        m_Settings.width = m_TilesX * m_Settings.tileWidth;
+        m_Settings.height = m_TilesY * m_Settings.tileHeight;
+        m_Depth.assign(static_cast<size_t>(m_Settings.width) * m_Settings.height, 0.0f);
+        m_Bins.assign(static_cast<size_t>(m_TilesX) * m_TilesY, {});
+    }
+
+    // Nouvelle frame : vide le tampon et les occulteurs
+    void Begin(const glm::mat4& viewProjection) {
+        m_ViewProjection = viewProjection;
+        m_Triangles.clear();
+        m_Stats = OcclusionStats();
+    }
+
+    // Transforme l'occulteur et prépare ses triangles visibles
+    void AddOccluder(const OccluderMesh& mesh, const glm::mat4& model) {
+        const auto start = std::chrono::steady_clock::now();
+        const glm::mat4 transform = m_ViewProjection * model;
+        const float width = static_cast<float>(m_Settings.width), height = static_cast<float>(m_Settings.height);
+
+        m_Screen.resize(mesh.positions.size());
+        for (size_t v = 0; v < mesh.positions.size(); ++v) {
+            const glm::vec4 clip = transform * glm::vec4(mesh.positions[v], 1.0f);
+            if (clip.w <= NEAR_W) {
+                m_Screen[v] = glm::vec3(0.0f, 0.0f, -1.0f);   // Derrière le plan proche
+                continue;
+            }
+            const float inverseW = 1.0f / clip.w;
+            m_Screen[v] = glm::vec3((clip.x * inverseW * 0.5f + 0.5f) * width,
+                                    (clip.y * inverseW * 0.5f + 0.5f) * height, inverseW);
+        }
+
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            const uint32_t a = mesh.indices[i], b = mesh.indices[i + 1], c = mesh.indices[i + 2];
+            if (a < m_Screen.size() && b < m_Screen.size() && c < m_Screen.size()) {
+                SetupTriangle(m_Screen[a], m_Screen[b], m_Screen[c]);
+            }
+        }
+        ++m_Stats.occluders;
+        m_Stats.occluderTriangles += mesh.TriangleCount();
+        m_Stats.setupMilliseconds += MillisecondsSince(start);
+    }
+
+    // Rastérise les occulteurs ajoutés depuis Begin (tuiles en parallèle si pool)
+    void Rasterize(ThreadPool* pool = nullptr) {
+        PROFILE_SCOPE("OcclusionRasterize");
+        const auto start = std::chrono::steady_clock::now();
+        for (auto& bin : m_Bins) {
+            bin.clear();
+        }
+        for (uint32_t t = 0; t < m_Triangles.size(); ++t) {
+            const ScreenTriangle& triangle = m_Triangles[t];
+            for (int ty = triangle.minY / m_Settings.tileHeight; ty <= triangle.maxY / m_Settings.tileHeight; ++ty) {
+                for (int tx = triangle.minX / m_Settings.tileWidth; tx <= triangle.maxX / m_Settings.tileWidth; ++tx) {
+                    m_Bins[static_cast<size_t>(ty) * m_TilesX + tx].push_back(t);
+                }
+            }
+        }
+        m_Stats.rasterizedTriangles = m_Triangles.size();
+
+        auto rasterizeTiles = [this](size_t begin, size_t end) {
+            PROFILE_SCOPE("RasterizeTiles");
+            for (size_t tile = begin; tile < end; ++tile) {
+                RasterizeTile(static_cast<int>(tile));
+            }
+        };
+        if (pool) {
+            pool->ParallelFor(m_Bins.size(), rasterizeTiles, 1);
+        } else {
+            rasterizeTiles(0, m_Bins.size());
+        }
+        m_Stats.rasterMilliseconds += MillisecondsSince(start);
+    }
+
+    // Faux si la boîte (espace monde) est entièrement cachée par les occulteurs ou hors écran
+    bool IsVisible(const AABB& box) const {
+        const auto start = std::chrono::steady_clock::now();
+        const bool visible = TestBox(box);
+        ++m_Stats.testedObjects;
+        if (!visible) {
+            ++m_Stats.culledObjects;
+        }
+        m_Stats.testMilliseconds += MillisecondsSince(start);
+        return visible;
+    }
+
+    const OcclusionStats& GetStats() const { return m_Stats; }
+    int Width() const { return m_Settings.width; }
+    int Height() const { return m_Settings.height; }
+
+    // 1/w de l'occulteur le plus proche au pixel (0 = rien), ligne 0 en bas
+    float Depth(int x, int y) const { return m_Depth[static_cast<size_t>(y) * m_Settings.width + x]; }
+
+private:
+    // Fonctions d'arête et plan de profondeur : valeur = a * x + b * y + c
+    struct ScreenTriangle {
+        float edgeA[3], edgeB[3], edgeC[3];
+        float depthA, depthB, depthC;
+        int minX, minY, maxX, maxY;   // Pixels couverts par la boîte du triangle
+    };
+
+    static constexpr float NEAR_W = 1e-4f;
+    static constexpr float DEPTH_BIAS = 1e-4f;   // Relatif : évite qu'un occulteur cache sa propre boîte
+
+    static double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void SetupTriangle(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2) {
+        if (v0.z <= 0.0f || v1.z <= 0.0f || v2.z <= 0.0f) {
+            return;   // Coupe le plan proche : ignoré (conservatif)
+        }
+        // Aire signée ; les faces avant (sens trigonométrique) sont positives
+        const float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+        if (area <= 0.0f) {
+            return;
+        }
+
+        const int minX = std::max(0, static_cast<int>(std::floor(std::min(v0.x, std::min(v1.x, v2.x)))));
+        const int minY = std::max(0, static_cast<int>(std::floor(std::min(v0.y, std::min(v1.y, v2.y)))));
+        const int maxX = std::min(m_Settings.width - 1, static_cast<int>(std::ceil(std::max(v0.x, std::max(v1.x, v2.x)))));
+        const int maxY = std::min(m_Settings.height - 1, static_cast<int>(std::ceil(std::max(v0.y, std::max(v1.y, v2.y)))));
+        if (minX > maxX || minY > maxY) {
+            return;
+        }
+
+        ScreenTriangle triangle;
+        const glm::vec3* v[3] = {&v0, &v1, &v2};
+        const float inverseArea = 1.0f / area;
+        triangle.depthA = triangle.depthB = triangle.depthC = 0.0f;
+        for (int e = 0; e < 3; ++e) {
+            // Arête opposée au sommet e : positive à l'intérieur
+            const glm::vec3& a = *v[(e + 1) % 3];
+            const glm::vec3& b = *v[(e + 2) % 3];
+            triangle.edgeA[e] = a.y - b.y;
+            triangle.edgeB[e] = b.x - a.x;
+            triangle.edgeC[e] = a.x * b.y - a.y * b.x;
+
+            // Profondeur = somme des coordonnées barycentriques * 1/w des sommets
+            const float weight = v[e]->z * inverseArea;
+            triangle.depthA += triangle.edgeA[e] * weight;
+            triangle.depthB += triangle.edgeB[e] * weight;
+            triangle.depthC += triangle.edgeC[e] * weight;
+        }
+        triangle.minX = minX;
+        triangle.minY = minY;
+        triangle.maxX = maxX;
+        triangle.maxY = maxY;
+        m_Triangles.push_back(triangle);
+    }
+
+    void RasterizeTile(int tile) {
+        const int tileX0 = (tile % m_TilesX) * m_Settings.tileWidth;
+        const int tileY0 = (tile / m_TilesX) * m_Settings.tileHeight;
+        const int tileX1 = tileX0 + m_Settings.tileWidth - 1;
+        const int tileY1 = tileY0 + m_Settings.tileHeight - 1;
+
+        // Effacement de la tuile par son propre thread
+        for (int y = tileY0; y <= tileY1; ++y) {
+            std::fill_n(&m_Depth[static_cast<size_t>(y) * m_Settings.width + tileX0], m_Settings.tileWidth, 0.0f);
+        }
+
+        for (uint32_t index : m_Bins[tile]) {
+            const ScreenTriangle& triangle = m_Triangles[index];
+            const int x0 = std::max(triangle.minX, tileX0) & ~3;   // Aligné sur 4 : reste dans la tuile
+            const int x1 = std::min(triangle.maxX, tileX1);
+            const int y0 = std::max(triangle.minY, tileY0);
+            const int y1 = std::min(triangle.maxY, tileY1);
+            for (int y = y0; y <= y1; ++y) {
+                RasterizeSpan(triangle, x0, x1, y, &m_Depth[static_cast<size_t>(y) * m_Settings.width]);
+            }
+        }
+    }
+
+    // Pixels [x0, x1] de la ligne y (centres à + 0,5) ; x0 multiple de 4
+    static void RasterizeSpan(const ScreenTriangle& triangle, int x0, int x1, int y, float* row) {
+        const float py = y + 0.5f;
+#ifdef GAMEENGINE_SSE
+        const __m128 lane = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+        __m128 edge[3], edgeStep[3];
+        for (int e = 0; e < 3; ++e) {
+            const __m128 a = _mm_set1_ps(triangle.edgeA[e]);
+            edge[e] = _mm_add_ps(_mm_mul_ps(a, _mm_add_ps(_mm_set1_ps(static_cast<float>(x0)), lane)),
+                                 _mm_set1_ps(triangle.edgeB[e] * py + triangle.edgeC[e]));
+            edgeStep[e] = _mm_mul_ps(a, _mm_set1_ps(4.0f));
+        }
+        const __m128 depthA = _mm_set1_ps(triangle.depthA);
+        __m128 depth = _mm_add_ps(_mm_mul_ps(depthA, _mm_add_ps(_mm_set1_ps(static_cast<float>(x0)), lane)),
+                                  _mm_set1_ps(triangle.depthB * py + triangle.depthC));
+        const __m128 depthStep = _mm_mul_ps(depthA, _mm_set1_ps(4.0f));
+        const __m128 zero = _mm_setzero_ps();
+
+        for (int x = x0; x <= x1; x += 4) {
+            const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge[0], zero), _mm_cmpge_ps(edge[1], zero)),
+                                             _mm_cmpge_ps(edge[2], zero));
+            if (_mm_movemask_ps(inside)) {
+                const __m128 current = _mm_loadu_ps(row + x);
+                const __m128 closest = _mm_max_ps(current, depth);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, closest), _mm_andnot_ps(inside, current)));
+            }
+            for (int e = 0; e < 3; ++e) {
+                edge[e] = _mm_add_ps(edge[e], edgeStep[e]);
+            }
+            depth = _mm_add_ps(depth, depthStep);
+        }
+#else
+        for (int x = x0; x <= x1; ++x) {
+            const float px = x + 0.5f;
+            bool inside = true;
+            for (int e = 0; e < 3; ++e) {
+                inside = inside && triangle.edgeA[e] * px + triangle.edgeB[e] * py + triangle.edgeC[e] >= 0.0f;
+            }
+            if (inside) {
+                row[x] = std::max(row[x], triangle.depthA * px + triangle.depthB * py + triangle.depthC);
+            }
+        }
+#endif
+    }
+
+    bool TestBox(const AABB& box) const {
+        // Rectangle à l'écran et point le plus proche (plus grand 1/w)
+        float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX, nearest = 0.0f;
+        for (int corner = 0; corner < 8; ++corner) {
+            const glm::vec3 position((corner & 1) ? box.max.x : box.min.x,
+                                     (corner & 2) ? box.max.y : box.min.y,
+                                     (corner & 4) ? box.max.z : box.min.z);
+            const glm::vec4 clip = m_ViewProjection * glm::vec4(position, 1.0f);
+            if (clip.w <= NEAR_W) {
+                return true;   // Coupe le plan proche
+            }
+            const float inverseW = 1.0f / clip.w;
+            const float x = (clip.x * inverseW * 0.5f + 0.5f) * m_Settings.width;
+            const float y = (clip.y * inverseW * 0.5f + 0.5f) * m_Settings.height;
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
+            nearest = std::max(nearest, inverseW);
+        }
+
+        // Pixels touchés, plus un pixel de marge : les occulteurs remplissent
+        // les pixels dont le centre est couvert, même partiellement
+        if (maxX < 0.0f || maxY < 0.0f || minX > m_Settings.width || minY > m_Settings.height) {
+            return false;   // Hors écran
+        }
+        const int x0 = std::max(0, static_cast<int>(std::floor(minX)) - 1);
+        const int y0 = std::max(0, static_cast<int>(std::floor(minY)) - 1);
+        const int x1 = std::min(m_Settings.width - 1, static_cast<int>(std::ceil(maxX)));
+        const int y1 = std::min(m_Settings.height - 1, static_cast<int>(std::ceil(maxY)));
+        const float threshold = nearest * (1.0f + DEPTH_BIAS);
+
+#ifdef GAMEENGINE_SSE
+        const __m128 boxDepth = _mm_set1_ps(threshold);
+        const __m128 lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+        const __m128 first = _mm_set1_ps(static_cast<float>(x0)), last = _mm_set1_ps(static_cast<float>(x1));
+        for (int y = y0; y <= y1; ++y) {
+            const float* row = &m_Depth[static_cast<size_t>(y) * m_Settings.width];
+            for (int x = x0 & ~3; x <= x1; x += 4) {
+                const __m128 xs = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lane);
+                const __m128 inRect = _mm_and_ps(_mm_cmpge_ps(xs, first), _mm_cmple_ps(xs, last));
+                if (_mm_movemask_ps(_mm_and_ps(inRect, _mm_cmple_ps(_mm_loadu_ps(row + x), boxDepth)))) {
+                    return true;   // Un pixel de la boîte est devant les occulteurs
+                }
+            }
+        }
+#else
+        for (int y = y0; y <= y1; ++y) {
+            const float* row = &m_Depth[static_cast<size_t>(y) * m_Settings.width];
+            for (int x = x0; x <= x1; ++x) {
+                if (row[x] <= threshold) {
+                    return true;
+                }
+            }
+        }
+#endif
+        return false;
+    }
+
+    OcclusionSettings m_Settings;
+    int m_TilesX = 1, m_TilesY = 1;
+    glm::mat4 m_ViewProjection{1.0f};
+    std::vector<float> m_Depth;                  // 1/w, ligne par ligne
+    std::vector<glm::vec3> m_Screen;             // Sommets de l'occulteur en cours (x, y pixels, 1/w)
+    std::vector<ScreenTriangle> m_Triangles;
+    std::vector<std::vector<uint32_t>> m_Bins;   // Triangles par tuile
+    mutable OcclusionStats m_Stats;              // IsVisible compte les tests
+};
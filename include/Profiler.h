@@ -0,0 +1,316 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Log.h"
+
+// Zone terminée, telle qu'écrite par le thread qui l'a mesurée
+struct ProfileEvent {
+    const char* name = nullptr;   // Durée de vie statique (littéral, __func__)
+    uint64_t start = 0;           // Nanosecondes depuis le démarrage du profiler
+    uint64_t end = 0;
+    uint32_t depth = 0;           // Imbrication dans le thread
+    uint32_t thread = 0;
+};
+
+// Statistiques glissantes d'une zone (les ZONE_WINDOW dernières mesures)
+struct ProfileZoneSummary {
+    std::string name;
+    uint64_t count = 0;           // Depuis le démarrage
+    double minMilliseconds = 0.0;
+    double avgMilliseconds = 0.0;
+    double p99Milliseconds = 0.0;
+    double maxMilliseconds = 0.0;
+};
+
+// ============================================
+// Profiler - Zones de temps hiérarchiques, par thread
+// ============================================
+// Chaque thread écrit ses zones dans son propre anneau (un producteur, un
+// consommateur, sans verrou ; anneau plein, la nouvelle zone est perdue et
+// comptée plutôt que d'écraser celles en cours de lecture) ; EndFrame, sur le
+// thread principal, les relève une fois par frame pour les statistiques glissantes et, pendant une
+// capture, pour l'export au format Chrome trace (chrome://tracing, Perfetto).
+// Les zones se déclarent avec PROFILE_SCOPE, qui ne coûte rien quand
+// GAMEENGINE_PROFILING n'est pas défini et un test atomique quand le
+// profiler est désactivé à l'exécution.
+class Profiler {
+public:
+    static constexpr size_t THREAD_BUFFER_SIZE = 8192;   // Zones par thread entre deux relevés (puissance de 2)
+    static constexpr size_t ZONE_WINDOW = 512;
+
+    static Profiler& Get() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    void SetEnabled(bool enabled) { m_Enabled.store(enabled, std::memory_order_relaxed); }
+    bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+    uint64_t Now() const {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_Epoch).count());
+    }
+
+    // Nom du thread appelant dans les traces
+    void SetThreadName(const std::string& name) {
+        ThreadBuffer& buffer = LocalBuffer();
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        buffer.name = name;
+    }
+
+    // ---------- Côté producteur (n'importe quel thread) ----------
+
+    uint32_t EnterZone() { return LocalBuffer().depth++; }
+
+    void LeaveZone(const char* name, uint64_t start, uint32_t depth) {
+        ThreadBuffer& buffer = LocalBuffer();
+        buffer.depth = depth;
+        const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+        // acquire : EndFrame a fini de lire les cases libérées avant qu'on les réécrive
+        if (head - buffer.tail.load(std::memory_order_acquire) >= THREAD_BUFFER_SIZE) {
+            m_Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        ProfileEvent& event = buffer.events[head & (THREAD_BUFFER_SIZE - 1)];
+        event.name = name;
+        event.start = start;
+        event.end = Now();
+        event.depth = depth;
+        event.thread = buffer.index;
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+
+    // ---------- Côté consommateur (thread principal) ----------
+
+    // Relève les zones terminées de tous les threads ; une fois par frame
+    void EndFrame() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for (auto& buffer : m_Buffers) {
+            const uint64_t head = buffer->head.load(std::memory_order_acquire);
+            for (uint64_t tail = buffer->tail.load(std::memory_order_relaxed); tail < head; ++tail) {
+                Record(buffer->events[tail & (THREAD_BUFFER_SIZE - 1)]);
+            }
+            // release : les cases ne sont rendues au producteur qu'une fois lues
+            buffer->tail.store(head, std::memory_order_release);
+        }
+        ++m_Frame;
+    }
+
+    // Enregistre les zones pour WriteChromeTrace (au plus maxEvents)
+    void BeginCapture(size_t maxEvents = 1u << 20) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Capture.clear();
+        m_CaptureLimit = maxEvents;
+        m_Capturing = true;
+    }
+
+    void EndCapture() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Capturing = false;
+    }
+
+    bool IsCapturing() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Capturing;
+    }
+
+    // Écrit la dernière capture au format JSON de chrome://tracing
+    bool WriteChromeTrace(const std::string& path) const {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_ERROR("Failed to write trace: " << path);
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        file << "{\"traceEvents\":[\n";
+        bool first = true;
+        for (const auto& buffer : m_Buffers) {
+            file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->index
+                 << ",\"args\":{\"name\":\"" << Escape(buffer->name) << "\"}}";
+            first = false;
+        }
+        file << std::fixed << std::setprecision(3);
+        for (const ProfileEvent& event : m_Capture) {
+            file << (first ? "" : ",\n") << "{\"name\":\"" << Escape(event.name) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                 << event.thread << ",\"ts\":" << event.start / 1000.0 << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+            first = false;
+        }
+        file << "\n]}\n";
+        LOG_INFO("Trace written: " << path << " (" << m_Capture.size() << " zones)");
+        return file.good();
+    }
+
+    // Statistiques de toutes les zones (regroupées par nom), les plus coûteuses d'abord
+    std::vector<ProfileZoneSummary> GetSummary() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::unordered_map<std::string, std::vector<uint64_t>> samples;
+        std::unordered_map<std::string, uint64_t> counts;
+        for (const auto& pair : m_Zones) {
+            const ZoneStats& zone = pair.second;
+            std::vector<uint64_t>& durations = samples[pair.first];
+            const size_t stored = static_cast<size_t>(std::min<uint64_t>(zone.count, ZONE_WINDOW));
+            durations.insert(durations.end(), zone.durations.begin(), zone.durations.begin() + stored);
+            counts[pair.first] += zone.count;
+        }
+
+        std::vector<ProfileZoneSummary> summary;
+        for (auto& pair : samples) {
+            std::vector<uint64_t>& durations = pair.second;
+            if (durations.empty()) {
+                continue;
+            }
+            std::sort(durations.begin(), durations.end());
+            uint64_t total = 0;
+            for (uint64_t duration : durations) {
+                total += duration;
+            }
+            ProfileZoneSummary zone;
+            zone.name = pair.first;
+            zone.count = counts[pair.first];
+            zone.minMilliseconds = durations.front() / 1e6;
+            zone.avgMilliseconds = static_cast<double>(total) / durations.size() / 1e6;
+            zone.p99Milliseconds = durations[std::min(durations.size() - 1, durations.size() * 99 / 100)] / 1e6;
+            zone.maxMilliseconds = durations.back() / 1e6;
+            summary.push_back(zone);
+        }
+        std::sort(summary.begin(), summary.end(), [](const ProfileZoneSummary& a, const ProfileZoneSummary& b) {
+            return a.avgMilliseconds > b.avgMilliseconds;
+        });
+        return summary;
+    }
+
+    void PrintSummary(std::ostream& out = std::cout) const {
+        out << "=== Profile (last " << ZONE_WINDOW << " samples per zone, ms) ===" << std::endl;
+        out << std::left << std::setw(32) << "zone" << std::right << std::setw(10) << "count" << std::setw(10) << "min"
+            << std::setw(10) << "avg" << std::setw(10) << "p99" << std::setw(10) << "max" << std::endl;
+        out << std::fixed << std::setprecision(3);
+        for (const ProfileZoneSummary& zone : GetSummary()) {
+            out << std::left << std::setw(32) << zone.name << std::right << std::setw(10) << zone.count
+                << std::setw(10) << zone.minMilliseconds << std::setw(10) << zone.avgMilliseconds
+                << std::setw(10) << zone.p99Milliseconds << std::setw(10) << zone.maxMilliseconds << std::endl;
+        }
+        out.unsetf(std::ios::fixed);
+        const uint64_t dropped = m_Dropped.load(std::memory_order_relaxed);
+        if (dropped > 0) {
+            out << "(" << dropped << " zones dropped: EndFrame called too rarely)" << std::endl;
+        }
+    }
+
+private:
+    struct ThreadBuffer {
+        ProfileEvent events[THREAD_BUFFER_SIZE];
+        std::atomic<uint64_t> head{0};   // Écrit par le thread propriétaire
+        std::atomic<uint64_t> tail{0};   // Écrit par EndFrame, lu par le propriétaire (anneau plein)
+        uint32_t depth = 0;
+        uint32_t index = 0;
+        std::string name;
+    };
+
+    struct ZoneStats {
+        std::vector<uint64_t> durations = std::vector<uint64_t>(ZONE_WINDOW);   // Anneau (nanosecondes)
+        uint64_t count = 0;
+    };
+
+    Profiler() : m_Epoch(std::chrono::steady_clock::now()) {}
+
+    // Anneau du thread appelant, créé à sa première zone
+    ThreadBuffer& LocalBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer) {
+            auto created = std::make_unique<ThreadBuffer>();
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            created->index = static_cast<uint32_t>(m_Buffers.size());
+            created->name = "Thread " + std::to_string(created->index);
+            buffer = created.get();
+            m_Buffers.push_back(std::move(created));
+        }
+        return *buffer;
+    }
+
+    void Record(const ProfileEvent& event) {
+        ZoneStats& zone = m_Zones[event.name];
+        zone.durations[zone.count % ZONE_WINDOW] = event.end - event.start;
+        ++zone.count;
+        if (m_Capturing && m_Capture.size() < m_CaptureLimit) {
+            m_Capture.push_back(event);
+        }
+    }
+
+    static std::string Escape(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    const std::chrono::steady_clock::time_point m_Epoch;
+    std::atomic<bool> m_Enabled{true};
+    mutable std::mutex m_Mutex;                                  // Liste des anneaux, statistiques, capture
+    std::vector<std::unique_ptr<ThreadBuffer>> m_Buffers;
+    std::unordered_map<const char*, ZoneStats> m_Zones;         // Par adresse du nom, regroupées par texte dans GetSummary
+    std::vector<ProfileEvent> m_Capture;
+    size_t m_CaptureLimit = 0;
+    bool m_Capturing = false;
+    std::atomic<uint64_t> m_Dropped{0};                          // Zones perdues, anneau plein (tout thread)
+    uint64_t m_Frame = 0;
+};
+
+// ============================================
+// ProfileScope - Zone mesurée de la construction à la destruction
+// ============================================
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) {
+        Profiler& profiler = Profiler::Get();
+        if (profiler.IsEnabled()) {
+            m_Name = name;
+            m_Depth = profiler.EnterZone();
+            m_Start = profiler.Now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (m_Name) {
+            Profiler::Get().LeaveZone(m_Name, m_Start, m_Depth);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_Name = nullptr;
+    uint64_t m_Start = 0;
+    uint32_t m_Depth = 0;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef GAMEENGINE_PROFILING
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#define PROFILE_THREAD(name) Profiler::Get().SetThreadName(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#endif
@@ -4,8 +4,9 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
-#include <iostream>
 #include <string>
+#include "Log.h"
+#include "VertexLayout.h"
 
 // ============================================
 // Renderer - Gère OpenGL et la fenêtre
@@ -19,10 +20,11 @@ public:
         Cleanup();
     }
 
-    bool Init() {
+    // visible = false : fenêtre cachée (replay sans affichage), le contexte OpenGL reste complet
+    bool Init(bool visible = true) {
         // Initialiser GLFW
         if (!glfwInit()) {
-            std::cerr << "Failed to initialize GLFW" << std::endl;
+            LOG_ERROR("Failed to initialize GLFW");
             return false;
         }
 
@@ -30,11 +32,12 @@ public:
         glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
         glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
 
         // Créer la fenêtre
         m_Window = glfwCreateWindow(m_Width, m_Height, "GameEngine - OpenGL", nullptr, nullptr);
         if (!m_Window) {
-            std::cerr << "Failed to create GLFW window" << std::endl;
+            LOG_ERROR("Failed to create GLFW window");
             glfwTerminate();
             return false;
         }
@@ -44,7 +47,7 @@ public:
 
         // Charger GLAD
         if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-            std::cerr << "Failed to initialize GLAD" << std::endl;
+            LOG_ERROR("Failed to initialize GLAD");
             return false;
         }
 
@@ -52,9 +55,9 @@ public:
         glViewport(0, 0, m_Width, m_Height);
         glEnable(GL_DEPTH_TEST);
 
-        std::cout << "OpenGL Renderer initialized!" << std::endl;
-        std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
-        std::cout << "GPU: " << glGetString(GL_RENDERER) << std::endl;
+        LOG_INFO("OpenGL Renderer initialized!");
+        LOG_INFO("OpenGL Version: " << glGetString(GL_VERSION));
+        LOG_INFO("GPU: " << glGetString(GL_RENDERER));
 
         return true;
     }
@@ -72,6 +75,11 @@ public:
         glfwPollEvents();
     }
 
+    // Synchronisation verticale de SwapBuffers (désactivée pour aller au plus vite)
+    void SetVSync(bool enabled) {
+        glfwSwapInterval(enabled ? 1 : 0);
+    }
+
     bool ShouldClose() {
         return glfwWindowShouldClose(m_Window);
     }
@@ -134,42 +142,63 @@ public:
         glDeleteShader(fragment);
     }
 
+    // Adopte un programme déjà lié (voir ShaderCache)
+    explicit Shader(unsigned int program) : ID(program) {}
+
     void Use() {
         glUseProgram(ID);
     }
 
-    void SetMat4(const std::string& name, const glm::mat4& mat) {
-        glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
+    // Noms d'uniforms en const char* : pas de std::string temporaire à chaque appel
+    void SetMat4(const char* name, const glm::mat4& mat) {
+        glUniformMatrix4fv(glGetUniformLocation(ID, name), 1, GL_FALSE, glm::value_ptr(mat));
     }
 
-    void SetVec3(const std::string& name, const glm::vec3& value) {
-        glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, glm::value_ptr(value));
+    void SetMat3(const char* name, const glm::mat3& mat) {
+        glUniformMatrix3fv(glGetUniformLocation(ID, name), 1, GL_FALSE, glm::value_ptr(mat));
     }
 
-private:
-    unsigned int CompileShader(unsigned int type, const char* source) {
-        unsigned int shader = glCreateShader(type);
-        glShaderSource(shader, 1, &source, nullptr);
-        glCompileShader(shader);
-        CheckCompileErrors(shader, type == GL_VERTEX_SHADER ? "VERTEX" : "FRAGMENT");
-        return shader;
+    void SetVec3(const char* name, const glm::vec3& value) {
+        glUniform3fv(glGetUniformLocation(ID, name), 1, glm::value_ptr(value));
+    }
+
+    void SetInt(const char* name, int value) {
+        glUniform1i(glGetUniformLocation(ID, name), value);
     }
 
-    void CheckCompileErrors(unsigned int shader, const std::string& type) {
+    // Paramètres de décodage des vertices quantifiés (à appeler avant chaque Draw)
+    void SetVertexLayout(const VertexLayout& layout) {
+        SetVec3("positionScale", glm::vec3(layout.positionScale[0], layout.positionScale[1], layout.positionScale[2]));
+        SetVec3("positionOffset", glm::vec3(layout.positionOffset[0], layout.positionOffset[1], layout.positionOffset[2]));
+        SetInt("octNormals", layout.HasOctNormals() ? 1 : 0);
+    }
+
+    // Affiche le journal de compilation ou de linking en cas d'échec
+    static bool CheckCompileErrors(unsigned int shader, const std::string& type) {
         int success;
         char infoLog[1024];
         if (type != "PROGRAM") {
             glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
             if (!success) {
                 glGetShaderInfoLog(shader, 1024, nullptr, infoLog);
-                std::cerr << "Shader compilation error (" << type << "):\n" << infoLog << std::endl;
+                LOG_ERROR("Shader compilation error (" << type << "):\n" << infoLog);
             }
         } else {
             glGetProgramiv(shader, GL_LINK_STATUS, &success);
             if (!success) {
                 glGetProgramInfoLog(shader, 1024, nullptr, infoLog);
-                std::cerr << "Shader linking error:\n" << infoLog << std::endl;
+                LOG_ERROR("Shader linking error:\n" << infoLog);
             }
         }
+        return success != 0;
+    }
+
+private:
+    unsigned int CompileShader(unsigned int type, const char* source) {
+        unsigned int shader = glCreateShader(type);
+        glShaderSource(shader, 1, &source, nullptr);
+        glCompileShader(shader);
+        CheckCompileErrors(shader, type == GL_VERTEX_SHADER ? "VERTEX" : "FRAGMENT");
+        return shader;
     }
 };
\ No newline at end of file
@@ -0,0 +1,176 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Input.h"
+#include "Log.h"
+
+// En-tête d'un fichier de replay
+struct ReplayHeader {
+    char magic[4] = {'G', 'E', 'R', 'P'};
+    uint32_t version = 1;
+};
+
+// Ce qui a changé depuis la frame précédente (octet de tête de chaque frame)
+enum ReplayFrameFlags : uint8_t {
+    REPLAY_KEYS    = 1u << 0,   // uint16 nombre, puis les codes des touches qui ont basculé
+    REPLAY_BUTTONS = 1u << 1,   // uint8 boutons de la souris
+    REPLAY_CURSOR  = 1u << 2    // 2 x double position du curseur
+};
+
+// ============================================
+// ReplayWriter - Enregistre l'entrée et le pas de temps de chaque frame
+// ============================================
+// Chaque frame : un octet de drapeaux, le deltaTime (double, exact) puis
+// seulement ce qui a changé ; une frame sans nouvelle entrée tient en 9 octets.
+class ReplayWriter {
+public:
+    bool Open(const std::string& path) {
+        m_File.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_File.is_open()) {
+            LOG_ERROR("Failed to create replay: " << path);
+            return false;
+        }
+        const ReplayHeader header;
+        m_File.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        m_Previous = InputState();
+        m_FrameCount = 0;
+        return m_File.good();
+    }
+
+    bool IsOpen() const { return m_File.is_open(); }
+
+    void Write(double deltaTime, const InputState& input) {
+        uint8_t flags = 0;
+        const std::bitset<INPUT_KEY_COUNT> toggled = input.keys ^ m_Previous.keys;
+        flags |= toggled.any() ? REPLAY_KEYS : 0;
+        flags |= input.mouseButtons != m_Previous.mouseButtons ? REPLAY_BUTTONS : 0;
+        flags |= input.cursorX != m_Previous.cursorX || input.cursorY != m_Previous.cursorY ? REPLAY_CURSOR : 0;
+
+        Put(flags);
+        Put(deltaTime);
+        if (flags & REPLAY_KEYS) {
+            Put(static_cast<uint16_t>(toggled.count()));
+            for (int key = 0; key < INPUT_KEY_COUNT; ++key) {
+                if (toggled.test(static_cast<size_t>(key))) {
+                    Put(static_cast<uint16_t>(key));
+                }
+            }
+        }
+        if (flags & REPLAY_BUTTONS) {
+            Put(input.mouseButtons);
+        }
+        if (flags & REPLAY_CURSOR) {
+            Put(input.cursorX);
+            Put(input.cursorY);
+        }
+        m_Previous = input;
+        ++m_FrameCount;
+    }
+
+    bool Close() {
+        if (!m_File.is_open()) {
+            return true;
+        }
+        m_File.close();
+        const bool ok = !m_File.fail();
+        LOG_INFO("Replay recorded: " << m_FrameCount << " frames");
+        return ok;
+    }
+
+    uint64_t FrameCount() const { return m_FrameCount; }
+
+private:
+    template<typename T>
+    void Put(const T& value) {
+        m_File.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    std::ofstream m_File;
+    InputState m_Previous;
+    uint64_t m_FrameCount = 0;
+};
+
+// ============================================
+// ReplayReader - Relit un replay frame par frame
+// ============================================
+// Le fichier est chargé entièrement à l'ouverture : la lecture pendant le
+// replay ne touche pas au disque.
+class ReplayReader {
+public:
+    bool Open(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            LOG_ERROR("Failed to open replay: " << path);
+            return false;
+        }
+        m_Data.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(m_Data.data()), static_cast<std::streamsize>(m_Data.size()));
+
+        const ReplayHeader expected;
+        ReplayHeader header;
+        m_Offset = 0;
+        if (!file || !Get(header) || std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+            header.version != expected.version) {
+            LOG_ERROR("Invalid replay file: " << path);
+            m_Data.clear();
+            return false;
+        }
+        m_Current = InputState();
+        m_FrameCount = 0;
+        return true;
+    }
+
+    bool IsOpen() const { return !m_Data.empty(); }
+
+    // Frame suivante ; faux à la fin du fichier (ou s'il est tronqué)
+    bool Next(double& deltaTime, InputState& input) {
+        uint8_t flags = 0;
+        if (!Get(flags) || !Get(deltaTime)) {
+            return false;
+        }
+        if (flags & REPLAY_KEYS) {
+            uint16_t count = 0;
+            if (!Get(count)) {
+                return false;
+            }
+            for (uint16_t i = 0; i < count; ++i) {
+                uint16_t key = 0;
+                if (!Get(key) || key >= INPUT_KEY_COUNT) {
+                    return false;
+                }
+                m_Current.keys.flip(key);
+            }
+        }
+        if ((flags & REPLAY_BUTTONS) && !Get(m_Current.mouseButtons)) {
+            return false;
+        }
+        if ((flags & REPLAY_CURSOR) && (!Get(m_Current.cursorX) || !Get(m_Current.cursorY))) {
+            return false;
+        }
+        input = m_Current;
+        ++m_FrameCount;
+        return true;
+    }
+
+    uint64_t FrameCount() const { return m_FrameCount; }
+
+private:
+    template<typename T>
+    bool Get(T& value) {
+        if (m_Offset + sizeof(T) > m_Data.size()) {
+            return false;
+        }
+        std::memcpy(&value, m_Data.data() + m_Offset, sizeof(T));
+        m_Offset += sizeof(T);
+        return true;
+    }
+
+    std::vector<uint8_t> m_Data;
+    size_t m_Offset = 0;
+    InputState m_Current;
+    uint64_t m_FrameCount = 0;
+};
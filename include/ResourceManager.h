@@ -0,0 +1,437 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "AssetLoader.h"
+#include "Log.h"
+#include "Memory.h"
+#include "MeshLOD.h"
+#include "Renderer.h"
+#include "ShaderCache.h"
+#include "ShaderVariants.h"
+
+// Mémoire GPU maximale des meshes chargés depuis un fichier, par défaut (octets)
+const size_t DEFAULT_MESH_BUDGET = 256 * 1024 * 1024;
+
+// ============================================
+// Material - Shader + paramètres de surface
+// ============================================
+struct Material {
+    uint32_t shaderID = 0;
+    glm::vec3 color{1.0f, 1.0f, 1.0f};
+
+    Material() = default;
+    Material(uint32_t shader, const glm::vec3& c) : shaderID(shader), color(c) {}
+};
+
+// ============================================
+// ResourceTable - Ressources identifiées et comptées
+// ============================================
+// Associe un ID (0 = aucun) et une clé unique (chemin, nom) à chaque ressource.
+template<typename T>
+class ResourceTable {
+public:
+    // 0 si la clé est inconnue
+    uint32_t Find(const std::string& key) const {
+        auto it = m_Keys.find(key);
+        return it != m_Keys.end() ? it->second : 0;
+    }
+
+    // Ajoute une ressource avec une référence
+    uint32_t Insert(const std::string& key, T value) {
+        const uint32_t id = m_NextID++;
+        m_Slots.emplace(id, Slot{std::move(value), key, 1});
+        m_Keys[key] = id;
+        return id;
+    }
+
+    T* Get(uint32_t id) {
+        auto it = m_Slots.find(id);
+        return it != m_Slots.end() ? &it->second.value : nullptr;
+    }
+
+    const T* Get(uint32_t id) const {
+        auto it = m_Slots.find(id);
+        return it != m_Slots.end() ? &it->second.value : nullptr;
+    }
+
+    void Acquire(uint32_t id) {
+        auto it = m_Slots.find(id);
+        if (it != m_Slots.end()) {
+            ++it->second.refCount;
+        }
+    }
+
+    // Retire une référence ; à zéro, onDestroy(value) est appelé et la ressource supprimée
+    template<typename F>
+    void Release(uint32_t id, F&& onDestroy) {
+        auto it = m_Slots.find(id);
+        if (it == m_Slots.end() || --it->second.refCount > 0) {
+            return;
+        }
+        T value = std::move(it->second.value);
+        m_Keys.erase(it->second.key);
+        m_Slots.erase(it);
+        onDestroy(value);
+    }
+
+    uint32_t RefCount(uint32_t id) const {
+        auto it = m_Slots.find(id);
+        return it != m_Slots.end() ? it->second.refCount : 0;
+    }
+
+    template<typename F>
+    void ForEach(F&& fn) {
+        for (auto& pair : m_Slots) {
+            fn(pair.first, pair.second.value);
+        }
+    }
+
+    // Supprime tout, sans tenir compte des références
+    template<typename F>
+    void Clear(F&& onDestroy) {
+        for (auto& pair : m_Slots) {
+            onDestroy(pair.second.value);
+        }
+        m_Slots.clear();
+        m_Keys.clear();
+    }
+
+    size_t Size() const { return m_Slots.size(); }
+
+private:
+    struct Slot {
+        T value;
+        std::string key;
+        uint32_t refCount;
+    };
+
+    std::unordered_map<uint32_t, Slot> m_Slots;
+    std::unordered_map<std::string, uint32_t> m_Keys;
+    uint32_t m_NextID = 1;
+};
+
+// ============================================
+// ResourceManager - Meshes, shaders et matériaux partagés
+// ============================================
+// Résout Mesh::meshID et Mesh::materialID. Les chargements d'un même chemin
+// sont dédupliqués et comptés ; une ressource est libérée quand sa dernière
+// référence est rendue. Les meshes chargés depuis un fichier sont évincés du
+// GPU (les moins récemment dessinés d'abord) quand le budget est dépassé, et
+// rechargés depuis le cache de cuisson s'ils sont redemandés.
+// Toutes les méthodes s'appellent depuis le thread principal.
+class ResourceManager {
+public:
+    explicit ResourceManager(AssetLoader& loader) : m_Loader(loader) {}
+
+    ResourceManager(const ResourceManager&) = delete;
+    ResourceManager& operator=(const ResourceManager&) = delete;
+
+    // ---------- Meshes ----------
+
+    // Charge (en arrière-plan) ou réutilise un mesh ; placeholderID est dessiné
+    // tant que le mesh n'est pas prêt. flags (MeshLoadFlags) : données CPU à
+    // préparer aussi (GetMeshBVH, GetMeshOccluder, GetMeshDeformable) ; le premier chargement décide.
+    uint32_t LoadMesh(const std::string& path, VertexFormat format = VertexFormat::Float32,
+                      uint32_t placeholderID = 0, uint32_t flags = 0) {
+        const std::string key = path + "#" + std::to_string(static_cast<uint32_t>(format));
+        if (uint32_t id = m_Meshes.Find(key)) {
+            m_Meshes.Acquire(id);
+            return id;
+        }
+
+        MeshEntry entry;
+        entry.path = path;
+        entry.format = format;
+        entry.flags = flags;
+        entry.asset = m_Loader.LoadMeshAsync(path, format, "cache", flags);
+        entry.placeholderID = placeholderID;
+        m_Meshes.Acquire(placeholderID);
+        return m_Meshes.Insert(key, std::move(entry));
+    }
+
+    // Enregistre un mesh déjà sur le GPU (généré par le code) ; jamais évincé.
+    // flags (MeshLoadFlags) demande que les niveaux aient encore leurs données CPU.
+    uint32_t AddMesh(const std::string& name, LODChain lods, uint32_t flags = 0) {
+        const std::string key = "generated:" + name;
+        if (uint32_t id = m_Meshes.Find(key)) {
+            m_Meshes.Acquire(id);
+            lods.Cleanup();
+            return id;
+        }
+
+        MeshEntry entry;
+        entry.asset = std::make_shared<MeshAsset>();
+        entry.asset->path = name;
+        entry.asset->lods = std::move(lods);
+        if (!entry.asset->lods.Empty()) {
+            if (flags & MESH_LOAD_BVH) {
+                entry.asset->bvh.Build(entry.asset->lods.levels.front().mesh);
+            }
+            if (flags & MESH_LOAD_OCCLUDER) {
+                entry.asset->occluder.Build(entry.asset->lods.levels.front().mesh);
+            }
+            if (flags & MESH_LOAD_DEFORMABLE) {
+                entry.asset->deformable.Build(entry.asset->lods.levels.front().mesh);
+            }
+        }
+        entry.asset->state.store(AssetState::Ready, std::memory_order_release);
+        return m_Meshes.Insert(key, std::move(entry));
+    }
+
+    // Mesh à dessiner pour cet ID (le placeholder s'il n'est pas prêt, nullptr sinon).
+    // Marque le mesh comme utilisé pour cette frame.
+    const LODChain* GetMesh(uint32_t id) {
+        MeshEntry* entry = m_Meshes.Get(id);
+        if (!entry) {
+            return nullptr;
+        }
+        entry->lastUsedFrame = m_Frame;
+
+        if (!entry->asset && !entry->path.empty()) {
+            // Évincé : recharger (depuis le fichier cuit, donc rapide)
+            entry->asset = m_Loader.LoadMeshAsync(entry->path, entry->format, "cache", entry->flags);
+        }
+        if (entry->asset && entry->asset->IsReady()) {
+            return &entry->asset->lods;
+        }
+        return entry->placeholderID != id ? GetMesh(entry->placeholderID) : nullptr;
+    }
+
+    // Boîte englobante en espace objet (niveau 0, ou placeholder) sans marquer
+    // le mesh comme utilisé ; faux si elle n'est pas encore connue
+    bool GetMeshBounds(uint32_t id, AABB& bounds) const {
+        const MeshEntry* entry = m_Meshes.Get(id);
+        if (!entry) {
+            return false;
+        }
+        if (entry->asset && entry->asset->IsReady() && !entry->asset->lods.Empty()) {
+            bounds = entry->asset->lods.levels[0].mesh.bounds;
+            return bounds.IsValid();
+        }
+        return entry->placeholderID != id && GetMeshBounds(entry->placeholderID, bounds);
+    }
+
+    // Triangles du niveau 0 en espace objet (ceux du placeholder s'il n'est pas
+    // prêt) ; nullptr si le mesh a été chargé sans MESH_LOAD_BVH
+    const MeshBVH* GetMeshBVH(uint32_t id) const {
+        const MeshEntry* entry = m_Meshes.Get(id);
+        if (!entry) {
+            return nullptr;
+        }
+        if (entry->asset && entry->asset->IsReady()) {
+            return entry->asset->bvh.Empty() ? nullptr : &entry->asset->bvh;
+        }
+        return entry->placeholderID != id ? GetMeshBVH(entry->placeholderID) : nullptr;
+    }
+
+    // Géométrie d'occultation en espace objet (celle du placeholder s'il n'est
+    // pas prêt) ; nullptr si le mesh a été chargé sans MESH_LOAD_OCCLUDER
+    const OccluderMesh* GetMeshOccluder(uint32_t id) const {
+        const MeshEntry* entry = m_Meshes.Get(id);
+        if (!entry) {
+            return nullptr;
+        }
+        if (entry->asset && entry->asset->IsReady()) {
+            return entry->asset->occluder.Empty() ? nullptr : &entry->asset->occluder;
+        }
+        return entry->placeholderID != id ? GetMeshOccluder(entry->placeholderID) : nullptr;
+    }
+
+    // Niveau 0 au repos, modifiable pour y ajouter morph targets et skinning
+    // (celui du placeholder s'il n'est pas prêt) ; nullptr si le mesh a été
+    // chargé sans MESH_LOAD_DEFORMABLE. Un mesh évincé puis rechargé revient
+    // sans ses ajouts.
+    DeformableMesh* GetMeshDeformable(uint32_t id) {
+        MeshEntry* entry = m_Meshes.Get(id);
+        if (!entry) {
+            return nullptr;
+        }
+        if (entry->asset && entry->asset->IsReady()) {
+            return entry->asset->deformable.Empty() ? nullptr : &entry->asset->deformable;
+        }
+        return entry->placeholderID != id ? GetMeshDeformable(entry->placeholderID) : nullptr;
+    }
+
+    bool IsMeshReady(uint32_t id) const {
+        const MeshEntry* entry = m_Meshes.Get(id);
+        return entry && entry->asset && entry->asset->IsReady();
+    }
+
+    void AcquireMesh(uint32_t id) { m_Meshes.Acquire(id); }
+
+    void ReleaseMesh(uint32_t id) {
+        uint32_t placeholderID = 0;
+        m_Meshes.Release(id, [&](MeshEntry& entry) {
+            DestroyMesh(entry);
+            placeholderID = entry.placeholderID;
+        });
+        if (placeholderID != 0) {
+            ReleaseMesh(placeholderID);
+        }
+    }
+
+    // ---------- Shaders ----------
+
+    // Enregistre un shader à variantes ; les permutations sont compilées à la demande
+    uint32_t LoadShader(const std::string& name, const char* vertexSource, const char* fragmentSource) {
+        if (uint32_t id = m_Shaders.Find(name)) {
+            m_Shaders.Acquire(id);
+            return id;
+        }
+        return m_Shaders.Insert(name, std::make_unique<ShaderVariants>(name, vertexSource, fragmentSource));
+    }
+
+    // Charge plusieurs shaders et compile d'avance les variantes données en une
+    // passe (compilations lancées ensemble) ; les IDs sont dans l'ordre de sources
+    std::vector<uint32_t> LoadShaders(const std::vector<ShaderSource>& sources,
+                                      const std::vector<ShaderVariantKey>& variants = {ShaderVariantKey()}) {
+        std::vector<uint32_t> ids;
+        std::vector<std::pair<ShaderVariants*, ShaderVariantKey>> requests;
+        for (const ShaderSource& source : sources) {
+            const uint32_t id = LoadShader(source.name, source.vertexSource, source.fragmentSource);
+            ids.push_back(id);
+            for (const ShaderVariantKey& key : variants) {
+                requests.emplace_back(m_Shaders.Get(id)->get(), key);
+            }
+        }
+        ShaderVariants::CompileAll(m_ShaderCache, requests);
+        return ids;
+    }
+
+    // Variante du shader pour ces fonctionnalités (compilée au premier appel)
+    Shader* GetShader(uint32_t id, const ShaderVariantKey& key = ShaderVariantKey()) {
+        std::unique_ptr<ShaderVariants>* variants = m_Shaders.Get(id);
+        return variants ? (*variants)->Get(key, m_ShaderCache) : nullptr;
+    }
+
+    void AcquireShader(uint32_t id) { m_Shaders.Acquire(id); }
+
+    void ReleaseShader(uint32_t id) {
+        m_Shaders.Release(id, [](std::unique_ptr<ShaderVariants>& variants) { variants->Destroy(); });
+    }
+
+    ShaderCache& GetShaderCache() { return m_ShaderCache; }
+
+    // ---------- Matériaux ----------
+
+    // Le matériau garde une référence sur son shader
+    uint32_t CreateMaterial(const std::string& name, const Material& material) {
+        if (uint32_t id = m_Materials.Find(name)) {
+            m_Materials.Acquire(id);
+            return id;
+        }
+        m_Shaders.Acquire(material.shaderID);
+        return m_Materials.Insert(name, material);
+    }
+
+    Material* GetMaterial(uint32_t id) { return m_Materials.Get(id); }
+
+    void AcquireMaterial(uint32_t id) { m_Materials.Acquire(id); }
+
+    void ReleaseMaterial(uint32_t id) {
+        uint32_t shaderID = 0;
+        m_Materials.Release(id, [&](Material& material) { shaderID = material.shaderID; });
+        if (shaderID != 0) {
+            ReleaseShader(shaderID);
+        }
+    }
+
+    // ---------- Budget GPU ----------
+
+    // Budget des meshes chargés depuis un fichier (0 = illimité)
+    void SetMeshBudget(size_t bytes) { m_MeshBudget = bytes; }
+    size_t GetMeshBudget() const { return m_MeshBudget; }
+
+    // Mémoire GPU occupée par tous les meshes prêts
+    size_t GetMeshMemory() {
+        size_t bytes = 0;
+        m_Meshes.ForEach([&](uint32_t, MeshEntry& entry) {
+            if (entry.asset && entry.asset->IsReady()) {
+                bytes += entry.asset->lods.GpuBytes();
+            }
+        });
+        return bytes;
+    }
+
+    // À appeler une fois par frame : évince les meshes les moins récemment
+    // dessinés tant que le budget est dépassé (ceux dessinés à la frame
+    // précédente sont conservés). La liste de candidats va dans frameArena si
+    // elle est fournie.
+    void Update(FrameArena* frameArena = nullptr) {
+        if (m_MeshBudget != 0) {
+            struct Candidate {
+                uint64_t lastUsedFrame;
+                MeshEntry* entry;
+            };
+            FrameVector<Candidate> candidates{FrameAllocator<Candidate>(frameArena)};
+            size_t evictable = 0;
+            m_Meshes.ForEach([&](uint32_t, MeshEntry& entry) {
+                if (!entry.path.empty() && entry.asset && entry.asset->IsReady()) {
+                    evictable += entry.asset->lods.GpuBytes();
+                    if (entry.lastUsedFrame + 1 < m_Frame) {
+                        candidates.push_back({entry.lastUsedFrame, &entry});
+                    }
+                }
+            });
+
+            if (evictable > m_MeshBudget) {
+                std::sort(candidates.begin(), candidates.end(),
+                          [](const Candidate& a, const Candidate& b) { return a.lastUsedFrame < b.lastUsedFrame; });
+                for (const Candidate& candidate : candidates) {
+                    if (evictable <= m_MeshBudget) {
+                        break;
+                    }
+                    evictable -= candidate.entry->asset->lods.GpuBytes();
+                    LOG_INFO("Evicted mesh: " << candidate.entry->path);
+                    DestroyMesh(*candidate.entry);
+                }
+            }
+        }
+        ++m_Frame;
+    }
+
+    // Libère tout (à appeler tant que le contexte OpenGL existe)
+    void Clear() {
+        m_Meshes.Clear([this](MeshEntry& entry) { DestroyMesh(entry); });
+        m_Materials.Clear([](Material&) {});
+        m_Shaders.Clear([](std::unique_ptr<ShaderVariants>& variants) { variants->Destroy(); });
+    }
+
+private:
+    struct MeshEntry {
+        std::string path;            // Vide pour un mesh généré (non évinçable)
+        VertexFormat format = VertexFormat::Float32;
+        uint32_t flags = 0;          // MeshLoadFlags, réappliqués après une éviction
+        MeshHandle asset;            // Nul quand le mesh est évincé
+        uint32_t placeholderID = 0;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    // Libère les buffers ; un chargement encore en cours est annulé
+    // (l'AssetLoader libère alors ce qu'il a déjà envoyé)
+    static void DestroyMesh(MeshEntry& entry) {
+        if (entry.asset) {
+            if (entry.asset->IsReady()) {
+                entry.asset->lods.Cleanup();
+            } else {
+                entry.asset->cancelled.store(true, std::memory_order_relaxed);
+            }
+        }
+        entry.asset.reset();
+    }
+
+    AssetLoader& m_Loader;
+    ResourceTable<MeshEntry> m_Meshes;
+    ResourceTable<std::unique_ptr<ShaderVariants>> m_Shaders;
+    ShaderCache m_ShaderCache;
+    ResourceTable<Material> m_Materials;
+    size_t m_MeshBudget = DEFAULT_MESH_BUDGET;
+    uint64_t m_Frame = 1;
+};
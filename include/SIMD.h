@@ -0,0 +1,11 @@
+#pragma once
+
+// ============================================
+// SIMD - Détection des intrinsèques SSE
+// ============================================
+// GAMEENGINE_SSE est défini quand le compilateur cible SSE (toujours vrai en
+// x86-64) ; les chemins vectoriels gardent une version scalaire sinon.
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define GAMEENGINE_SSE 1
+#endif
@@ -0,0 +1,489 @@
+#pragma once
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Bounds.h"
+
+// Résultat d'un lancer de rayon
+struct RayHit {
+    uint32_t id = UINT32_MAX;
+    float distance = FLT_MAX;
+
+    bool Hit() const { return id != UINT32_MAX; }
+};
+
+// ============================================
+// SceneBVH - Hiérarchie de boîtes sur les objets de la scène
+// ============================================
+// Chaque objet est un identifiant (une Entity) et une boîte en espace monde.
+// Les modifications sont appliquées par Commit, une fois par frame :
+// - ajout ou retrait : reconstruction complète (SAH par classes)
+// - boîtes déplacées seulement : réajustement des nœuds (refit), puis
+//   reconstruction si le coût SAH a dépassé rebuildThreshold fois celui de la
+//   dernière construction (l'arbre réajusté devient lâche quand les objets
+//   s'éloignent de leurs voisins d'origine)
+// Les nœuds sont stockés à plat, les deux enfants côte à côte et toujours
+// après leur parent, ce qui permet le refit en un parcours inverse.
+class SceneBVH {
+public:
+    static constexpr uint32_t MAX_LEAF_SIZE = 4;
+    static constexpr uint32_t SAH_BINS = 16;
+
+    void Insert(uint32_t id, const AABB& bounds) {
+        auto inserted = m_Slots.emplace(id, static_cast<uint32_t>(m_Objects.size()));
+        if (!inserted.second) {
+            Update(id, bounds);
+            return;
+        }
+        m_Objects.push_back({bounds, id});
+        m_NeedsRebuild = true;
+    }
+
+    // Nouvelle boîte d'un objet (prise en compte au prochain Commit)
+    void Update(uint32_t id, const AABB& bounds) {
+        auto it = m_Slots.find(id);
+        if (it == m_Slots.end()) {
+            Insert(id, bounds);
+            return;
+        }
+        m_Objects[it->second].bounds = bounds;
+        m_NeedsRefit = true;
+    }
+
+    void Remove(uint32_t id) {
+        auto it = m_Slots.find(id);
+        if (it == m_Slots.end()) {
+            return;
+        }
+        // Échange avec le dernier objet
+        const uint32_t slot = it->second;
+        m_Slots.erase(it);
+        if (slot + 1 != m_Objects.size()) {
+            m_Objects[slot] = m_Objects.back();
+            m_Slots[m_Objects[slot].id] = slot;
+        }
+        m_Objects.pop_back();
+        m_NeedsRebuild = true;
+    }
+
+    bool Contains(uint32_t id) const { return m_Slots.count(id) != 0; }
+
+    const AABB* GetBounds(uint32_t id) const {
+        auto it = m_Slots.find(id);
+        return it != m_Slots.end() ? &m_Objects[it->second].bounds : nullptr;
+    }
+
+    void Clear() {
+        m_Objects.clear();
+        m_Slots.clear();
+        m_Nodes.clear();
+        m_Items.clear();
+        m_NeedsRebuild = m_NeedsRefit = false;
+        m_BuildCost = 0.0f;
+    }
+
+    // Applique les modifications en attente ; vrai si l'arbre a été reconstruit
+    bool Commit() {
+        if (m_NeedsRebuild) {
+            Build();
+            return true;
+        }
+        if (m_NeedsRefit) {
+            Refit();
+            if (m_BuildCost > 0.0f && Cost() > m_BuildCost * m_RebuildThreshold) {
+                Build();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Reconstruction complète (SAH par classes sur les centres)
+    void Build() {
+        m_Nodes.clear();
+        m_Items.resize(m_Objects.size());
+        for (uint32_t i = 0; i < m_Items.size(); ++i) {
+            m_Items[i] = i;
+        }
+        m_Centers.resize(m_Objects.size());
+        for (size_t i = 0; i < m_Objects.size(); ++i) {
+            m_Centers[i] = m_Objects[i].bounds.Center();
+        }
+        m_NeedsRebuild = m_NeedsRefit = false;
+        m_BuildCost = 0.0f;
+        if (m_Objects.empty()) {
+            return;
+        }
+
+        m_Nodes.reserve(m_Objects.size() * 2 / MAX_LEAF_SIZE + 1);
+        m_Nodes.push_back(Node{AABB(), 0, static_cast<uint32_t>(m_Items.size())});
+
+        // Pile explicite de (nœud, profondeur)
+        std::vector<std::pair<uint32_t, uint32_t>> stack{{0, 0}};
+        while (!stack.empty()) {
+            const uint32_t nodeIndex = stack.back().first, depth = stack.back().second;
+            stack.pop_back();
+            const uint32_t first = m_Nodes[nodeIndex].first, count = m_Nodes[nodeIndex].count;
+
+            AABB bounds, centerBounds;
+            for (uint32_t i = first; i < first + count; ++i) {
+                bounds.Expand(m_Objects[m_Items[i]].bounds);
+                centerBounds.Expand(m_Centers[m_Items[i]]);
+            }
+            m_Nodes[nodeIndex].bounds = bounds;
+            if (count <= MAX_LEAF_SIZE) {
+                continue;
+            }
+
+            uint32_t middle = first;
+            if (depth >= MAX_SAH_DEPTH) {
+                // Coupe à la médiane : la profondeur reste sous celle des piles de requête
+                SplitMedian(first, count, centerBounds, middle);
+            } else if (!Split(first, count, bounds, centerBounds, middle)) {
+                continue;   // Garder en feuille : aucune séparation rentable
+            }
+
+            const uint32_t left = static_cast<uint32_t>(m_Nodes.size());
+            m_Nodes.push_back(Node{AABB(), first, middle - first});
+            m_Nodes.push_back(Node{AABB(), middle, first + count - middle});
+            m_Nodes[nodeIndex].first = left;
+            m_Nodes[nodeIndex].count = 0;
+            stack.emplace_back(left + 1, depth + 1);
+            stack.emplace_back(left, depth + 1);
+        }
+        m_BuildCost = Cost();
+    }
+
+    // Recalcule les boîtes des nœuds sans changer la topologie
+    void Refit() {
+        for (size_t n = m_Nodes.size(); n-- > 0;) {
+            Node& node = m_Nodes[n];
+            AABB bounds;
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    bounds.Expand(m_Objects[m_Items[i]].bounds);
+                }
+            } else {
+                bounds = m_Nodes[node.first].bounds;
+                bounds.Expand(m_Nodes[node.first + 1].bounds);
+            }
+            node.bounds = bounds;
+        }
+        m_NeedsRefit = false;
+    }
+
+    // Coût SAH de l'arbre, relatif à la boîte racine
+    float Cost() const {
+        if (m_Nodes.empty()) {
+            return 0.0f;
+        }
+        const float rootArea = std::max(m_Nodes[0].bounds.SurfaceArea(), FLT_MIN);
+        float cost = 0.0f;
+        for (const Node& node : m_Nodes) {
+            const float area = node.bounds.SurfaceArea() / rootArea;
+            cost += node.count > 0 ? area * node.count * INTERSECTION_COST : area * TRAVERSAL_COST;
+        }
+        return cost;
+    }
+
+    // ---------- Requêtes (sur l'état du dernier Commit) ----------
+
+    // visit(id) pour chaque objet dont la boîte touche le frustum (test conservatif)
+    template<typename F>
+    void QueryFrustum(const Frustum& frustum, F&& visit) const {
+        if (m_Nodes.empty()) {
+            return;
+        }
+        uint32_t stack[64];
+        uint32_t top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& node = m_Nodes[stack[--top]];
+            if (!frustum.Intersects(node.bounds)) {
+                continue;
+            }
+            if (frustum.Contains(node.bounds)) {
+                VisitAll(node, visit);   // Entièrement visible : plus aucun test
+                continue;
+            }
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    const Object& object = m_Objects[m_Items[i]];
+                    if (frustum.Intersects(object.bounds)) {
+                        visit(object.id);
+                    }
+                }
+            } else {
+                stack[top++] = node.first + 1;
+                stack[top++] = node.first;
+            }
+        }
+    }
+
+    void QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& result) const {
+        result.clear();
+        QueryFrustum(frustum, [&](uint32_t id) { result.push_back(id); });
+    }
+
+    // visit(id) pour chaque objet dont la boîte chevauche range
+    template<typename F>
+    void QueryRange(const AABB& range, F&& visit) const {
+        if (m_Nodes.empty()) {
+            return;
+        }
+        uint32_t stack[64];
+        uint32_t top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& node = m_Nodes[stack[--top]];
+            if (!node.bounds.Overlaps(range)) {
+                continue;
+            }
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    const Object& object = m_Objects[m_Items[i]];
+                    if (object.bounds.Overlaps(range)) {
+                        visit(object.id);
+                    }
+                }
+            } else {
+                stack[top++] = node.first + 1;
+                stack[top++] = node.first;
+            }
+        }
+    }
+
+    void QueryRange(const AABB& range, std::vector<uint32_t>& result) const {
+        result.clear();
+        QueryRange(range, [&](uint32_t id) { result.push_back(id); });
+    }
+
+    // Objets dont la boîte est à moins de radius de center
+    void QuerySphere(const glm::vec3& center, float radius, std::vector<uint32_t>& result) const {
+        result.clear();
+        const float radiusSquared = radius * radius;
+        QueryRange(AABB(center - glm::vec3(radius), center + glm::vec3(radius)), [&](uint32_t id) {
+            const AABB& box = m_Objects[m_Slots.at(id)].bounds;
+            const glm::vec3 offset = center - glm::clamp(center, box.min, box.max);
+            if (glm::dot(offset, offset) <= radiusSquared) {
+                result.push_back(id);
+            }
+        });
+    }
+
+    // Objet le plus proche touché par le rayon. hitTest(id, distanceBoîte)
+    // affine le test (par exemple sur les triangles) et renvoie la distance du
+    // point d'impact, ou une valeur négative si l'objet est manqué.
+    template<typename F>
+    RayHit Raycast(const Ray& ray, float maxDistance, F&& hitTest) const {
+        RayHit hit;
+        hit.distance = maxDistance;
+        if (m_Nodes.empty()) {
+            return hit;
+        }
+
+        float t = 0.0f;
+        if (!ray.Intersects(m_Nodes[0].bounds, hit.distance, t)) {
+            return hit;
+        }
+        struct Entry {
+            uint32_t node;
+            float distance;
+        };
+        Entry stack[64];
+        uint32_t top = 0;
+        stack[top++] = {0, t};
+        while (top > 0) {
+            const Entry entry = stack[--top];
+            if (entry.distance > hit.distance) {
+                continue;   // Déjà plus loin que l'impact trouvé
+            }
+            const Node& node = m_Nodes[entry.node];
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    const Object& object = m_Objects[m_Items[i]];
+                    float boxDistance = 0.0f;
+                    if (!ray.Intersects(object.bounds, hit.distance, boxDistance)) {
+                        continue;
+                    }
+                    const float distance = hitTest(object.id, boxDistance);
+                    if (distance >= 0.0f && distance < hit.distance) {
+                        hit.distance = distance;
+                        hit.id = object.id;
+                    }
+                }
+                continue;
+            }
+
+            // Enfant le plus proche en dernier sur la pile : visité d'abord
+            float tLeft = 0.0f, tRight = 0.0f;
+            const bool hitLeft = ray.Intersects(m_Nodes[node.first].bounds, hit.distance, tLeft);
+            const bool hitRight = ray.Intersects(m_Nodes[node.first + 1].bounds, hit.distance, tRight);
+            if (hitLeft && hitRight) {
+                if (tLeft <= tRight) {
+                    stack[top++] = {node.first + 1, tRight};
+                    stack[top++] = {node.first, tLeft};
+                } else {
+                    stack[top++] = {node.first, tLeft};
+                    stack[top++] = {node.first + 1, tRight};
+                }
+            } else if (hitLeft) {
+                stack[top++] = {node.first, tLeft};
+            } else if (hitRight) {
+                stack[top++] = {node.first + 1, tRight};
+            }
+        }
+        return hit;
+    }
+
+    // Test sur les boîtes seules
+    RayHit Raycast(const Ray& ray, float maxDistance = FLT_MAX) const {
+        return Raycast(ray, maxDistance, [](uint32_t, float boxDistance) { return boxDistance; });
+    }
+
+    // ---------- Statistiques ----------
+
+    size_t ObjectCount() const { return m_Objects.size(); }
+    size_t NodeCount() const { return m_Nodes.size(); }
+    float BuildCost() const { return m_BuildCost; }
+
+    // Reconstruction quand Cost() > BuildCost() * threshold (1.5 par défaut)
+    void SetRebuildThreshold(float threshold) { m_RebuildThreshold = threshold; }
+
+private:
+    // Feuille : count > 0, objets m_Items[first, first + count).
+    // Nœud interne : count = 0, enfants first et first + 1.
+    struct Node {
+        AABB bounds;
+        uint32_t first;
+        uint32_t count;
+    };
+
+    struct Object {
+        AABB bounds;
+        uint32_t id;
+    };
+
+    static constexpr uint32_t MAX_SAH_DEPTH = 40;   // Piles de requête de 64 entrées
+    static constexpr float TRAVERSAL_COST = 1.0f;
+    static constexpr float INTERSECTION_COST = 1.0f;
+
+    // Meilleur plan parmi SAH_BINS classes sur chaque axe ; partitionne
+    // m_Items et renvoie le début de la moitié droite dans middle
+    bool Split(uint32_t first, uint32_t count, const AABB& bounds, const AABB& centerBounds, uint32_t& middle) {
+        struct Bin {
+            AABB bounds;
+            uint32_t count = 0;
+        };
+
+        float bestCost = count * INTERSECTION_COST;   // Coût de la feuille (surfaces relatives au nœud)
+        int bestAxis = -1;
+        uint32_t bestBin = 0;
+        const float parentArea = std::max(bounds.SurfaceArea(), FLT_MIN);
+
+        for (int axis = 0; axis < 3; ++axis) {
+            const float minimum = centerBounds.min[axis];
+            const float extent = centerBounds.max[axis] - minimum;
+            if (extent <= 0.0f) {
+                continue;
+            }
+            const float scale = SAH_BINS / extent;
+
+            Bin bins[SAH_BINS];
+            for (uint32_t i = first; i < first + count; ++i) {
+                const uint32_t object = m_Items[i];
+                const uint32_t bin = std::min(SAH_BINS - 1, static_cast<uint32_t>((m_Centers[object][axis] - minimum) * scale));
+                bins[bin].bounds.Expand(m_Objects[object].bounds);
+                ++bins[bin].count;
+            }
+
+            // Balayage des plans : aires et effectifs à gauche puis à droite
+            float leftArea[SAH_BINS - 1], rightArea[SAH_BINS - 1];
+            uint32_t leftCount[SAH_BINS - 1], rightCount[SAH_BINS - 1];
+            AABB left, right;
+            uint32_t leftSum = 0, rightSum = 0;
+            for (uint32_t b = 0; b < SAH_BINS - 1; ++b) {
+                left.Expand(bins[b].bounds);
+                leftSum += bins[b].count;
+                leftCount[b] = leftSum;
+                leftArea[b] = leftSum > 0 ? left.SurfaceArea() : 0.0f;
+
+                const uint32_t r = SAH_BINS - 1 - b;
+                right.Expand(bins[r].bounds);
+                rightSum += bins[r].count;
+                rightCount[r - 1] = rightSum;
+                rightArea[r - 1] = rightSum > 0 ? right.SurfaceArea() : 0.0f;
+            }
+            for (uint32_t b = 0; b < SAH_BINS - 1; ++b) {
+                if (leftCount[b] == 0 || rightCount[b] == 0) {
+                    continue;
+                }
+                const float cost = TRAVERSAL_COST +
+                    (leftArea[b] * leftCount[b] + rightArea[b] * rightCount[b]) * INTERSECTION_COST / parentArea;
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = b;
+                }
+            }
+        }
+
+        if (bestAxis < 0) {
+            if (count <= MAX_LEAF_SIZE * 4) {
+                return false;
+            }
+            // Centres confondus ou SAH défavorable : coupe à la médiane pour borner les feuilles
+            SplitMedian(first, count, centerBounds, middle);
+            return true;
+        }
+
+        const float minimum = centerBounds.min[bestAxis];
+        const float scale = SAH_BINS / (centerBounds.max[bestAxis] - minimum);
+        auto split = std::partition(m_Items.begin() + first, m_Items.begin() + first + count, [&](uint32_t object) {
+            const uint32_t bin = std::min(SAH_BINS - 1, static_cast<uint32_t>((m_Centers[object][bestAxis] - minimum) * scale));
+            return bin <= bestBin;
+        });
+        middle = static_cast<uint32_t>(split - m_Items.begin());
+        return middle != first && middle != first + count;
+    }
+
+    void SplitMedian(uint32_t first, uint32_t count, const AABB& centerBounds, uint32_t& middle) {
+        const glm::vec3 size = centerBounds.Size();
+        const int axis = (size.x >= size.y && size.x >= size.z) ? 0 : (size.y >= size.z ? 1 : 2);
+        middle = first + count / 2;
+        std::nth_element(m_Items.begin() + first, m_Items.begin() + middle, m_Items.begin() + first + count,
+                         [&](uint32_t a, uint32_t b) { return m_Centers[a][axis] < m_Centers[b][axis]; });
+    }
+
+    template<typename F>
+    void VisitAll(const Node& root, F& visit) const {
+        uint32_t stack[64];
+        uint32_t top = 0;
+        stack[top++] = static_cast<uint32_t>(&root - m_Nodes.data());
+        while (top > 0) {
+            const Node& node = m_Nodes[stack[--top]];
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    visit(m_Objects[m_Items[i]].id);
+                }
+            } else {
+                stack[top++] = node.first + 1;
+                stack[top++] = node.first;
+            }
+        }
+    }
+
+    std::vector<Object> m_Objects;
+    std::unordered_map<uint32_t, uint32_t> m_Slots;   // id -> indice dans m_Objects
+    std::vector<Node> m_Nodes;
+    std::vector<uint32_t> m_Items;                     // Indices d'objets dans l'ordre des feuilles
+    std::vector<glm::vec3> m_Centers;                  // Construction uniquement
+    bool m_NeedsRebuild = false;
+    bool m_NeedsRefit = false;
+    float m_BuildCost = 0.0f;
+    float m_RebuildThreshold = 1.5f;
+};
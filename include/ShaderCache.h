@@ -0,0 +1,248 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <glad/glad.h>
+#include "Hash.h"
+#include "Log.h"
+#include "Renderer.h"
+
+// Version du format : à incrémenter dès que l'en-tête change
+const uint32_t PROGRAM_BINARY_VERSION = 1;
+
+// Sources d'un programme (vertex + fragment)
+struct ShaderSource {
+    std::string name;
+    const char* vertexSource = nullptr;
+    const char* fragmentSource = nullptr;
+};
+
+// En-tête d'un fichier .glprog : [ProgramBinaryHeader][binaire du pilote]
+struct ProgramBinaryHeader {
+    char magic[4] = {'G', 'E', 'P', 'B'};
+    uint32_t version = PROGRAM_BINARY_VERSION;
+    uint64_t key = 0;           // Empreinte des sources et du pilote
+    uint32_t binaryFormat = 0;
+    uint32_t binarySize = 0;
+};
+
+// ============================================
+// ShaderCache - Programmes liés, mis en cache sur disque
+// ============================================
+// Un programme est identifié par l'empreinte de ses sources et de la chaîne
+// du pilote (GL_VENDOR, GL_RENDERER, GL_VERSION) : une mise à jour du pilote
+// ou d'un shader invalide l'entrée. Le binaire est relu avec glProgramBinary
+// quand le pilote le permet (points d'entrée GL 4.1 chargés par glad, au moins
+// un format binaire) ; sinon, ou si le pilote refuse le binaire, le programme
+// est compilé depuis les sources.
+// Thread principal uniquement (contexte OpenGL requis dès le premier appel).
+class ShaderCache {
+public:
+    explicit ShaderCache(const std::string& cacheDir = "cache/shaders") : m_CacheDir(cacheDir) {}
+
+    // Programme lié (0 en cas d'échec)
+    unsigned int Load(const char* vertexSource, const char* fragmentSource) {
+        ShaderSource source;
+        source.vertexSource = vertexSource;
+        source.fragmentSource = fragmentSource;
+        return LoadAll(std::vector<ShaderSource>{source}).front();
+    }
+
+    // Charge plusieurs programmes en une passe : les binaires en cache sont
+    // relus, puis toutes les compilations et tous les linkings manquants sont
+    // lancés avant la première lecture d'état, ce qui laisse le pilote
+    // travailler en parallèle (GL_KHR_parallel_shader_compile ou threads internes)
+    std::vector<unsigned int> LoadAll(const std::vector<ShaderSource>& sources) {
+        DetectDriver();
+        std::vector<unsigned int> programs(sources.size(), 0);
+        std::vector<uint64_t> keys(sources.size(), 0);
+
+        for (size_t i = 0; i < sources.size(); ++i) {
+            keys[i] = Key(sources[i]);
+            programs[i] = LoadBinary(keys[i]);
+        }
+
+        struct PendingProgram {
+            size_t index;
+            unsigned int vertex;
+            unsigned int fragment;
+        };
+        std::vector<PendingProgram> pending;
+
+        // Compilations : aucune lecture d'état ici
+        for (size_t i = 0; i < sources.size(); ++i) {
+            if (programs[i] != 0) {
+                continue;
+            }
+            PendingProgram program{i, glCreateShader(GL_VERTEX_SHADER), glCreateShader(GL_FRAGMENT_SHADER)};
+            glShaderSource(program.vertex, 1, &sources[i].vertexSource, nullptr);
+            glCompileShader(program.vertex);
+            glShaderSource(program.fragment, 1, &sources[i].fragmentSource, nullptr);
+            glCompileShader(program.fragment);
+            pending.push_back(program);
+        }
+
+        // Linkings
+        for (const PendingProgram& program : pending) {
+            const unsigned int id = glCreateProgram();
+            if (m_BinarySupported) {
+                glProgramParameteri(id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+            }
+            glAttachShader(id, program.vertex);
+            glAttachShader(id, program.fragment);
+            glLinkProgram(id);
+            programs[program.index] = id;
+        }
+
+        // Lecture des états, puis sauvegarde des binaires
+        for (const PendingProgram& program : pending) {
+            const unsigned int id = programs[program.index];
+            const bool compiled = Shader::CheckCompileErrors(program.vertex, "VERTEX") &
+                                  Shader::CheckCompileErrors(program.fragment, "FRAGMENT");
+            const bool linked = compiled && Shader::CheckCompileErrors(id, "PROGRAM");
+            glDetachShader(id, program.vertex);
+            glDetachShader(id, program.fragment);
+            glDeleteShader(program.vertex);
+            glDeleteShader(program.fragment);
+
+            if (!linked) {
+                LOG_ERROR("Failed to build shader program: " << sources[program.index].name);
+                glDeleteProgram(id);
+                programs[program.index] = 0;
+                continue;
+            }
+            SaveBinary(keys[program.index], id);
+        }
+
+        m_Stats.loadedFromCache += static_cast<uint32_t>(sources.size() - pending.size());
+        m_Stats.compiled += static_cast<uint32_t>(pending.size());
+        return programs;
+    }
+
+    // Vrai si le pilote peut relire des binaires de programme
+    bool IsBinarySupported() {
+        DetectDriver();
+        return m_BinarySupported;
+    }
+
+    struct Stats {
+        uint32_t loadedFromCache = 0;
+        uint32_t compiled = 0;
+    };
+    const Stats& GetStats() const { return m_Stats; }
+
+    const std::string& GetCacheDir() const { return m_CacheDir; }
+
+private:
+    void DetectDriver() {
+        if (m_DriverDetected) {
+            return;
+        }
+        m_DriverDetected = true;
+
+        for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+            const GLubyte* text = glGetString(name);
+            if (text) {
+                m_Driver += reinterpret_cast<const char*>(text);
+            }
+            m_Driver += '\n';
+        }
+
+        GLint formats = 0;
+        if (glGetProgramBinary && glProgramBinary && glProgramParameteri) {
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        }
+        m_BinarySupported = formats > 0;
+    }
+
+    uint64_t Key(const ShaderSource& source) const {
+        uint64_t key = HashString(m_Driver);
+        key = HashBytes(source.vertexSource, std::strlen(source.vertexSource), key);
+        key = HashBytes(source.fragmentSource, std::strlen(source.fragmentSource), key);
+        return key;
+    }
+
+    std::string CachePath(uint64_t key) const {
+        std::ostringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << key << ".glprog";
+        return (std::filesystem::path(m_CacheDir) / name.str()).string();
+    }
+
+    // Programme relu depuis le cache, 0 si absent ou refusé par le pilote
+    unsigned int LoadBinary(uint64_t key) {
+        if (!m_BinarySupported) {
+            return 0;
+        }
+        std::ifstream file(CachePath(key), std::ios::binary);
+        ProgramBinaryHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, "GEPB", 4) != 0 || header.version != PROGRAM_BINARY_VERSION ||
+            header.key != key) {
+            return 0;
+        }
+        std::vector<char> binary(header.binarySize);
+        if (!file.read(binary.data(), static_cast<std::streamsize>(binary.size()))) {
+            return 0;
+        }
+
+        const unsigned int id = glCreateProgram();
+        glProgramBinary(id, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+        GLint linked = 0;
+        glGetProgramiv(id, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            // Binaire périmé : il sera recompilé puis réécrit
+            glDeleteProgram(id);
+            return 0;
+        }
+        return id;
+    }
+
+    void SaveBinary(uint64_t key, unsigned int program) {
+        if (!m_BinarySupported) {
+            return;
+        }
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) {
+            return;
+        }
+
+        ProgramBinaryHeader header;
+        header.key = key;
+        std::vector<char> binary(static_cast<size_t>(length));
+        GLenum format = 0;
+        GLsizei written = 0;
+        glGetProgramBinary(program, length, &written, &format, binary.data());
+        if (written <= 0) {
+            return;
+        }
+        header.binaryFormat = format;
+        header.binarySize = static_cast<uint32_t>(written);
+
+        std::error_code error;
+        std::filesystem::create_directories(m_CacheDir, error);
+        const std::string path = CachePath(key);
+        const std::string temporaryPath = path + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(binary.data(), written);
+            if (!file.good()) {
+                return;
+            }
+        }
+        std::filesystem::rename(temporaryPath, path, error);
+    }
+
+    std::string m_CacheDir;
+    std::string m_Driver;
+    bool m_DriverDetected = false;
+    bool m_BinarySupported = false;
+    Stats m_Stats;
+};
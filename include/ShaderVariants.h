@@ -0,0 +1,178 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <glad/glad.h>
+#include "Renderer.h"
+#include "ShaderCache.h"
+
+// Fonctionnalités activables d'un shader (un #define chacune ; bit 0 libre)
+enum ShaderFeature : uint32_t {
+    SHADER_QUANTIZED_VERTICES = 1u << 1,   // QUANTIZED_VERTICES
+    SHADER_CPU_NORMAL_MATRIX  = 1u << 2,   // CPU_NORMAL_MATRIX
+    SHADER_CLUSTERED_LIGHTING = 1u << 3,   // CLUSTERED_LIGHTING
+    SHADER_SKINNING           = 1u << 4,   // SKINNING
+    SHADER_MORPH_TARGETS      = 1u << 5    // MORPH_TARGETS
+};
+
+// Nombre de lumières d'une variante (NUM_LIGHTS), ramené à [1, MAX_SHADER_LIGHTS] :
+// un tableau GLSL de taille 0 ne compile pas
+const uint32_t MAX_SHADER_LIGHTS = 8;
+
+// Articulations d'un mesh skinné sur le GPU (MAX_SKIN_JOINTS) : 32 mat4 tiennent
+// dans le minimum d'uniforms de vertex garanti par OpenGL 3.3
+const uint32_t MAX_SKIN_JOINTS = 32;
+
+// Morph targets appliqués par draw sur le GPU (MAX_MORPH_TARGETS) : ceux de plus grand poids
+const uint32_t MAX_GPU_MORPH_TARGETS = 8;
+
+// ============================================
+// ShaderVariantKey - Permutation de fonctionnalités
+// ============================================
+struct ShaderVariantKey {
+    uint32_t features = 0;
+    uint32_t lightCount = 1;
+
+    ShaderVariantKey() = default;
+    ShaderVariantKey(uint32_t featureMask, uint32_t lights = 1) : features(featureMask), lightCount(ClampLights(lights)) {}
+
+    bool Has(ShaderFeature feature) const { return (features & feature) != 0; }
+    uint32_t Lights() const { return ClampLights(lightCount); }
+    uint64_t Packed() const { return (static_cast<uint64_t>(Lights()) << 32) | features; }
+
+    static uint32_t ClampLights(uint32_t lights) { return std::min(std::max(lights, 1u), MAX_SHADER_LIGHTS); }
+
+    // Lignes #define correspondantes
+    std::string Defines() const {
+        std::string defines;
+        if (Has(SHADER_QUANTIZED_VERTICES)) defines += "#define QUANTIZED_VERTICES\n";
+        if (Has(SHADER_CPU_NORMAL_MATRIX)) defines += "#define CPU_NORMAL_MATRIX\n";
+        if (Has(SHADER_CLUSTERED_LIGHTING)) defines += "#define CLUSTERED_LIGHTING\n";
+        if (Has(SHADER_SKINNING)) defines += "#define SKINNING\n#define MAX_SKIN_JOINTS " + std::to_string(MAX_SKIN_JOINTS) + "\n";
+        if (Has(SHADER_MORPH_TARGETS)) defines += "#define MORPH_TARGETS\n#define MAX_MORPH_TARGETS " + std::to_string(MAX_GPU_MORPH_TARGETS) + "\n";
+        defines += "#define NUM_LIGHTS " + std::to_string(Lights()) + "\n";
+        return defines;
+    }
+};
+
+// ============================================
+// ShaderVariants - Un shader source, compilé par permutation
+// ============================================
+// Les sources portent des blocs #ifdef ; seules les permutations réellement
+// demandées sont compilées, à la première utilisation (ou d'avance avec
+// CompileAll), puis gardées. La compilation passe par le ShaderCache, donc les
+// variantes déjà vues aux lancements précédents sont relues depuis le disque.
+class ShaderVariants {
+public:
+    ShaderVariants(const std::string& name, const char* vertexSource, const char* fragmentSource)
+        : m_Name(name), m_VertexSource(vertexSource), m_FragmentSource(fragmentSource) {}
+
+    ShaderVariants(const ShaderVariants&) = delete;
+    ShaderVariants& operator=(const ShaderVariants&) = delete;
+
+    // Variante compilée (nullptr si la compilation a échoué)
+    Shader* Get(const ShaderVariantKey& key, ShaderCache& cache) {
+        auto it = m_Variants.find(key.Packed());
+        if (it == m_Variants.end()) {
+            const VariantSource source = Source(key);
+            it = m_Variants.emplace(key.Packed(), std::make_unique<Shader>(cache.LoadAll({source.Describe()}).front())).first;
+        }
+        return it->second->ID != 0 ? it->second.get() : nullptr;
+    }
+
+    bool IsCompiled(const ShaderVariantKey& key) const { return m_Variants.count(key.Packed()) != 0; }
+    size_t VariantCount() const { return m_Variants.size(); }
+    const std::string& GetName() const { return m_Name; }
+
+    // Compile d'avance plusieurs variantes, de un ou plusieurs shaders, en une
+    // seule passe du ShaderCache (compilations lancées ensemble)
+    static void CompileAll(ShaderCache& cache,
+                           const std::vector<std::pair<ShaderVariants*, ShaderVariantKey>>& requests) {
+        std::vector<std::pair<ShaderVariants*, ShaderVariantKey>> missing;
+        std::vector<VariantSource> sources;
+        for (const auto& request : requests) {
+            if (request.first->IsCompiled(request.second)) {
+                continue;
+            }
+            // Une même variante demandée deux fois n'est compilée qu'une fois
+            bool duplicate = false;
+            for (const auto& other : missing) {
+                duplicate |= other.first == request.first && other.second.Packed() == request.second.Packed();
+            }
+            if (!duplicate) {
+                missing.push_back(request);
+                sources.push_back(request.first->Source(request.second));
+            }
+        }
+
+        std::vector<ShaderSource> descriptions;
+        descriptions.reserve(sources.size());
+        for (const VariantSource& source : sources) {
+            descriptions.push_back(source.Describe());
+        }
+        const std::vector<unsigned int> programs = cache.LoadAll(descriptions);
+        for (size_t i = 0; i < missing.size(); ++i) {
+            missing[i].first->m_Variants.emplace(missing[i].second.Packed(), std::make_unique<Shader>(programs[i]));
+        }
+    }
+
+    // Détruit tous les programmes (contexte OpenGL requis)
+    void Destroy() {
+        for (auto& variant : m_Variants) {
+            if (variant.second->ID != 0) {
+                glDeleteProgram(variant.second->ID);
+            }
+        }
+        m_Variants.clear();
+    }
+
+    // Insère les defines juste après la ligne #version (ou en tête s'il n'y en a pas)
+    static std::string Preprocess(const std::string& source, const std::string& defines) {
+        const size_t version = source.find("#version");
+        if (version == std::string::npos) {
+            return defines + source;
+        }
+        const size_t lineEnd = source.find('\n', version);
+        if (lineEnd == std::string::npos) {
+            return source + "\n" + defines;
+        }
+        std::string result = source;
+        result.insert(lineEnd + 1, defines);
+        return result;
+    }
+
+private:
+    // Sources prétraitées d'une variante (gardées en vie pendant la compilation)
+    struct VariantSource {
+        std::string name;
+        std::string vertex;
+        std::string fragment;
+
+        ShaderSource Describe() const {
+            ShaderSource source;
+            source.name = name;
+            source.vertexSource = vertex.c_str();
+            source.fragmentSource = fragment.c_str();
+            return source;
+        }
+    };
+
+    VariantSource Source(const ShaderVariantKey& key) const {
+        const std::string defines = key.Defines();
+        VariantSource source;
+        source.name = m_Name + "[features=" + std::to_string(key.features) +
+                      ", lights=" + std::to_string(key.Lights()) + "]";
+        source.vertex = Preprocess(m_VertexSource, defines);
+        source.fragment = Preprocess(m_FragmentSource, defines);
+        return source;
+    }
+
+    std::string m_Name;
+    std::string m_VertexSource;
+    std::string m_FragmentSource;
+    std::unordered_map<uint64_t, std::unique_ptr<Shader>> m_Variants;
+};
@@ -0,0 +1,167 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Log.h"
+
+// En-tête d'un snapshot du monde ECS (voir Coordinator::SaveSnapshot)
+struct SnapshotHeader {
+    char magic[4] = {'G', 'E', 'S', 'N'};
+    uint32_t version = 1;
+    uint32_t flags = 0;               // SnapshotFlags
+    uint32_t componentTypeCount = 0;
+    uint64_t baseHash = 0;            // Delta : empreinte du snapshot complet de référence
+};
+
+enum SnapshotFlags : uint32_t {
+    SNAPSHOT_DELTA = 1u << 0   // Seulement ce qui a changé depuis un snapshot complet
+};
+
+// ============================================
+// SnapshotWriter - Écriture binaire dans un tampon mémoire
+// ============================================
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::vector<uint8_t>& buffer) : m_Buffer(buffer) {}
+
+    void WriteBytes(const void* data, size_t size) {
+        if (size == 0) {
+            return;
+        }
+        const size_t offset = m_Buffer.size();
+        m_Buffer.resize(offset + size);
+        std::memcpy(m_Buffer.data() + offset, data, size);
+    }
+
+    template<typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Write requires a trivially copyable type");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteString(const std::string& text) {
+        Write(static_cast<uint32_t>(text.size()));
+        WriteBytes(text.data(), text.size());
+    }
+
+    // Réserve la place d'une valeur connue plus tard (taille d'une section)
+    size_t Reserve(size_t size) {
+        const size_t offset = m_Buffer.size();
+        m_Buffer.resize(offset + size);
+        return offset;
+    }
+
+    template<typename T>
+    void Patch(size_t offset, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Patch requires a trivially copyable type");
+        std::memcpy(m_Buffer.data() + offset, &value, sizeof(T));
+    }
+
+    size_t Size() const { return m_Buffer.size(); }
+
+private:
+    std::vector<uint8_t>& m_Buffer;
+};
+
+// ============================================
+// SnapshotReader - Lecture binaire bornée
+// ============================================
+// Toutes les lectures vérifient la taille restante : un snapshot tronqué ou
+// corrompu fait échouer le chargement au lieu de lire hors du tampon.
+class SnapshotReader {
+public:
+    SnapshotReader() = default;
+    SnapshotReader(const uint8_t* data, size_t size) : m_Data(data), m_Size(size) {}
+
+    // Avance de size octets ; data pointe sur le début de la zone
+    bool Take(size_t size, const uint8_t*& data) {
+        if (size > m_Size - m_Offset) {
+            return false;
+        }
+        data = m_Data + m_Offset;
+        m_Offset += size;
+        return true;
+    }
+
+    bool ReadBytes(void* out, size_t size) {
+        const uint8_t* data = nullptr;
+        if (!Take(size, data)) {
+            return false;
+        }
+        if (size > 0) {
+            std::memcpy(out, data, size);
+        }
+        return true;
+    }
+
+    template<typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Read requires a trivially copyable type");
+        return ReadBytes(&value, sizeof(T));
+    }
+
+    bool ReadString(std::string& text) {
+        uint32_t length = 0;
+        const uint8_t* data = nullptr;
+        if (!Read(length) || !Take(length, data)) {
+            return false;
+        }
+        text.assign(reinterpret_cast<const char*>(data), length);
+        return true;
+    }
+
+    const uint8_t* Data() const { return m_Data; }
+    size_t Offset() const { return m_Offset; }
+    size_t Remaining() const { return m_Size - m_Offset; }
+
+private:
+    const uint8_t* m_Data = nullptr;
+    size_t m_Size = 0;
+    size_t m_Offset = 0;
+};
+
+// ============================================
+// SnapshotCodec - Encodage d'un component dans un snapshot
+// ============================================
+// Les types trivialement copiables sont écrits tels quels, et en un seul bloc
+// pour tout un tableau de components. Les autres (std::string...) doivent
+// spécialiser SnapshotCodec, sinon SaveSnapshot échoue (un snapshot sans
+// eux les effacerait au chargement).
+template<typename T, typename Enable = void>
+struct SnapshotCodec {
+    static constexpr bool SUPPORTED = false;
+    static void Write(SnapshotWriter&, const T&) {}
+    static bool Read(SnapshotReader&, T&) { return false; }
+};
+
+template<typename T>
+struct SnapshotCodec<T, std::enable_if_t<std::is_trivially_copyable_v<T>>> {
+    static constexpr bool SUPPORTED = true;
+    static void Write(SnapshotWriter& writer, const T& value) { writer.Write(value); }
+    static bool Read(SnapshotReader& reader, T& value) { return reader.Read(value); }
+};
+
+inline bool WriteSnapshotFile(const std::string& path, const std::vector<uint8_t>& data) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to create snapshot: " << path);
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return file.good();
+}
+
+inline bool ReadSnapshotFile(const std::string& path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open snapshot: " << path);
+        return false;
+    }
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
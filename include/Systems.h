@@ -1,7 +1,18 @@
 #pragma once
 #include "ECS.h"
 #include "Components.h"
-#include <iostream>
+#include "Animation.h"
+#include "Camera.h"
+#include "ClusteredLighting.h"
+#include "Log.h"
+#include "MeshLOD.h"
+#include "Profiler.h"
+#include "ResourceManager.h"
+#include "SceneBVH.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
 
 // ============================================
 // PhysicsSystem - Gère le mouvement et la physique
@@ -9,13 +20,15 @@
 class PhysicsSystem : public System {
 public:
     void Update(Coordinator& coordinator, double deltaTime) {
+        PROFILE_SCOPE("PhysicsSystem");
         const float dt = static_cast<float>(deltaTime);
         const glm::vec3 gravity(0.0f, -9.81f, 0.0f);
+        const bool logPositions = ++m_FrameCount % 60 == 0;
 
         for (auto const& entity : m_Entities) {
             auto& transform = coordinator.GetComponent<Transform>(entity);
             auto& velocity = coordinator.GetComponent<Velocity>(entity);
-            auto& rigidBody = coordinator.GetComponent<RigidBody>(entity);
+            const auto& rigidBody = coordinator.ReadComponent<RigidBody>(entity);
 
             // Appliquer la gravité si activée
             if (rigidBody.useGravity) {
@@ -32,34 +45,368 @@ public:
             transform.rotation += velocity.angular * dt;
 
             // Debug: afficher la position toutes les 60 frames
-            static int frameCount = 0;
-            if (++frameCount % 60 == 0) {
-                auto& tag = coordinator.GetComponent<Tag>(entity);
-                std::cout << tag.name << " - Position: (" 
+            if (logPositions) {
+                LOG_DEBUG(Label(coordinator, entity) << " - Position: ("
                           << transform.position.x << ", "
                           << transform.position.y << ", "
-                          << transform.position.z << ")" << std::endl;
+                          << transform.position.z << ")");
             }
         }
     }
+
+private:
+    // Nom du Tag, sinon l'identifiant de l'entité (le Tag est facultatif)
+    static std::string Label(Coordinator& coordinator, Entity entity) {
+        return coordinator.HasComponent<Tag>(entity) ? coordinator.ReadComponent<Tag>(entity).name
+                                                     : "Entity " + std::to_string(entity);
+    }
+
+    uint64_t m_FrameCount = 0;
 };
 
 // ============================================
-// RenderSystem - Gère le rendu (pour l'instant juste du debug)
+// DeformationSystem - Meshes animés (Transform + Mesh + Deformable)
 // ============================================
+// Garde un DeformedMesh par entité, construit depuis le DeformableMesh de son
+// mesh (MESH_LOAD_DEFORMABLE) et reconstruit quand celui-ci change (morph
+// targets ou skinning ajoutés, placeholder remplacé). La pose n'est
+// réappliquée que si le component Deformable a été écrit depuis le passage
+// précédent. Chemin GPU par défaut ; SetMode(CPU) déforme sur les threads du
+// pool (même rendu, sans vertex shader spécial). Le culling et la sélection
+// se font sur le mesh au repos : les déformations doivent rester dans sa boîte.
+class DeformationSystem : public System {
+public:
+    // À appeler chaque frame avant le rendu (thread principal)
+    void Update(Coordinator& coordinator, ResourceManager& resources, ThreadPool* pool = nullptr) {
+        PROFILE_SCOPE("DeformationSystem");
+        // Entités sorties du système
+        for (auto it = m_Instances.begin(); it != m_Instances.end();) {
+            if (!m_Entities.count(it->first)) {
+                it->second.Cleanup();
+                it = m_Instances.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        for (auto const& entity : m_Entities) {
+            const auto& deformable = coordinator.ReadComponent<Deformable>(entity);
+            const DeformableMesh* source = resources.GetMeshDeformable(coordinator.ReadComponent<Mesh>(entity).meshID);
+            DeformedMesh& instance = m_Instances[entity];
+            if (!source || !deformable.enabled) {
+                instance.Cleanup();
+                continue;
+            }
+
+            const bool rebuilt = instance.Revision() != source->revision;
+            if (rebuilt) {
+                instance.Setup(*source, m_Mode);
+            }
+            if (rebuilt || coordinator.HasChanged<Deformable>(entity, m_LastRunTick)) {
+                m_Pose.morphWeights = deformable.morphWeights;
+                source->skeleton.ComputeSkinMatrices(deformable.jointPose, m_Pose.skinMatrices);
+                instance.Update(*source, m_Pose, pool);
+            }
+        }
+        coordinator.EndSystemRun(*this);
+    }
+
+    // Mesh déformé à dessiner pour cette entité (nullptr : dessiner le mesh au repos)
+    const DeformedMesh* Find(Entity entity) const {
+        auto it = m_Instances.find(entity);
+        return it != m_Instances.end() && it->second.IsReady() ? &it->second : nullptr;
+    }
+
+    // Les instances sont reconstruites au prochain Update
+    void SetMode(DeformationMode mode) {
+        m_Mode = mode;
+        Cleanup();
+    }
+
+    DeformationMode GetMode() const { return m_Mode; }
+
+    // Libère les buffers (contexte OpenGL requis)
+    void Cleanup() {
+        for (auto& instance : m_Instances) {
+            instance.second.Cleanup();
+        }
+        m_Instances.clear();
+    }
+
+private:
+    DeformationMode m_Mode = DeformationMode::GPU;
+    std::unordered_map<Entity, DeformedMesh> m_Instances;
+    DeformationPose m_Pose;
+};
+
+// ============================================
+// RenderContext - Paramètres communs à tous les objets d'une frame
+// ============================================
+struct RenderContext {
+    glm::mat4 view{1.0f};
+    glm::mat4 projection{1.0f};
+    const FPSCamera* camera = nullptr; // Pour le choix du LOD (niveau 0 si nul)
+    glm::vec3 lightPos{3.0f, 3.0f, 3.0f};
+    glm::vec3 lightColor{1.0f, 1.0f, 1.0f};
+    const LightClusterer* lights = nullptr; // Lumières supplémentaires, déjà envoyées (Upload)
+    glm::vec2 viewportSize{1280.0f, 720.0f};
+    const SceneBVH* scene = nullptr;        // Si présent : seules les entités dans le frustum sont dessinées
+    const OcclusionCuller* occlusion = nullptr; // Si présent : les entités cachées par les occulteurs sont ignorées
+    const DeformationSystem* deformation = nullptr; // Si présent : les entités animées dessinent leur mesh déformé
+};
+
+// ============================================
+// RenderSystem - Dessine les entités Transform + Mesh
+// ============================================
+// Mesh::meshID et Mesh::materialID sont résolus par le ResourceManager ;
+// les entités dont le mesh ou le matériau manque sont ignorées.
 class RenderSystem : public System {
 public:
-    void Render(Coordinator& coordinator) {
-        // Pour l'instant, on fait juste un rendu debug
-        // Plus tard, on intégrera OpenGL/Vulkan ici
-        
+    void Render(Coordinator& coordinator, ResourceManager& resources, const RenderContext& context) {
+        PROFILE_SCOPE("RenderSystem");
+        const Shader* current = nullptr;
+
+        // Élimination hors champ par l'index spatial, sinon toutes les entités
+        m_Visible.clear();
+        if (context.scene) {
+            context.scene->QueryFrustum(Frustum::FromMatrix(context.projection * context.view), [&](uint32_t id) {
+                if (m_Entities.count(static_cast<Entity>(id))) {
+                    m_Visible.push_back(static_cast<Entity>(id));
+                }
+            });
+        } else {
+            m_Visible.assign(m_Entities.begin(), m_Entities.end());
+        }
+
+        for (Entity entity : m_Visible) {
+            const auto& transform = coordinator.ReadComponent<Transform>(entity);
+            const auto& mesh = coordinator.ReadComponent<Mesh>(entity);
+
+            const LODChain* lods = resources.GetMesh(mesh.meshID);
+            const Material* material = resources.GetMaterial(mesh.materialID);
+            if (!lods || lods->Empty() || !material) {
+                continue;
+            }
+
+            glm::mat4 model = ModelMatrix(transform);
+            if (context.occlusion && !context.occlusion->IsVisible(lods->Bounds().Transform(model))) {
+                continue;
+            }
+
+            // Mesh déformé (pleine résolution), sinon le niveau de détail adapté à la taille à l'écran
+            const DeformedMesh* deformed = context.deformation ? context.deformation->Find(entity) : nullptr;
+            size_t lod = context.camera && !deformed ? LODSelector::Select(*lods, model, *context.camera) : 0;
+            const MeshData& meshData = deformed ? deformed->GetMesh() : lods->levels[lod].mesh;
+
+            // Variante sans inversion de matrice par vertex ni décodage inutile
+            ShaderVariantKey variant = VariantFor(meshData.layout);
+            if (deformed) {
+                variant.features |= deformed->ShaderFeatures();
+            }
+            if (context.lights) {
+                variant.features |= SHADER_CLUSTERED_LIGHTING;
+            }
+            Shader* shader = resources.GetShader(material->shaderID, variant);
+            if (!shader) {
+                continue;
+            }
+
+            // Uniforms de la frame : seulement quand le programme change
+            if (shader != current) {
+                current = shader;
+                shader->Use();
+                shader->SetMat4("view", context.view);
+                shader->SetMat4("projection", context.projection);
+                shader->SetVec3("lightPos", context.lightPos);
+                shader->SetVec3("lightColor", context.lightColor);
+                if (context.camera) {
+                    shader->SetVec3("viewPos", context.camera->Position);
+                }
+                if (context.lights) {
+                    context.lights->Bind(*shader, context.viewportSize);
+                }
+            }
+
+            shader->SetMat4("model", model);
+            shader->SetMat3("normalMatrix", glm::mat3(glm::transpose(glm::inverse(model))));
+            shader->SetVec3("objectColor", material->color);
+            shader->SetVertexLayout(meshData.layout);
+            if (deformed) {
+                deformed->Bind(*shader);
+            }
+            meshData.Draw();
+        }
+    }
+
+    // Fonctionnalités du shader pour un mesh non instancié
+    static ShaderVariantKey VariantFor(const VertexLayout& layout) {
+        uint32_t features = SHADER_CPU_NORMAL_MATRIX;
+        if (layout.IsQuantized()) {
+            features |= SHADER_QUANTIZED_VERTICES;
+        }
+        return ShaderVariantKey(features);
+    }
+
+    // Translation * rotation (angles d'Euler en degrés, ordre Y, X, Z) * échelle
+    static glm::mat4 ModelMatrix(const Transform& transform) {
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), transform.position);
+        model = glm::rotate(model, glm::radians(transform.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+        model = glm::rotate(model, glm::radians(transform.rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+        model = glm::rotate(model, glm::radians(transform.rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+        return glm::scale(model, transform.scale);
+    }
+
+private:
+    std::vector<Entity> m_Visible;
+};
+
+// ============================================
+// OcclusionSystem - Tampon de profondeur des occulteurs (Transform + Mesh + Occluder)
+// ============================================
+// Update rastérise sur le CPU la géométrie d'occultation des entités (niveau
+// 0, voir MESH_LOAD_OCCLUDER et OccluderMesh) ; le culler est
+// ensuite passé au RenderSystem par RenderContext::occlusion. Les entités
+// déformées (Deformable actif) sont ignorées : leur géométrie au repos peut
+// dépasser le mesh affiché et cacher à tort ce qui est juste derrière.
+class OcclusionSystem : public System {
+public:
+    // À appeler chaque frame avant le rendu
+    void Update(Coordinator& coordinator, ResourceManager& resources, const glm::mat4& viewProjection,
+                ThreadPool* pool = nullptr) {
+        PROFILE_SCOPE("OcclusionSystem");
+        m_Culler.Begin(viewProjection);
         for (auto const& entity : m_Entities) {
-        (void)entity; // Évite le warning
-        (void)coordinator; // Évite le warning
-        // auto& transform = coordinator.GetComponent<Transform>(entity);
-        // auto& mesh = coordinator.GetComponent<Mesh>(entity);
-            // Ici, on rendrait le mesh à la position du transform
-            // Pour l'instant, c'est juste un placeholder
+            if (!coordinator.ReadComponent<Occluder>(entity).enabled ||
+                (coordinator.HasComponent<Deformable>(entity) && coordinator.ReadComponent<Deformable>(entity).enabled)) {
+                continue;
+            }
+            const OccluderMesh* mesh = resources.GetMeshOccluder(coordinator.ReadComponent<Mesh>(entity).meshID);
+            if (mesh) {
+                m_Culler.AddOccluder(*mesh, RenderSystem::ModelMatrix(coordinator.ReadComponent<Transform>(entity)));
+            }
+        }
+        m_Culler.Rasterize(pool);
+    }
+
+    OcclusionCuller& GetCuller() { return m_Culler; }
+    const OcclusionCuller& GetCuller() const { return m_Culler; }
+
+private:
+    OcclusionCuller m_Culler;
+};
+
+// ============================================
+// SceneIndexSystem - Index spatial (SceneBVH) des entités
+// ============================================
+// Signature choisie par l'application (au moins Transform). La boîte d'une
+// entité vient de son component BoundingBox, sinon de son mesh, sinon c'est
+// un cube unité ; elle est transformée par la matrice modèle. Update insère,
+// déplace et retire les entités puis applique les changements (refit ou
+// reconstruction), une fois par frame avant le rendu. Seules les entités
+// nouvelles, celles dont Transform, BoundingBox ou Mesh a changé depuis le
+// passage précédent, et celles dont le mesh n'est pas encore chargé sont
+// recalculées : le coût suit ce qui bouge, pas la taille de la scène.
+class SceneIndexSystem : public System {
+public:
+    void Update(Coordinator& coordinator, ResourceManager& resources) {
+        PROFILE_SCOPE("SceneIndexSystem");
+        // Entités entrées ou sorties du système, ou dont la liste de components a changé
+        m_Dirty.swap(m_PendingMesh);
+        m_PendingMesh.clear();
+        coordinator.ForEachSignatureChanged(m_LastRunTick, [&](Entity entity) {
+            if (m_Entities.count(entity)) {
+                m_Dirty.push_back(entity);
+            } else if (m_Indexed.erase(entity)) {
+                m_BVH.Remove(entity);
+            }
+        });
+
+        // Entités dont la boîte a pu changer
+        auto markChanged = [&](Entity entity, const auto&) {
+            if (m_Entities.count(entity)) {
+                m_Dirty.push_back(entity);
+            }
+        };
+        coordinator.ForEachChanged<Transform>(m_LastRunTick, markChanged);
+        coordinator.ForEachChanged<BoundingBox>(m_LastRunTick, markChanged);
+        coordinator.ForEachChanged<Mesh>(m_LastRunTick, markChanged);
+        std::sort(m_Dirty.begin(), m_Dirty.end());
+        m_Dirty.erase(std::unique(m_Dirty.begin(), m_Dirty.end()), m_Dirty.end());
+
+        for (Entity entity : m_Dirty) {
+            if (!m_Entities.count(entity)) {
+                continue;
+            }
+            bool pendingMesh = false;
+            const AABB bounds = LocalBounds(coordinator, resources, entity, pendingMesh)
+                                    .Transform(RenderSystem::ModelMatrix(coordinator.ReadComponent<Transform>(entity)));
+            if (pendingMesh) {
+                m_PendingMesh.push_back(entity);
+            }
+            auto it = m_Indexed.find(entity);
+            if (it == m_Indexed.end()) {
+                m_Indexed.emplace(entity, bounds);
+                m_BVH.Insert(entity, bounds);
+            } else if (it->second.min != bounds.min || it->second.max != bounds.max) {
+                it->second = bounds;
+                m_BVH.Update(entity, bounds);
+            }
         }
+        m_BVH.Commit();
+        coordinator.EndSystemRun(*this);
+    }
+
+    // Entité sous le rayon (par exemple le centre de l'écran), sur les boîtes
+    RayHit Pick(const Ray& ray, float maxDistance = FLT_MAX) const {
+        return m_BVH.Raycast(ray, maxDistance);
     }
-};
\ No newline at end of file
+
+    // Sélection précise : triangles des meshes chargés avec un MeshBVH, boîtes
+    // pour les autres entités. La distance reste en espace monde.
+    RayHit Pick(Coordinator& coordinator, ResourceManager& resources, const Ray& ray, float maxDistance = FLT_MAX) const {
+        return m_BVH.Raycast(ray, maxDistance, [&](uint32_t id, float boxDistance) {
+            const Entity entity = static_cast<Entity>(id);
+            const MeshBVH* triangles = coordinator.HasComponent<Mesh>(entity)
+                ? resources.GetMeshBVH(coordinator.ReadComponent<Mesh>(entity).meshID) : nullptr;
+            if (!triangles) {
+                return boxDistance;
+            }
+
+            // Rayon en espace objet
+            const glm::mat4 model = RenderSystem::ModelMatrix(coordinator.ReadComponent<Transform>(entity));
+            const glm::mat4 inverse = glm::inverse(model);
+            const Ray local(glm::vec3(inverse * glm::vec4(ray.origin, 1.0f)), glm::vec3(inverse * glm::vec4(ray.direction, 0.0f)));
+            const MeshHit hit = triangles->Raycast(local);
+            if (!hit.Hit()) {
+                return -1.0f;
+            }
+            return glm::length(glm::vec3(model * glm::vec4(local.At(hit.distance), 1.0f)) - ray.origin);
+        });
+    }
+
+    const SceneBVH& GetBVH() const { return m_BVH; }
+
+private:
+    // pendingMesh : l'entité a un mesh pas encore chargé, la boîte est provisoire
+    static AABB LocalBounds(Coordinator& coordinator, ResourceManager& resources, Entity entity, bool& pendingMesh) {
+        if (coordinator.HasComponent<BoundingBox>(entity)) {
+            const BoundingBox& box = coordinator.ReadComponent<BoundingBox>(entity);
+            return AABB(box.min, box.max);
+        }
+        AABB bounds;
+        if (coordinator.HasComponent<Mesh>(entity)) {
+            if (resources.GetMeshBounds(coordinator.ReadComponent<Mesh>(entity).meshID, bounds)) {
+                return bounds;
+            }
+            pendingMesh = true;
+        }
+        return AABB(glm::vec3(-0.5f), glm::vec3(0.5f));
+    }
+
+    SceneBVH m_BVH;
+    // Boîte monde actuelle de chaque entité indexée
+    std::unordered_map<Entity, AABB, std::hash<Entity>, std::equal_to<Entity>,
+                       PoolAllocator<std::pair<const Entity, AABB>>> m_Indexed;
+    std::vector<Entity> m_Dirty;                  // À recalculer ce passage
+    std::vector<Entity> m_PendingMesh;            // Mesh en cours de chargement : recalculées au passage suivant
+};
@@ -0,0 +1,120 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "Profiler.h"
+
+// ============================================
+// ThreadPool - Threads de travail pour les tâches CPU
+// ============================================
+// Les tâches ne doivent faire aucun appel OpenGL : le contexte n'existe que
+// sur le thread principal. À la destruction, les tâches pas encore
+// commencées sont abandonnées (leurs futures lèvent std::future_error).
+class ThreadPool {
+public:
+    // threadCount = 0 : un thread par cœur, moins le thread principal
+    explicit ThreadPool(size_t threadCount = 0) {
+        if (threadCount == 0) {
+            const size_t cores = std::thread::hardware_concurrency();
+            threadCount = cores > 1 ? cores - 1 : 1;
+        }
+        m_Workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            m_Workers.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stopping = true;
+            std::queue<std::function<void()>>().swap(m_Tasks);
+        }
+        m_Condition.notify_all();
+        for (auto& worker : m_Workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template<typename F>
+    auto Submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Tasks.emplace([packaged] { (*packaged)(); });
+        }
+        m_Condition.notify_one();
+        return future;
+    }
+
+    // Découpe [0, count) en blocs d'au moins minBlock éléments et appelle
+    // body(begin, end) en parallèle ; le thread appelant traite aussi un bloc,
+    // puis attend les autres : ils passent après les tâches déjà en file, d'où
+    // un pool réservé aux travaux de la frame (GameEngine::GetFrameJobs)
+    template<typename F>
+    void ParallelFor(size_t count, F&& body, size_t minBlock = 1) {
+        if (count == 0) {
+            return;
+        }
+        const size_t maxBlocks = (count + std::max<size_t>(minBlock, 1) - 1) / std::max<size_t>(minBlock, 1);
+        const size_t blocks = std::min(maxBlocks, m_Workers.size() + 1);
+        if (blocks <= 1) {
+            body(size_t(0), count);
+            return;
+        }
+
+        const size_t blockSize = (count + blocks - 1) / blocks;
+        std::vector<std::future<void>> pending;
+        pending.reserve(blocks - 1);
+        for (size_t b = 1; b < blocks; ++b) {
+            const size_t begin = b * blockSize;
+            const size_t end = std::min(count, begin + blockSize);
+            if (begin < end) {
+                pending.push_back(Submit([&body, begin, end] { body(begin, end); }));
+            }
+        }
+        body(size_t(0), std::min(count, blockSize));
+        for (auto& future : pending) {
+            future.get();
+        }
+    }
+
+    size_t ThreadCount() const { return m_Workers.size(); }
+
+private:
+    void WorkerLoop() {
+        PROFILE_THREAD("Worker");
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Condition.wait(lock, [this] { return m_Stopping || !m_Tasks.empty(); });
+                if (m_Stopping) {
+                    return;
+                }
+                task = std::move(m_Tasks.front());
+                m_Tasks.pop();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> m_Workers;
+    std::queue<std::function<void()>> m_Tasks;
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    bool m_Stopping = false;
+};
@@ -0,0 +1,218 @@
+#pragma once
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "Bounds.h"
+
+// ============================================
+// VertexFormat - Encodage des vertices côté GPU
+// ============================================
+// Float32         : position, normale, UV en float (32 octets)
+// QuantizedOct16  : position 4 x unorm16 relative aux bornes + normale octaédrique 2 x snorm16 (12 octets)
+// QuantizedPacked : position 4 x unorm16 relative aux bornes + normale 10:10:10:2 (12 octets)
+// Les formats quantifiés ne conservent pas les UV (aucun shader ne les lit).
+enum class VertexFormat : uint32_t {
+    Float32 = 0,
+    QuantizedOct16 = 1,
+    QuantizedPacked = 2
+};
+
+// ============================================
+// VertexAttribute - Un attribut dans le VBO
+// ============================================
+// Structure POD : elle est écrite telle quelle dans les fichiers de mesh cuits.
+struct VertexAttribute {
+    uint32_t location = 0;
+    uint32_t components = 0;
+    uint32_t type = GL_FLOAT;   // Type OpenGL (GL_FLOAT, GL_UNSIGNED_SHORT...)
+    uint32_t normalized = 0;
+    uint32_t offset = 0;        // Décalage en octets dans le vertex
+};
+
+// ============================================
+// VertexLayout - Disposition des vertices envoyés au GPU
+// ============================================
+// Contient aussi de quoi décoder les positions quantifiées dans le shader :
+// position = positionOffset + aPos * positionScale
+struct VertexLayout {
+    static constexpr uint32_t MAX_ATTRIBUTES = 4;
+
+    uint32_t stride = 0;
+    uint32_t attributeCount = 0;
+    VertexAttribute attributes[MAX_ATTRIBUTES];
+
+    VertexFormat format = VertexFormat::Float32;
+    float positionScale[3] = {1.0f, 1.0f, 1.0f};
+    float positionOffset[3] = {0.0f, 0.0f, 0.0f};
+
+    void Add(uint32_t location, uint32_t components, uint32_t type, bool normalized, uint32_t offset) {
+        if (attributeCount >= MAX_ATTRIBUTES) {
+            return;
+        }
+        VertexAttribute& attribute = attributes[attributeCount++];
+        attribute.location = location;
+        attribute.components = components;
+        attribute.type = type;
+        attribute.normalized = normalized ? 1 : 0;
+        attribute.offset = offset;
+    }
+
+    // Position + Normale + UV en float (32 octets)
+    static VertexLayout Float32() {
+        VertexLayout layout;
+        layout.stride = 8 * sizeof(float);
+        layout.Add(0, 3, GL_FLOAT, false, 0);
+        layout.Add(1, 3, GL_FLOAT, false, 3 * sizeof(float));
+        layout.Add(2, 2, GL_FLOAT, false, 6 * sizeof(float));
+        return layout;
+    }
+
+    // Position quantifiée dans bounds + normale compressée (12 octets)
+    static VertexLayout Quantized(VertexFormat normalFormat, const AABB& bounds) {
+        VertexLayout layout;
+        layout.format = normalFormat;
+        layout.stride = 4 * sizeof(uint16_t) + sizeof(uint32_t);
+        layout.Add(0, 4, GL_UNSIGNED_SHORT, true, 0);
+        if (normalFormat == VertexFormat::QuantizedOct16) {
+            layout.Add(1, 2, GL_SHORT, true, 4 * sizeof(uint16_t));
+        } else {
+            layout.Add(1, 4, GL_INT_2_10_10_10_REV, true, 4 * sizeof(uint16_t));
+        }
+
+        const glm::vec3 size = bounds.IsValid() ? bounds.Size() : glm::vec3(0.0f);
+        for (int i = 0; i < 3; ++i) {
+            layout.positionOffset[i] = bounds.IsValid() ? bounds.min[i] : 0.0f;
+            layout.positionScale[i] = size[i] > 0.0f ? size[i] : 1.0f;
+        }
+        return layout;
+    }
+
+    static VertexLayout ForFormat(VertexFormat format, const AABB& bounds) {
+        return format == VertexFormat::Float32 ? Float32() : Quantized(format, bounds);
+    }
+
+    bool IsQuantized() const { return format != VertexFormat::Float32; }
+    bool HasOctNormals() const { return format == VertexFormat::QuantizedOct16; }
+
+    // Encode des vertices (x,y,z, nx,ny,nz, u,v...) dans ce format ;
+    // out doit contenir vertexCount * stride octets
+    void Encode(const float* vertices, size_t vertexCount, unsigned int floatsPerVertex, char* out) const {
+        if (!IsQuantized()) {
+            for (size_t v = 0; v < vertexCount; ++v) {
+                std::memcpy(out + v * stride, vertices + v * floatsPerVertex, stride);
+            }
+            return;
+        }
+
+        for (size_t v = 0; v < vertexCount; ++v) {
+            const float* src = vertices + v * floatsPerVertex;
+            char* dst = out + v * stride;
+
+            uint16_t position[4] = {0, 0, 0, 0xFFFF};
+            for (int i = 0; i < 3; ++i) {
+                float t = (src[i] - positionOffset[i]) / positionScale[i];
+                position[i] = static_cast<uint16_t>(std::lround(std::clamp(t, 0.0f, 1.0f) * 65535.0f));
+            }
+            std::memcpy(dst, position, sizeof(position));
+
+            const glm::vec3 normal(src[3], src[4], src[5]);
+            uint32_t packed;
+            if (HasOctNormals()) {
+                const glm::vec2 e = OctEncode(normal);
+                const uint16_t x = static_cast<uint16_t>(static_cast<int16_t>(std::lround(e.x * 32767.0f)));
+                const uint16_t y = static_cast<uint16_t>(static_cast<int16_t>(std::lround(e.y * 32767.0f)));
+                packed = static_cast<uint32_t>(x) | (static_cast<uint32_t>(y) << 16);
+            } else {
+                packed = PackSnorm1010102(normal);
+            }
+            std::memcpy(dst + sizeof(position), &packed, sizeof(packed));
+        }
+    }
+
+    // Position d'un vertex encodé dans ce format (inverse de Encode, à la quantification près)
+    glm::vec3 DecodePosition(const char* vertex) const {
+        if (!IsQuantized()) {
+            float position[3];
+            std::memcpy(position, vertex, sizeof(position));
+            return glm::vec3(position[0], position[1], position[2]);
+        }
+        uint16_t position[3];
+        std::memcpy(position, vertex, sizeof(position));
+        glm::vec3 result;
+        for (int i = 0; i < 3; ++i) {
+            result[i] = positionOffset[i] + position[i] / 65535.0f * positionScale[i];
+        }
+        return result;
+    }
+
+    // Normale d'un vertex encodé dans ce format
+    glm::vec3 DecodeNormal(const char* vertex) const {
+        if (!IsQuantized()) {
+            float normal[3];
+            std::memcpy(normal, vertex + 3 * sizeof(float), sizeof(normal));
+            return glm::vec3(normal[0], normal[1], normal[2]);
+        }
+        if (HasOctNormals()) {
+            int16_t e[2];
+            std::memcpy(e, vertex + 4 * sizeof(uint16_t), sizeof(e));
+            return OctDecode(glm::vec2(std::max(e[0] / 32767.0f, -1.0f), std::max(e[1] / 32767.0f, -1.0f)));
+        }
+        uint32_t packed;
+        std::memcpy(&packed, vertex + 4 * sizeof(uint16_t), sizeof(packed));
+        glm::vec3 normal;
+        for (int i = 0; i < 3; ++i) {
+            // Signe étendu depuis 10 bits
+            const uint32_t bits = (packed >> (10 * i)) & 0x3FF;
+            const int32_t value = (bits & 0x200) ? static_cast<int32_t>(bits) - 1024 : static_cast<int32_t>(bits);
+            normal[i] = std::max(value / 511.0f, -1.0f);
+        }
+        return normal;
+    }
+
+    // Configure les attributs du VAO actuellement lié
+    void Apply() const {
+        for (uint32_t i = 0; i < attributeCount; ++i) {
+            const VertexAttribute& attribute = attributes[i];
+            glEnableVertexAttribArray(attribute.location);
+            glVertexAttribPointer(attribute.location, attribute.components, attribute.type,
+                                  attribute.normalized ? GL_TRUE : GL_FALSE, stride,
+                                  reinterpret_cast<const void*>(static_cast<uintptr_t>(attribute.offset)));
+        }
+    }
+
+    // Projection octaédrique d'une direction sur [-1, 1]^2 (décodée par OctDecode dans le shader)
+    static glm::vec2 OctEncode(glm::vec3 n) {
+        const float sum = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+        if (sum <= 0.0f) {
+            return glm::vec2(0.0f);
+        }
+        n /= sum;
+        glm::vec2 e(n.x, n.y);
+        if (n.z < 0.0f) {
+            e = glm::vec2((1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+                          (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f));
+        }
+        return e;
+    }
+
+    static glm::vec3 OctDecode(const glm::vec2& e) {
+        glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+        const float t = std::max(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -t : t;
+        n.y += n.y >= 0.0f ? -t : t;
+        return glm::normalize(n);
+    }
+
+private:
+    static uint32_t PackSnorm1010102(const glm::vec3& n) {
+        uint32_t packed = 0;
+        for (int i = 0; i < 3; ++i) {
+            const int32_t value = static_cast<int32_t>(std::lround(std::clamp(n[i], -1.0f, 1.0f) * 511.0f));
+            packed |= (static_cast<uint32_t>(value) & 0x3FF) << (10 * i);
+        }
+        return packed;
+    }
+};
@@ -1,34 +1,55 @@
 #include "GameEngine.h"
 #include "Camera.h"
 #include "LightingShaders.h"
+#include "Log.h"
 #include "OBJLoader.h"
+#include "MeshLOD.h"
+#include "MeshCache.h"
+#include "Components.h"
+#include "Systems.h"
 #include <glad/glad.h>
-#include <iostream>
+#include <string>
 
-// Variables globales pour la souris
-float lastX = 640.0f;
-float lastY = 360.0f;
-bool firstMouse = true;
-FPSCamera* g_camera = nullptr;
+// Allocations par frame dans le registre de mesures (METRIC_ALLOCATIONS)
+GAMEENGINE_COUNT_ALLOCATIONS()
 
-void mouse_callback(GLFWwindow* window, double xpos, double ypos) {
-    (void)window;
-    
-    if (firstMouse) {
-        lastX = static_cast<float>(xpos);
-        lastY = static_cast<float>(ypos);
-        firstMouse = false;
-    }
+// Résultat d'une sélection au viseur, traité à la frame suivante (EventBus)
+struct PickEvent {
+    bool hit = false;
+    Entity entity = 0;
+    float distance = 0.0f;
+};
 
-    float xoffset = static_cast<float>(xpos) - lastX;
-    float yoffset = lastY - static_cast<float>(ypos);
+// ============================================
+// RigHeart - Contraction et torsion du cœur
+// ============================================
+// Morph target "systole" : les parois se rapprochent de l'axe vertical et la
+// pointe remonte vers la base. Deux articulations, base et pointe : la
+// pointe tourne autour de l'axe pendant la contraction (torsion du
+// ventricule), avec un poids qui croît de la base vers la pointe.
+static void RigHeart(DeformableMesh& heart) {
+    const glm::vec3 center = heart.bounds.Center();
+    const float top = heart.bounds.max.y;
+    const float height = std::max(heart.bounds.Size().y, 1e-4f);
 
-    lastX = static_cast<float>(xpos);
-    lastY = static_cast<float>(ypos);
+    std::vector<glm::vec3> systole(heart.vertexCount);
+    std::vector<uint8_t> joints(heart.vertexCount * MAX_SKIN_INFLUENCES, 0);
+    std::vector<float> weights(heart.vertexCount * MAX_SKIN_INFLUENCES, 0.0f);
+    for (size_t v = 0; v < heart.vertexCount; ++v) {
+        const glm::vec3 p = heart.Position(v);
+        systole[v] = glm::vec3(center.x - p.x, 0.0f, center.z - p.z) * 0.15f + glm::vec3(0.0f, top - p.y, 0.0f) * 0.08f;
 
-    if (g_camera) {
-        g_camera->ProcessMouseMovement(xoffset, yoffset);
+        const float apex = (top - p.y) / height;   // 0 à la base, 1 à la pointe
+        joints[v * MAX_SKIN_INFLUENCES + 1] = 1;
+        weights[v * MAX_SKIN_INFLUENCES] = 1.0f - apex * apex;
+        weights[v * MAX_SKIN_INFLUENCES + 1] = apex * apex;
     }
+    heart.AddMorphTarget("systole", systole);
+
+    Skeleton skeleton;
+    const uint32_t base = skeleton.AddJoint(-1, glm::translate(glm::mat4(1.0f), glm::vec3(center.x, top, center.z)));
+    skeleton.AddJoint(static_cast<int32_t>(base), glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -height, 0.0f)));
+    heart.SetSkin(std::move(skeleton), std::move(joints), std::move(weights));
 }
 
 // ============================================
@@ -37,158 +58,346 @@ void mouse_callback(GLFWwindow* window, double xpos, double ypos) {
 class MedicalSimulator : public GameEngine {
 public:
     void Init() override {
-        std::cout << "=== Medical Anatomy Visualizer ===" << std::endl;
+        LOG_INFO("=== Medical Anatomy Visualizer ===");
 
         GameEngine::Init();
 
         // Configuration souris
         glfwSetInputMode(GetRenderer().GetWindow(), GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-        glfwSetCursorPosCallback(GetRenderer().GetWindow(), mouse_callback);
 
         // Caméra
         m_Camera = FPSCamera(glm::vec3(0.0f, 0.0f, 5.0f));
-        g_camera = &m_Camera;
+
+        // ECS : le cœur est une entité Transform + Mesh dessinée par le RenderSystem
+        Coordinator& coordinator = GetCoordinator();
+        coordinator.RegisterComponent<Transform>();
+        coordinator.RegisterComponent<Mesh>();
+        m_RenderSystem = coordinator.RegisterSystem<RenderSystem>();
+        Signature renderSignature;
+        renderSignature.set(coordinator.GetComponentType<Transform>());
+        renderSignature.set(coordinator.GetComponentType<Mesh>());
+        coordinator.SetSystemSignature<RenderSystem>(renderSignature);
+
+        // Index spatial de tout ce qui a une position (culling, sélection au viseur)
+        coordinator.RegisterComponent<BoundingBox>();
+        m_SceneIndex = coordinator.RegisterSystem<SceneIndexSystem>();
+        Signature sceneSignature;
+        sceneSignature.set(coordinator.GetComponentType<Transform>());
+        coordinator.SetSystemSignature<SceneIndexSystem>(sceneSignature);
+
+        // Occultation sur le CPU : les organes marqués Occluder cachent ce qui est derrière eux
+        coordinator.RegisterComponent<Occluder>();
+        m_Occlusion = coordinator.RegisterSystem<OcclusionSystem>();
+        Signature occlusionSignature = renderSignature;
+        occlusionSignature.set(coordinator.GetComponentType<Occluder>());
+        coordinator.SetSystemSignature<OcclusionSystem>(occlusionSignature);
+
+        // Meshes animés (battement du cœur) : morph targets et skinning
+        coordinator.RegisterComponent<Deformable>();
+        m_Deformation = coordinator.RegisterSystem<DeformationSystem>();
+        Signature deformationSignature = renderSignature;
+        deformationSignature.set(coordinator.GetComponentType<Deformable>());
+        coordinator.SetSystemSignature<DeformationSystem>(deformationSignature);
+
+        // Événements de l'application
+        GetEvents().Register<PickEvent>(16);
 
         // Shaders avec éclairage
-        m_Shader = new Shader(lightingVertexShader, lightingFragmentShader);
+        ResourceManager& resources = GetResources();
+        uint32_t lightingShader = resources.LoadShader("lighting", lightingVertexShader, lightingFragmentShader);
+        m_HeartMaterial = resources.CreateMaterial("heart", Material(lightingShader, glm::vec3(0.8f, 0.1f, 0.1f))); // Rouge par défaut
 
         // Créer un modèle de cœur (sphère pour le moment)
         // Tu pourras remplacer par un vrai modèle .obj de cœur plus tard
         //m_HeartModel = MeshGenerator::CreateSphere(1.0f, 36, 18);//cette ligne a été remplacée par le bloc de code qui suit
 
 	/* ------------------Code de remplaceent-----------------------*/
-	std::cout << "Loading heart model..." << std::endl;
-	if (!OBJLoader::LoadOBJ("models/heart.obj", m_HeartModel)) {
-	    std::cout << "Failed to load heart.obj, using sphere fallback" << std::endl;
-	    m_HeartModel = MeshGenerator::CreateSphere(1.0f, 36, 18);
-	} else {
-	    std::cout << "Heart model loaded successfully!" << std::endl;
-	}
+	LOG_INFO("Loading heart model...");
+	// Sphère affichée tant que le cœur n'est pas prêt (ou s'il est introuvable)
+	// Vertices quantifiés (12 octets au lieu de 32) : la bande passante est le facteur limitant
+	LODChain sphere = LODGenerator::BuildSphere(1.0f, 36, 18);
+	sphere.Setup(VertexFormat::QuantizedOct16);
+	uint32_t placeholder = resources.AddMesh("sphere", std::move(sphere), MESH_LOAD_BVH | MESH_LOAD_DEFORMABLE);
+
+	// Cuit au premier lancement (cache/), puis chargé par projection mémoire, en arrière-plan ;
+	// BVH des triangles pour la sélection précise au viseur, niveau 0 au repos pour l'animation.
+	// Pas d'occulteur : le cœur se contracte jusqu'à 15 % sous sa forme au repos
+	m_HeartMesh = resources.LoadMesh("models/heart.obj", VertexFormat::QuantizedOct16, placeholder,
+	                                 MESH_LOAD_BVH | MESH_LOAD_DEFORMABLE);
+
+	m_Heart = coordinator.CreateEntity();
+	coordinator.AddComponent(m_Heart, Transform());
+	coordinator.AddComponent(m_Heart, Mesh(m_HeartMesh, m_HeartMaterial));
+	coordinator.AddComponent(m_Heart, Deformable());
 	/*--------------------------------------------------------------*/
 
-        std::cout << "\n=== Controls ===" << std::endl;
-        std::cout << "WASD - Move camera" << std::endl;
-        std::cout << "Mouse - Look around" << std::endl;
-        std::cout << "Space/Shift - Up/Down" << std::endl;
-        std::cout << "1 - Red color (arterial)" << std::endl;
-        std::cout << "2 - Blue color (venous)" << std::endl;
-        std::cout << "ESC - Exit" << std::endl;
-        std::cout << "\n=== Simulator initialized! ===" << std::endl;
+        // Éclairage opératoire : couronne de petites lumières au-dessus du cœur
+        for (int i = 0; i < 64; ++i) {
+            const float angle = glm::two_pi<float>() * i / 64.0f;
+            const glm::vec3 position(2.5f * std::cos(angle), 1.5f, 2.5f * std::sin(angle));
+            m_SurgicalLights.emplace_back(position, 2.5f, glm::vec3(1.0f, 0.95f, 0.85f), 0.08f);
+        }
+
+        LOG_INFO("=== Controls ===");
+        LOG_INFO("WASD - Move camera");
+        LOG_INFO("Mouse - Look around");
+        LOG_INFO("Space/Shift - Up/Down");
+        LOG_INFO("1 - Red color (arterial)");
+        LOG_INFO("2 - Blue color (venous)");
+        LOG_INFO("Left click - Pick organ under crosshair");
+        LOG_INFO("O - Occlusion culling report");
+        LOG_INFO("K - Toggle CPU/GPU heart deformation");
+        LOG_INFO("P - Start/stop profiler capture (profile.json)");
+        LOG_INFO("ESC - Exit");
+        LOG_INFO("=== Simulator initialized! ===");
     }
 
     void ProcessInput(double deltaTime) override {
-        auto window = GetRenderer().GetWindow();
+        // État relevé par le moteur (ou relu d'un replay), jamais GLFW directement
+        const InputState& input = GetInput();
         float dt = static_cast<float>(deltaTime);
 
-        if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
+        if (input.IsKeyDown(GLFW_KEY_ESCAPE)) {
             GetRenderer().SetShouldClose(true);
         }
 
+        // Vue à la souris : déplacement du curseur depuis la frame précédente
+        if (m_FirstMouse) {
+            m_LastCursorX = input.cursorX;
+            m_LastCursorY = input.cursorY;
+            m_FirstMouse = false;
+        }
+        const float xoffset = static_cast<float>(input.cursorX - m_LastCursorX);
+        const float yoffset = static_cast<float>(m_LastCursorY - input.cursorY);
+        m_LastCursorX = input.cursorX;
+        m_LastCursorY = input.cursorY;
+        if (xoffset != 0.0f || yoffset != 0.0f) {
+            m_Camera.ProcessMouseMovement(xoffset, yoffset);
+        }
+
         // Déplacement
-        if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+        if (input.IsKeyDown(GLFW_KEY_W))
             m_Camera.ProcessKeyboard(FORWARD, dt);
-        if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+        if (input.IsKeyDown(GLFW_KEY_S))
             m_Camera.ProcessKeyboard(BACKWARD, dt);
-        if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+        if (input.IsKeyDown(GLFW_KEY_A))
             m_Camera.ProcessKeyboard(LEFT, dt);
-        if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+        if (input.IsKeyDown(GLFW_KEY_D))
             m_Camera.ProcessKeyboard(RIGHT, dt);
-        if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS)
+        if (input.IsKeyDown(GLFW_KEY_SPACE))
             m_Camera.ProcessKeyboard(UP, dt);
-        if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS)
+        if (input.IsKeyDown(GLFW_KEY_LEFT_SHIFT))
             m_Camera.ProcessKeyboard(DOWN, dt);
 
-        // Changer la couleur (simulation artère/veine)
-        if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS) {
-            m_ObjectColor = glm::vec3(0.8f, 0.1f, 0.1f); // Rouge (artère)
-            std::cout << "Mode: Arterial blood (red)" << std::endl;
+        // Changer la couleur (simulation artère/veine), une fois par changement de mode
+        if (input.IsKeyDown(GLFW_KEY_1) && m_BloodMode != 1) {
+            GetResources().GetMaterial(m_HeartMaterial)->color = glm::vec3(0.8f, 0.1f, 0.1f); // Rouge (artère)
+            m_BloodMode = 1;
+            LOG_INFO("Mode: Arterial blood (red)");
+        }
+        if (input.IsKeyDown(GLFW_KEY_2) && m_BloodMode != 2) {
+            GetResources().GetMaterial(m_HeartMaterial)->color = glm::vec3(0.1f, 0.1f, 0.8f); // Bleu (veine)
+            m_BloodMode = 2;
+            LOG_INFO("Mode: Venous blood (blue)");
         }
-        if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS) {
-            m_ObjectColor = glm::vec3(0.1f, 0.1f, 0.8f); // Bleu (veine)
-            std::cout << "Mode: Venous blood (blue)" << std::endl;
+
+        // Sélection de l'organe sous le viseur (centre de l'écran)
+        bool pickPressed = input.IsMouseButtonDown(GLFW_MOUSE_BUTTON_LEFT);
+        if (pickPressed && !m_PickPressed) {
+            RayHit hit = m_SceneIndex->Pick(GetCoordinator(), GetResources(), Ray(m_Camera.Position, m_Camera.Front), 100.0f);
+            GetEvents().Publish(PickEvent{hit.Hit(), static_cast<Entity>(hit.id), hit.distance});
+        }
+        m_PickPressed = pickPressed;
+
+        // Bilan de l'occultation de la dernière frame
+        bool reportPressed = input.IsKeyDown(GLFW_KEY_O);
+        if (reportPressed && !m_ReportPressed) {
+            const OcclusionStats& stats = m_Occlusion->GetCuller().GetStats();
+            LOG_INFO("Occlusion: " << stats.culledObjects << " / " << stats.testedObjects << " objects culled, "
+                  << stats.occluders << " occluders (" << stats.rasterizedTriangles << " / "
+                  << stats.occluderTriangles << " triangles), setup " << stats.setupMilliseconds
+                  << " ms, raster " << stats.rasterMilliseconds << " ms, tests " << stats.testMilliseconds
+                  << " ms");
         }
+        m_ReportPressed = reportPressed;
+
+        // Déformation du cœur sur le CPU (threads de travail) ou dans le vertex shader
+        bool deformPressed = input.IsKeyDown(GLFW_KEY_K);
+        if (deformPressed && !m_DeformPressed) {
+            const bool cpu = m_Deformation->GetMode() == DeformationMode::GPU;
+            m_Deformation->SetMode(cpu ? DeformationMode::CPU : DeformationMode::GPU);
+            LOG_INFO("Heart deformation: " << (cpu ? "CPU" : "GPU"));
+        }
+        m_DeformPressed = deformPressed;
+
+        // Capture du profiler : un appui démarre, le suivant écrit la trace et le bilan
+        bool profilePressed = input.IsKeyDown(GLFW_KEY_P);
+        if (profilePressed && !m_ProfilePressed) {
+            Profiler& profiler = Profiler::Get();
+            if (!profiler.IsCapturing()) {
+                profiler.BeginCapture();
+                LOG_INFO("Profiler capture started");
+            } else {
+                profiler.EndCapture();
+                profiler.WriteChromeTrace("profile.json");
+                profiler.PrintSummary();
+            }
+        }
+        m_ProfilePressed = profilePressed;
     }
 
     void Update(double deltaTime) override {
-        // Animation de battement de cœur (pulsation)
+        // Sélections de la frame précédente
+        for (const PickEvent& pick : GetEvents().Read<PickEvent>()) {
+            if (pick.hit) {
+                LOG_INFO("Picked entity " << pick.entity << " at " << pick.distance << " m");
+            } else {
+                LOG_INFO("Nothing under crosshair");
+            }
+        }
+
+        // Battement à 72 par minute : contraction pendant la systole (35 % du cycle), relâchement ensuite
         m_HeartBeatTime += static_cast<float>(deltaTime);
-        float beat = 1.0f + 0.1f * sinf(m_HeartBeatTime * 2.0f); // Pulsation à 2Hz
-        m_HeartScale = beat;
+        const float phase = std::fmod(m_HeartBeatTime * 1.2f, 1.0f);
+        const float contraction = phase < 0.35f ? std::sin(glm::pi<float>() * phase / 0.35f) : 0.0f;
+
+        // Le mesh affiché (placeholder puis cœur chargé) est préparé à sa première apparition
+        DeformableMesh* heart = GetResources().GetMeshDeformable(m_HeartMesh);
+        if (heart && heart->morphTargets.empty()) {
+            RigHeart(*heart);
+        }
+        if (heart) {
+            auto& deformable = GetCoordinator().GetComponent<Deformable>(m_Heart);
+            deformable.morphWeights.assign(1, contraction);
+            deformable.jointPose = heart->skeleton.bindLocal;
+            if (deformable.jointPose.size() == 2) {
+                deformable.jointPose[1] = glm::rotate(deformable.jointPose[1], glm::radians(12.0f * contraction),
+                                                      glm::vec3(0.0f, 1.0f, 0.0f));
+            }
+        }
 	
 	// Rotation automatique (NOUVEAU)
 	m_AutoRotationAngle += static_cast<float>(deltaTime) * 30.0f; // 30 degrés par seconde
-    }
 
-    void Render() override {
-        m_Shader->Use();
+        auto& transform = GetCoordinator().GetComponent<Transform>(m_Heart);
+        transform.rotation.y = m_AutoRotationAngle; // Rotation sur Y
 
-        // Lumière
-        glm::vec3 lightPos(3.0f, 3.0f, 3.0f);
-        glm::vec3 lightColor(1.0f, 1.0f, 1.0f);
+        // Vertices du cœur déformés sur les threads de travail (ou pose passée au vertex shader)
+        m_Deformation->Update(GetCoordinator(), GetResources(), &GetFrameJobs());
 
-        m_Shader->SetVec3("objectColor", m_ObjectColor);
-        m_Shader->SetVec3("lightPos", lightPos);
-        m_Shader->SetVec3("viewPos", m_Camera.Position);
-        m_Shader->SetVec3("lightColor", lightColor);
+        // Refit du BVH (reconstruction si la qualité s'est trop dégradée)
+        m_SceneIndex->Update(GetCoordinator(), GetResources());
+    }
 
-        // Matrices
-        glm::mat4 model = glm::mat4(1.0f);
-	model = glm::rotate(model, glm::radians(m_AutoRotationAngle), glm::vec3(0.0f, 1.0f, 0.0f)); // Rotation sur Y
-        model = glm::scale(model, glm::vec3(m_HeartScale));
+    void Render() override {
+        // Lumière et matrices communes
+        RenderContext context;
+        context.lightPos = glm::vec3(3.0f, 3.0f, 3.0f);
+        context.lightColor = glm::vec3(1.0f, 1.0f, 1.0f);
+        context.camera = &m_Camera;
 
 	// Teste avec différentes valeurs si le modèle est trop grand/petit :
-	//model = glm::scale(model, glm::vec3(m_HeartScale * 0.5f)); // Réduit de moitié
-	// ou
-	//model = glm::scale(model, glm::vec3(m_HeartScale * 2.0f)); // Double la taille
+	// modifie transform.scale dans Update (glm::vec3(0.5f), glm::vec3(2.0f)...)
         
-        glm::mat4 view = m_Camera.GetViewMatrix();
-        glm::mat4 projection = glm::perspective(
+        context.view = m_Camera.GetViewMatrix();
+        context.projection = glm::perspective(
             glm::radians(m_Camera.Zoom),
             (float)GetRenderer().GetWidth() / (float)GetRenderer().GetHeight(),
             0.1f,
             100.0f
         );
 
-        m_Shader->SetMat4("model", model);
-        m_Shader->SetMat4("view", view);
-        m_Shader->SetMat4("projection", projection);
+        // Lumières rangées par cluster sur les threads de travail, puis envoyées au GPU
+        m_SurgicalLighting.SetProjection(context.projection, 0.1f, 100.0f);
+        m_SurgicalLighting.Build(m_SurgicalLights, context.view, &GetFrameJobs());
+        m_SurgicalLighting.Upload();
+        context.lights = &m_SurgicalLighting;
+        context.viewportSize = glm::vec2(GetRenderer().GetWidth(), GetRenderer().GetHeight());
+        context.scene = &m_SceneIndex->GetBVH();
+
+        // Occulteurs rastérisés sur les threads de travail
+        m_Occlusion->Update(GetCoordinator(), GetResources(), context.projection * context.view, &GetFrameJobs());
+        context.occlusion = &m_Occlusion->GetCuller();
+        context.deformation = m_Deformation.get();
 
-        // Dessiner le modèle
-        m_HeartModel.Draw();
+        m_RenderSystem->Render(GetCoordinator(), GetResources(), context);
     }
 
     void Cleanup() override {
-        std::cout << "=== Cleaning up Medical Simulator ===" << std::endl;
+        LOG_INFO("=== Cleaning up Medical Simulator ===");
         
-        m_HeartModel.Cleanup();
-        delete m_Shader;
-        g_camera = nullptr;
+        m_SurgicalLighting.Cleanup();
+        m_Deformation->Cleanup();
         
         GameEngine::Cleanup();
     }
 
 private:
-    Shader* m_Shader = nullptr;
     FPSCamera m_Camera;
-    MeshData m_HeartModel;
+    double m_LastCursorX = 0.0;
+    double m_LastCursorY = 0.0;
+    bool m_FirstMouse = true;
+    std::shared_ptr<RenderSystem> m_RenderSystem;
+    std::shared_ptr<SceneIndexSystem> m_SceneIndex;
+    bool m_PickPressed = false;
+    std::shared_ptr<OcclusionSystem> m_Occlusion;
+    bool m_ReportPressed = false;
+    bool m_ProfilePressed = false;
+    std::shared_ptr<DeformationSystem> m_Deformation;
+    bool m_DeformPressed = false;
+    Entity m_Heart = 0;
+    uint32_t m_HeartMesh = 0;
+    uint32_t m_HeartMaterial = 0;
+    int m_BloodMode = 0; // 0 : couleur initiale, 1 : artère, 2 : veine
+    std::vector<PointLight> m_SurgicalLights;
+    LightClusterer m_SurgicalLighting;
     
-    glm::vec3 m_ObjectColor = glm::vec3(0.8f, 0.1f, 0.1f); // Rouge par défaut
     float m_HeartBeatTime = 0.0f;
-    float m_HeartScale = 1.0f;
     float m_AutoRotationAngle = 0.0f;//rajout de la variable rotation
 };
 
 // ============================================
 // Point d'entrée
 // ============================================
-int main() {
+// Usage : GameEngine [--record <fichier>] [--replay <fichier>] [--metrics <préfixe>]
+// --record enregistre l'entrée et le pas de temps de chaque frame ; --replay
+// rejoue un enregistrement sans affichage et au plus vite (charge reproductible
+// pour le profilage). --metrics écrit <préfixe>.csv / <préfixe>.json à la fin ;
+// par défaut seul un replay les écrit (metrics.csv / metrics.json).
+int main(int argc, char** argv) {
+    std::string recordPath;
+    std::string replayPath;
+    std::string metricsPrefix;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (argument == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (argument == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (argument == "--metrics" && i + 1 < argc) {
+            metricsPrefix = argv[++i];
+        }
+    }
+
     try {
         MedicalSimulator simulator;
+        if (!replayPath.empty() && !simulator.StartReplay(replayPath)) {
+            return 1;
+        }
         simulator.Init();
+        if (!recordPath.empty() && !simulator.StartRecording(recordPath)) {
+            return 1;
+        }
+        if (metricsPrefix.empty() && !replayPath.empty()) {
+            metricsPrefix = "metrics";
+        }
+        if (!metricsPrefix.empty()) {
+            simulator.SetMetricsOutput(metricsPrefix + ".csv", metricsPrefix + ".json");
+        }
         simulator.Run();
     }
     catch (const std::exception& e) {
-        std::cerr << "Error: " << e.what() << std::endl;
+        LOG_ERROR("Error: " << e.what());
         return 1;
     }
 